@@ -0,0 +1,72 @@
+# Generates the built-in skin tables from img\skins\skins.csv (one row per skin, in id order):
+#   generated\SkinRegistry.h     constexpr registry used by the code
+#   generated\SkinResources.rc2  PNG resources included by BongoCat.rc
+# Runs before each build; outputs are rewritten only when their content changes.
+param(
+	[string]$SkinsDirectory = (Join-Path $PSScriptRoot "..\img\skins"),
+	[string]$OutputDirectory = (Join-Path $PSScriptRoot "generated")
+)
+$ErrorActionPreference = "Stop"
+
+$FirstResourceId = 101
+$FirstMenuId = 2000
+$Frames = @("Rest", "Left", "Right", "Blink") # Configuration::IMAGE_* order
+
+function Write-IfChanged([string]$Path, [string]$Content) {
+	if ((Test-Path $Path) -and ([IO.File]::ReadAllText($Path) -ceq $Content)) { return }
+	[IO.File]::WriteAllText($Path, $Content, (New-Object Text.UTF8Encoding $false))
+}
+
+$skins = @(Import-Csv (Join-Path $SkinsDirectory "skins.csv"))
+if ($skins.Count -eq 0) { throw "skins.csv lists no skins" }
+
+$entries = New-Object Collections.Generic.List[string]
+$resources = New-Object Collections.Generic.List[string]
+$seen = @{}
+for ($i = 0; $i -lt $skins.Count; $i++) {
+	$skin = $skins[$i]
+	if ($skin.Folder -notmatch '^[A-Za-z0-9_-]+$') { throw "skins.csv row $($i + 1): invalid folder '$($skin.Folder)'" }
+	if ($seen.ContainsKey($skin.Folder)) { throw "skins.csv row $($i + 1): duplicate folder '$($skin.Folder)'" }
+	$seen[$skin.Folder] = $true
+	# Printable ASCII only: the name becomes a wide string literal
+	if ($skin.Name -notmatch '^[\x20-\x7E]+$' -or $skin.Name -match '["\\]') { throw "skins.csv row $($i + 1): invalid name '$($skin.Name)'" }
+	$unlock = 0
+	if (-not [int]::TryParse($skin.Unlock, [ref]$unlock) -or $unlock -lt 0) { throw "skins.csv row $($i + 1): invalid unlock '$($skin.Unlock)'" }
+	$pixelArt = if ($skin.PixelArt -eq "1") { "true" } else { "false" }
+
+	$resourceId = $FirstResourceId + $i * $Frames.Count
+	for ($f = 0; $f -lt $Frames.Count; $f++) {
+		$png = Join-Path (Join-Path $SkinsDirectory $skin.Folder) "$($Frames[$f]).png"
+		if (-not (Test-Path $png)) { throw "Missing $png" }
+		$resources.Add("$($resourceId + $f) PNG `"..\\img\\skins\\$($skin.Folder)\\$($Frames[$f]).png`"")
+	}
+	$entries.Add("`t`t{ L`"$($skin.Name)`", $unlock, $pixelArt, $resourceId, $($FirstMenuId + $i) },")
+}
+
+$header = @"
+// Generated by build\GenerateSkinRegistry.ps1 from img\skins\skins.csv. Do not edit.
+#pragma once
+
+namespace SkinRegistry {
+	struct Skin {
+		const wchar_t* name;
+		int unlockThreshold;  // clicks needed before the skin can be chosen
+		bool pixelArt;        // scales by whole factors with hard edges
+		int firstResourceId;  // PNG resources follow in Configuration::IMAGE_* order
+		int menuId;           // tray Skins item
+	};
+
+	constexpr int FIRST_RESOURCE_ID = $FirstResourceId;
+	constexpr int FIRST_MENU_ID = $FirstMenuId;
+	constexpr int COUNT = $($skins.Count);
+	constexpr Skin SKINS[COUNT] = {
+$($entries -join "`r`n")
+	};
+}
+"@
+
+$rc = "// Generated by build\GenerateSkinRegistry.ps1 from img\skins\skins.csv. Do not edit.`r`n" + ($resources -join "`r`n")
+
+New-Item -ItemType Directory -Force -Path $OutputDirectory | Out-Null
+Write-IfChanged (Join-Path $OutputDirectory "SkinRegistry.h") (($header -replace "`r?`n", "`r`n") + "`r`n")
+Write-IfChanged (Join-Path $OutputDirectory "SkinResources.rc2") ($rc + "`r`n")
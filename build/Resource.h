@@ -1,31 +1,7 @@
 // Icon resource
 #define IDI_ICON                        100
 
-// Skins resources
-#define IDB_MARSHMALLOW_REST            101
-#define IDB_MARSHMALLOW_LEFT            102
-#define IDB_MARSHMALLOW_RIGHT           103
-#define IDB_MARSHMALLOW_BLINK           104
-#define IDB_MOCHI_REST                  105
-#define IDB_MOCHI_LEFT                  106
-#define IDB_MOCHI_RIGHT                 107
-#define IDB_MOCHI_BLINK                 108
-#define IDB_TOFFEE_REST                 109
-#define IDB_TOFFEE_LEFT                 110
-#define IDB_TOFFEE_RIGHT                111
-#define IDB_TOFFEE_BLINK                112
-#define IDB_HONEY_REST                  113
-#define IDB_HONEY_LEFT                  114
-#define IDB_HONEY_RIGHT                 115
-#define IDB_HONEY_BLINK                 116
-#define IDB_LATTE_REST                  117
-#define IDB_LATTE_LEFT                  118
-#define IDB_LATTE_RIGHT                 119
-#define IDB_LATTE_BLINK                 120
-#define IDB_TREACLE_REST                121
-#define IDB_TREACLE_LEFT                122
-#define IDB_TREACLE_RIGHT               123
-#define IDB_TREACLE_BLINK               124
+// Skin resources (101 and up) are generated into generated\SkinResources.rc2
 
 // String resources
 #define IDS_TRAY_CLICKS_FORMAT          50001
@@ -39,3 +15,31 @@
 #define IDS_SKIN_LOCKED_FORMAT          50009
 #define IDS_UNKNOWN                     50010
 #define IDS_TRAY_TIP_TITLE              50011
+#define IDS_TRAY_EXPORT_HEATMAP         50012
+#define IDS_HEATMAP_EXPORTED            50013
+#define IDS_HEATMAP_EXPORT_FAILED       50014
+#define IDS_TRAY_MOUSE_STATS_FORMAT     50015
+#define IDS_TRAY_MOUSE_EXTRAS           50016
+#define IDS_TRAY_LATENCY_FORMAT         50017
+#define IDS_TRAY_SAVE_TRACE             50018
+#define IDS_TRACE_SAVE_FAILED           50019
+#define IDS_TRAY_SIZE                   50020
+#define IDS_TRAY_SIZE_AUTO              50021
+#define IDS_TRAY_TRANSITIONS            50022
+#define IDS_TRAY_ACCESSORIES            50023
+#define IDS_TRAY_COLOR                  50024
+#define IDS_TINT_ORIGINAL               50025
+#define IDS_TINT_HUE_FORMAT             50026
+#define IDS_TINT_VIVID                  50027
+#define IDS_TINT_PASTEL                 50028
+#define IDS_TINT_GRAYSCALE              50029
+#define IDS_TINT_SEPIA                  50030
+#define IDS_TINT_MIDNIGHT               50031
+#define IDS_TRAY_OUTLINE                50032
+#define IDS_OUTLINE_NONE                50033
+#define IDS_OUTLINE_LINE                50034
+#define IDS_OUTLINE_SHADOW              50035
+#define IDS_TRAY_COUNTER                50036
+#define IDS_COUNTER_OFF                 50037
+#define IDS_COUNTER_TOTAL               50038
+#define IDS_COUNTER_SESSION             50039
@@ -0,0 +1,24 @@
+// Generated by build\GenerateSkinRegistry.ps1 from img\skins\skins.csv. Do not edit.
+#pragma once
+
+namespace SkinRegistry {
+	struct Skin {
+		const wchar_t* name;
+		int unlockThreshold;  // clicks needed before the skin can be chosen
+		bool pixelArt;        // scales by whole factors with hard edges
+		int firstResourceId;  // PNG resources follow in Configuration::IMAGE_* order
+		int menuId;           // tray Skins item
+	};
+
+	constexpr int FIRST_RESOURCE_ID = 101;
+	constexpr int FIRST_MENU_ID = 2000;
+	constexpr int COUNT = 6;
+	constexpr Skin SKINS[COUNT] = {
+		{ L"Marshmallow", 0, false, 101, 2000 },
+		{ L"Mochi", 100, false, 105, 2001 },
+		{ L"Toffee", 1000, false, 109, 2002 },
+		{ L"Honey", 10000, false, 113, 2003 },
+		{ L"Latte", 100000, false, 117, 2004 },
+		{ L"Treacle", 1000000, false, 121, 2005 },
+	};
+}
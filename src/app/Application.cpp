@@ -1,8 +1,12 @@
 #include <windows.h>
 #include <gdiplus.h>
 #include "BongoCatApp.h"
+#include "ControlCommandLine.h"
+#include "PackCommandLine.h"
+#include "LaunchOptions.h"
 #include "../utils/RAII/Handle.h"
 #include "../utils/Configuration.h"
+#include "../utils/ControlClient.h"
 
 int APIENTRY wWinMain(_In_ HINSTANCE hInstance,
 	_In_opt_ HINSTANCE hPrevInstance,
@@ -12,23 +16,34 @@ int APIENTRY wWinMain(_In_ HINSTANCE hInstance,
 	UNREFERENCED_PARAMETER(lpCmdLine);
 	UNREFERENCED_PARAMETER(nCmdShow);
 
+	// `ctl` client mode talks to the running instance and never becomes one
+	int ctlExitCode = 0;
+	if (ControlCommandLine::TryRun(ctlExitCode)) {
+		return ctlExitCode;
+	}
+
+	// `pack` converts a skin folder offline
+	int packExitCode = 0;
+	if (PackCommandLine::TryRun(packExitCode)) {
+		return packExitCode;
+	}
+
+	// Per-monitor DPI: the window sizes its own frames instead of being bitmap-stretched
+	SetProcessDpiAwarenessContext(DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2);
+
 	// Single-instance via mutex
 	HandleWrapper singleInstance(CreateMutexW(nullptr, TRUE, Configuration::SINGLE_INSTANCE_MUTEX_NAME), true);
 	if (singleInstance.get() && GetLastError() == ERROR_ALREADY_EXISTS) {
-		// Activate existing instance
-		HWND hExisting = FindWindowW(Configuration::WINDOW_CLASS_NAME, nullptr);
-		if (hExisting) {
-			::PostMessageW(hExisting, Configuration::WM_APP_SHOW_APP, 0, 0);
-			::ShowWindow(hExisting, SW_SHOW);
-			::SetWindowPos(hExisting, HWND_TOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
-			::SetForegroundWindow(hExisting);
-		}
+		// Activate existing instance over the control channel
+		ControlProtocol::Request request = ControlProtocol::MakeRequest(ControlProtocol::Command::Show);
+		ControlProtocol::Response response{};
+		ControlClient::Send(&request, 1, &response, Configuration::CONTROL_CONNECT_TIMEOUT);
 		return 0;
 	}
 
 	BongoCatApp app;
 
-	if (!app.Initialize(hInstance)) {
+	if (!app.Initialize(hInstance, LaunchOptions::Parse())) {
 		return 1; // Non-zero exit code on failure
 	}
 
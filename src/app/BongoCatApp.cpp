@@ -6,8 +6,16 @@
 #include "../managers/ImageManager.h"
 #include "../managers/WindowManager.h"
 #include "../managers/InputManager.h"
+#include "../managers/ControlManager.h"
+#include "../managers/StreamManager.h"
+#include "../managers/HttpManager.h"
+#include "../managers/TerminalManager.h"
+#include "../managers/SkinPackManager.h"
+#include "../utils/SkinService.h"
 #include <windows.h>
 #include "../utils/Localization.h"
+#include "../utils/Metrics.h"
+#include "../utils/Trace.h"
 #if __has_include("Resource.h")
 #include "Resource.h"
 #elif __has_include("../../build/Resource.h")
@@ -34,13 +42,14 @@ BongoCatApp::BongoCatApp()
 	: m_hInstance(nullptr)
 	, m_hMainWindow(nullptr) {
 	m_state = std::make_unique<ApplicationState>();
+	m_statePublisher = std::make_unique<StatePublisher>();
 }
 
 BongoCatApp::~BongoCatApp() {
 	Shutdown();
 }
 
-bool BongoCatApp::Initialize(HINSTANCE hInstance) {
+bool BongoCatApp::Initialize(HINSTANCE hInstance, const LaunchOptions& options) {
 	m_hInstance = hInstance;
 
 	// Initialize GDI+
@@ -63,6 +72,31 @@ bool BongoCatApp::Initialize(HINSTANCE hInstance) {
 		return false;
 	}
 
+	// Raw video and terminal output are opt-in from the command line
+	if (options.HasStream()) {
+		m_streamManager = std::make_unique<StreamManager>(this, options);
+		if (!m_streamManager->Initialize()) {
+			m_streamManager.reset();
+		}
+	}
+	if (options.HasTerminal()) {
+		m_terminalManager = std::make_unique<TerminalManager>(this, options);
+		if (!m_terminalManager->Initialize()) {
+			m_terminalManager.reset();
+		}
+	}
+	if (options.HasHttpServer()) {
+		m_httpManager = std::make_unique<HttpManager>(this, options.httpPort);
+		if (!m_httpManager->Initialize()) {
+			m_httpManager.reset();
+		}
+	}
+
+	// Overlay snapshot is optional; the app runs fine without it
+	if (m_statePublisher->Initialize()) {
+		PublishState();
+	}
+
 	// First run: enable autostart and show a brief tray tip
 	if (m_windowManager && SettingsService::IsFirstRun()) {
 		SettingsService::SetRunAtStartup(true);
@@ -97,8 +131,12 @@ bool BongoCatApp::InitializeManagers() {
 	m_imageManager = std::make_unique<ImageManager>(m_hInstance);
 	m_windowManager = std::make_unique<WindowManager>(this);
 	m_inputManager = std::make_unique<InputManager>(this);
+	m_controlManager = std::make_unique<ControlManager>(this);
 
 	// Initialize managers
+	m_imageManager->SetTransitionsEnabled(m_state->GetTransitionsEnabled());
+	m_imageManager->SetTint(m_state->GetTint());
+	m_imageManager->SetOutline(m_state->GetOutline());
 	if (!m_imageManager->Initialize(m_state->GetCurrentSkin())) {
 		return false;
 	}
@@ -112,6 +150,15 @@ bool BongoCatApp::InitializeManagers() {
 		return false;
 	}
 
+	// Control channel needs the main window to marshal commands to
+	if (!m_controlManager->Initialize()) {
+		return false;
+	}
+
+	// Built-in skins work without packs, so a failed start is not fatal
+	m_skinPackManager = std::make_unique<SkinPackManager>(this);
+	m_skinPackManager->Initialize();
+
 	return true;
 }
 
@@ -134,6 +181,26 @@ void BongoCatApp::Shutdown() {
 	// Timers are managed by WindowManager
 
 	// Cleanup managers
+	if (m_httpManager) {
+		m_httpManager->Shutdown();
+		m_httpManager.reset();
+	}
+	if (m_streamManager) {
+		m_streamManager->Shutdown();
+		m_streamManager.reset();
+	}
+	if (m_terminalManager) {
+		m_terminalManager->Shutdown();
+		m_terminalManager.reset();
+	}
+	if (m_skinPackManager) {
+		m_skinPackManager->Shutdown();
+		m_skinPackManager.reset();
+	}
+	if (m_controlManager) {
+		m_controlManager->Shutdown();
+		m_controlManager.reset();
+	}
 	if (m_inputManager) {
 		m_inputManager->Shutdown();
 		m_inputManager.reset();
@@ -146,17 +213,30 @@ void BongoCatApp::Shutdown() {
 		m_imageManager->Cleanup();
 		m_imageManager.reset();
 	}
+	SkinPacks::Adopt(nullptr);
+
+	if (m_statePublisher) {
+		m_statePublisher->Shutdown();
+	}
 
 	// Cleanup GDI+
 	m_gdiPlusWrapper.reset();
 }
 
-void BongoCatApp::OnInputEvent() {
+void BongoCatApp::OnInputEvent(PawSide side, const InputTiming& timing) {
+	TRACE_SCOPE("OnInputEvent");
 	if (!m_hMainWindow) return;
 
+	InputLatency& latency = m_state->GetLatency();
+	const uint32_t queueStamp = InputLatency::Stamp();
+	latency.Record(LatencyStage::QueueToStateMachine, latency.ElapsedMicros(timing.hookStamp, queueStamp));
+
+	m_state->SetLastInputTick(GetTickCount64());
+
 	// If hidden, skip redraws but still count clicks
 	if (m_state && !m_state->IsVisible()) {
 		m_state->IncrementClickCount();
+		PublishState();
 		// Avoid starting timers while hidden
 		return;
 	}
@@ -166,23 +246,72 @@ void BongoCatApp::OnInputEvent() {
 	// Increment click count
 	m_state->IncrementClickCount();
 
-	HandleStateEventAndRedraw(StateEvent::InputReceived);
+	// The present stages are recorded when a present showing this input lands
+	if (m_windowManager) m_windowManager->NoteInputForPresent(timing, queueStamp);
+	HandleStateEventAndRedraw(StateEvent::InputReceived, side);
 
-	StartImageSwitchTimer(Configuration::IMAGE_SWITCH_DELAY);
+	StartImageSwitchTimer(m_state->GetAnimationPolicy().imageSwitchDelay);
 }
 
 void BongoCatApp::RedrawCurrentImage() {
 	if (!m_hMainWindow || !m_windowManager || !m_imageManager) return;
-	if (m_state && !m_state->IsVisible()) return; // Skip redraws while hidden
-	auto image = m_imageManager->GetImage(m_state->GetCurrentImageIndex());
-	if (image) {
-		m_windowManager->UpdateImage(m_hMainWindow, image);
+	if (m_state && (!m_state->IsVisible() || m_state->IsOccluded())) { // Skip redraws nobody can see
+		METRIC_INC(PresentsSkipped);
+		m_windowManager->DiscardPendingInput();
+		return;
 	}
+	// At most one present per refresh (or per frame-cap interval); bursts show only their latest state
+	if (m_windowManager->DeferPresent(m_state->GetAnimationPolicy().minPresentInterval)) return;
+	const int frame = m_windowManager->SelectFrame(m_state->GetCurrentImageIndex());
+	m_windowManager->UpdateImage(m_hMainWindow, frame);
 }
 
-void BongoCatApp::HandleStateEventAndRedraw(StateEvent event) {
-	m_state->GetStateMachine()->HandleEvent(event);
+void BongoCatApp::HandleStateEventAndRedraw(StateEvent event, PawSide side) {
+	TRACE_SCOPE("HandleStateEventAndRedraw");
+	m_state->GetStateMachine()->HandleEvent(event, side);
 	RedrawCurrentImage();
+	PublishState();
+}
+
+void BongoCatApp::PublishState() {
+	if (!m_state) return;
+	const StateSnapshot::Snapshot snapshot = StatePublisher::Capture(*m_state);
+	if (m_statePublisher) {
+		m_statePublisher->Publish(snapshot);
+	}
+	if (m_httpManager) {
+		m_httpManager->Publish(snapshot);
+	}
+	if (m_streamManager) {
+		m_streamManager->SetCurrentFrame(snapshot.catState);
+	}
+	if (m_terminalManager) {
+		m_terminalManager->SetCurrentFrame(snapshot.catState);
+	}
+}
+
+void BongoCatApp::OnImagesChanged() {
+	// Pixel-art and drawn skins may resolve the same scale to different sizes
+	if (m_windowManager) {
+		m_windowManager->ResetPlayback();
+		m_windowManager->InvalidatePresented();
+		m_windowManager->ApplyScale();
+	}
+	if (m_streamManager) {
+		m_streamManager->OnImagesChanged();
+	}
+	if (m_terminalManager) {
+		m_terminalManager->OnImagesChanged();
+	}
+}
+
+void BongoCatApp::OnSkinPacksChanged() {
+	if (!m_skinPackManager) return;
+	// Posts can outrun the UI thread; only the newest catalog matters
+	std::shared_ptr<const SkinPackCatalog> catalog = m_skinPackManager->TakeCatalog();
+	if (catalog) {
+		SkinService::AdoptSkinPacks(this, std::move(catalog));
+	}
 }
 
 void BongoCatApp::OnWindowDestroy() {
@@ -6,10 +6,17 @@
 #include "../utils/Configuration.h"
 #include "../utils/RAII/GdiPlus.h"
 #include "../states/ApplicationState.h"
+#include "../utils/StatePublisher.h"
+#include "LaunchOptions.h"
 // Uses concrete managers
 class ImageManager;
 class InputManager;
 class WindowManager;
+class ControlManager;
+class StreamManager;
+class HttpManager;
+class TerminalManager;
+class SkinPackManager;
 
 // Global window procedure
 LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam);
@@ -22,12 +29,24 @@ private:
 
 	// State
 	std::unique_ptr<ApplicationState> m_state;
+	// Shared-memory snapshot for external overlays
+	std::unique_ptr<StatePublisher> m_statePublisher;
 
 	// Managers
 	std::unique_ptr<ImageManager> m_imageManager;
 	std::unique_ptr<InputManager> m_inputManager;
 	// Window implementation
 	std::unique_ptr<WindowManager> m_windowManager;
+	// Local control channel
+	std::unique_ptr<ControlManager> m_controlManager;
+	// Optional raw video output
+	std::unique_ptr<StreamManager> m_streamManager;
+	// Optional VT text output
+	std::unique_ptr<TerminalManager> m_terminalManager;
+	// Optional localhost overlay server
+	std::unique_ptr<HttpManager> m_httpManager;
+	// Skin packs from disk
+	std::unique_ptr<SkinPackManager> m_skinPackManager;
 
 	// Window handle
 	HWND m_hMainWindow;
@@ -43,7 +62,7 @@ public:
 	~BongoCatApp();
 
 	// Main
-	bool Initialize(HINSTANCE hInstance);
+	bool Initialize(HINSTANCE hInstance, const LaunchOptions& options = LaunchOptions());
 	int Run();
 	void Shutdown();
 
@@ -59,15 +78,19 @@ public:
 	ImageManager* GetImageManager() const noexcept { return m_imageManager.get(); }
 	InputManager* GetInputManager() const noexcept { return m_inputManager.get(); }
 	WindowManager* GetWindowManager() const noexcept { return m_windowManager.get(); }
+	ControlManager* GetControlManager() const noexcept { return m_controlManager.get(); }
 
 	// Events
-	void OnInputEvent();
+	void OnInputEvent(PawSide side = PawSide::Any, const InputTiming& timing = InputTiming());
+	void OnImagesChanged();
+	void OnSkinPacksChanged();
 
 	void OnWindowDestroy();
 
 	// Utility
 	void RedrawCurrentImage();
-	void HandleStateEventAndRedraw(StateEvent event);
+	void HandleStateEventAndRedraw(StateEvent event, PawSide side = PawSide::Any);
+	void PublishState();
 
 	// Timer controls
 	void EnsureBlinkTimerRunning();
@@ -0,0 +1,27 @@
+#include "ConsoleOutput.h"
+#include <windows.h>
+
+void ConsoleOutput::Attach() {
+	AttachConsole(ATTACH_PARENT_PROCESS);
+}
+
+void ConsoleOutput::Write(const std::wstring& text) {
+	HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+	if (!output || output == INVALID_HANDLE_VALUE) {
+		// Attached console without inherited std handles
+		static HANDLE console = CreateFileW(L"CONOUT$", GENERIC_WRITE, FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr);
+		output = console;
+	}
+	if (!output || output == INVALID_HANDLE_VALUE) return;
+	DWORD mode = 0;
+	DWORD written = 0;
+	if (GetConsoleMode(output, &mode)) {
+		WriteConsoleW(output, text.c_str(), static_cast<DWORD>(text.size()), &written, nullptr);
+		return;
+	}
+	int size = WideCharToMultiByte(CP_UTF8, 0, text.c_str(), static_cast<int>(text.size()), nullptr, 0, nullptr, nullptr);
+	if (size <= 0) return;
+	std::string utf8(static_cast<size_t>(size), '\0');
+	WideCharToMultiByte(CP_UTF8, 0, text.c_str(), static_cast<int>(text.size()), &utf8[0], size, nullptr, nullptr);
+	WriteFile(output, utf8.data(), static_cast<DWORD>(utf8.size()), &written, nullptr);
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include <string>
+
+// Text output for the command-line modes of a GUI-subsystem process
+namespace ConsoleOutput {
+	// Borrows the parent's console, if any; call once before Write
+	void Attach();
+	// Writes to the console, or UTF-8 to a redirected handle
+	void Write(const std::wstring& text);
+}
@@ -0,0 +1,194 @@
+#include "ControlCommandLine.h"
+#include "ConsoleOutput.h"
+#include <windows.h>
+#include <shellapi.h>
+#include <cwchar>
+#include <string>
+#include <vector>
+#include "../utils/ControlClient.h"
+#include "../utils/ControlProtocol.h"
+#include "../utils/Configuration.h"
+#include "../utils/Metrics.h"
+#include "../utils/Trace.h"
+
+namespace {
+	constexpr int EXIT_OK = 0;
+	constexpr int EXIT_USAGE = 1;
+	constexpr int EXIT_NOT_RUNNING = 2;
+	constexpr int EXIT_COMMAND_FAILED = 3;
+
+	void WriteUsage() {
+		ConsoleOutput::Write(L"usage: BongoCat.exe ctl <command> [<command> ...]\n"
+			L"commands:\n"
+			L"  show           show the cat\n"
+			L"  hide           hide the cat\n"
+			L"  skin <id>      switch to an unlocked skin\n"
+			L"  accessories <id>[,<id>...] | none\n"
+			L"                 wear exactly these accessories\n"
+			L"  reset          reset the window position\n"
+			L"  stats          print counters\n"
+			L"  latency        print input-to-present latency percentiles\n"
+#if BONGOCAT_TRACING
+			L"  trace          save a performance trace to Documents\n"
+#endif
+#if BONGOCAT_METRICS
+			L"  metrics        print internal metrics (Prometheus text format)\n"
+#endif
+			);
+	}
+
+	// "none" or comma-separated accessory ids, as a bitmask
+	bool ParseAccessories(const wchar_t* text, int32_t& accessories) {
+		accessories = 0;
+		if (_wcsicmp(text, L"none") == 0) return true;
+		while (*text) {
+			wchar_t* end = nullptr;
+			const long id = wcstol(text, &end, 10);
+			if (end == text || id < 0 || id >= Configuration::ACCESSORY_MAX) return false;
+			accessories |= static_cast<int32_t>(1u << id);
+			if (*end == L',') ++end;
+			else if (*end != L'\0') return false;
+			text = end;
+		}
+		return true;
+	}
+
+	bool ParseCommands(int argc, LPWSTR* argv, std::vector<ControlProtocol::Request>& requests) {
+		using ControlProtocol::Command;
+		for (int i = 2; i < argc; ++i) {
+			const wchar_t* name = argv[i];
+			if (_wcsicmp(name, L"show") == 0) {
+				requests.push_back(ControlProtocol::MakeRequest(Command::Show));
+			}
+			else if (_wcsicmp(name, L"hide") == 0) {
+				requests.push_back(ControlProtocol::MakeRequest(Command::Hide));
+			}
+			else if (_wcsicmp(name, L"reset") == 0) {
+				requests.push_back(ControlProtocol::MakeRequest(Command::ResetPosition));
+			}
+			else if (_wcsicmp(name, L"stats") == 0) {
+				requests.push_back(ControlProtocol::MakeRequest(Command::QueryStats));
+			}
+			else if (_wcsicmp(name, L"latency") == 0) {
+				requests.push_back(ControlProtocol::MakeRequest(Command::QueryLatency));
+			}
+#if BONGOCAT_TRACING
+			else if (_wcsicmp(name, L"trace") == 0) {
+				requests.push_back(ControlProtocol::MakeRequest(Command::SaveTrace));
+			}
+#endif
+#if BONGOCAT_METRICS
+			else if (_wcsicmp(name, L"metrics") == 0) {
+				requests.push_back(ControlProtocol::MakeRequest(Command::QueryMetrics));
+			}
+#endif
+			else if (_wcsicmp(name, L"skin") == 0 && i + 1 < argc) {
+				wchar_t* end = nullptr;
+				long skinId = wcstol(argv[++i], &end, 10);
+				if (!end || *end != L'\0') return false;
+				requests.push_back(ControlProtocol::MakeRequest(Command::SetSkin, static_cast<int32_t>(skinId)));
+			}
+			else if (_wcsicmp(name, L"accessories") == 0 && i + 1 < argc) {
+				int32_t accessories = 0;
+				if (!ParseAccessories(argv[++i], accessories)) return false;
+				requests.push_back(ControlProtocol::MakeRequest(Command::SetAccessories, accessories));
+			}
+			else {
+				return false;
+			}
+		}
+		return !requests.empty();
+	}
+
+	const wchar_t* StatusText(uint8_t status) {
+		switch (static_cast<ControlProtocol::Status>(status)) {
+		case ControlProtocol::Status::Ok: return L"ok";
+		case ControlProtocol::Status::UnknownCommand: return L"unknown command";
+		case ControlProtocol::Status::InvalidArgument: return L"invalid argument";
+		case ControlProtocol::Status::UnsupportedVersion: return L"unsupported version";
+		default: return L"unavailable";
+		}
+	}
+
+	void WriteResponse(const ControlProtocol::Response& response) {
+		wchar_t line[256] = { 0 };
+		if (response.status != static_cast<uint8_t>(ControlProtocol::Status::Ok)) {
+			swprintf_s(line, L"error: %s\n", StatusText(response.status));
+			ConsoleOutput::Write(line);
+			return;
+		}
+		if (response.command == static_cast<uint8_t>(ControlProtocol::Command::QueryStats)) {
+			swprintf_s(line, L"clicks=%llu skin=%llu visible=%llu mouse_px=%llu wheel_notches=%llu key_presses=%llu accessories=0x%llx\n",
+				static_cast<unsigned long long>(response.values[ControlProtocol::STATS_CLICKS]),
+				static_cast<unsigned long long>(response.values[ControlProtocol::STATS_SKIN]),
+				static_cast<unsigned long long>(response.values[ControlProtocol::STATS_VISIBLE]),
+				static_cast<unsigned long long>(response.values[ControlProtocol::STATS_MOUSE_DISTANCE_PX]),
+				static_cast<unsigned long long>(response.values[ControlProtocol::STATS_WHEEL_NOTCHES]),
+				static_cast<unsigned long long>(response.values[ControlProtocol::STATS_KEY_PRESSES]),
+				static_cast<unsigned long long>(response.values[ControlProtocol::STATS_ACCESSORIES]));
+			ConsoleOutput::Write(line);
+		}
+		if (response.command == static_cast<uint8_t>(ControlProtocol::Command::QueryLatency)) {
+			static const wchar_t* const STAGE_NAMES[ControlProtocol::LATENCY_STAGE_COUNT] = {
+				L"hook_to_queue", L"queue_to_state_machine", L"state_machine_to_present", L"input_to_present"
+			};
+			for (size_t stage = 0; stage < ControlProtocol::LATENCY_STAGE_COUNT; ++stage) {
+				swprintf_s(line, L"%s p50_us=%llu p99_us=%llu p999_us=%llu\n", STAGE_NAMES[stage],
+					static_cast<unsigned long long>(response.values[stage * 3 + ControlProtocol::LATENCY_P50]),
+					static_cast<unsigned long long>(response.values[stage * 3 + ControlProtocol::LATENCY_P99]),
+					static_cast<unsigned long long>(response.values[stage * 3 + ControlProtocol::LATENCY_P999]));
+				ConsoleOutput::Write(line);
+			}
+		}
+#if BONGOCAT_METRICS
+		if (response.command == static_cast<uint8_t>(ControlProtocol::Command::QueryMetrics)) {
+			Metrics::Values values = {};
+			for (size_t i = 0; i < Metrics::COUNTER_COUNT; ++i) {
+				values.counters[i] = response.values[i];
+			}
+			for (size_t i = 0; i < Metrics::GAUGE_COUNT; ++i) {
+				values.gauges[i] = static_cast<int64_t>(response.values[Metrics::COUNTER_COUNT + i]);
+			}
+			const std::string text = Metrics::FormatText(values);
+			ConsoleOutput::Write(std::wstring(text.begin(), text.end())); // ASCII
+		}
+#endif
+	}
+}
+
+bool ControlCommandLine::TryRun(int& exitCode) {
+	int argc = 0;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+	if (!argv) return false;
+	if (argc < 2 || _wcsicmp(argv[1], L"ctl") != 0) {
+		LocalFree(argv);
+		return false;
+	}
+
+	ConsoleOutput::Attach();
+
+	std::vector<ControlProtocol::Request> requests;
+	const bool parsed = ParseCommands(argc, argv, requests);
+	LocalFree(argv);
+	if (!parsed) {
+		WriteUsage();
+		exitCode = EXIT_USAGE;
+		return true;
+	}
+
+	std::vector<ControlProtocol::Response> responses(requests.size());
+	if (!ControlClient::Send(requests.data(), requests.size(), responses.data(), Configuration::CONTROL_CONNECT_TIMEOUT)) {
+		ConsoleOutput::Write(L"error: Bongo Cat is not running\n");
+		exitCode = EXIT_NOT_RUNNING;
+		return true;
+	}
+
+	exitCode = EXIT_OK;
+	for (const ControlProtocol::Response& response : responses) {
+		WriteResponse(response);
+		if (response.status != static_cast<uint8_t>(ControlProtocol::Status::Ok)) {
+			exitCode = EXIT_COMMAND_FAILED;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+// `BongoCat.exe ctl <command>...` client for the local control channel
+namespace ControlCommandLine {
+	// Returns false when the process was not started as `ctl`; otherwise runs it and sets exitCode
+	bool TryRun(int& exitCode);
+}
@@ -0,0 +1,60 @@
+#include "LaunchOptions.h"
+#include <windows.h>
+#include <shellapi.h>
+#include <cwchar>
+#include "../utils/Configuration.h"
+
+LaunchOptions LaunchOptions::Parse() {
+	LaunchOptions options;
+	int argc = 0;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+	if (!argv) return options;
+
+	for (int i = 1; i + 1 < argc; ++i) {
+		const wchar_t* name = argv[i];
+		const wchar_t* value = argv[i + 1];
+		if (_wcsicmp(name, L"--stream") == 0) {
+			options.streamTarget = value;
+			++i;
+		}
+		else if (_wcsicmp(name, L"--stream-format") == 0) {
+			options.streamFormat = (_wcsicmp(value, L"bgra") == 0) ? StreamFormat::Bgra : StreamFormat::Y4m;
+			++i;
+		}
+		else if (_wcsicmp(name, L"--stream-fps") == 0) {
+			wchar_t* end = nullptr;
+			long fps = wcstol(value, &end, 10);
+			if (end && *end == L'\0' && fps > 0 && fps <= Configuration::STREAM_MAX_FPS) {
+				options.streamFps = static_cast<int>(fps);
+			}
+			++i;
+		}
+		else if (_wcsicmp(name, L"--tty") == 0) {
+			options.terminalTarget = value;
+			++i;
+		}
+		else if (_wcsicmp(name, L"--tty-width") == 0) {
+			wchar_t* end = nullptr;
+			long columns = wcstol(value, &end, 10);
+			if (end && *end == L'\0' && columns >= Configuration::TERMINAL_MIN_COLUMNS && columns <= Configuration::TERMINAL_MAX_COLUMNS) {
+				options.terminalColumns = static_cast<int>(columns);
+			}
+			++i;
+		}
+		else if (_wcsicmp(name, L"--http") == 0) {
+			wchar_t* end = nullptr;
+			long port = wcstol(value, &end, 10);
+			if (end && *end == L'\0' && port > 0 && port <= 65535) {
+				options.httpPort = static_cast<int>(port);
+			}
+			++i;
+		}
+	}
+
+	LocalFree(argv);
+	// Raw video and VT text would interleave on one stdout; the stream keeps it
+	if (options.streamTarget == L"-" && options.terminalTarget == L"-") {
+		options.terminalTarget.clear();
+	}
+	return options;
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <string>
+
+// Raw video formats for --stream
+enum class StreamFormat {
+	Y4m,  // YUV4MPEG2, I420 full range
+	Bgra  // headerless premultiplied BGRA
+};
+
+// Flags for the regular (non-ctl) launch
+struct LaunchOptions {
+	std::wstring streamTarget; // "-" for stdout, \\.\pipe\name to serve a pipe, else a file path
+	StreamFormat streamFormat = StreamFormat::Y4m;
+	int streamFps = 0;         // 0 selects the default
+	int httpPort = 0;          // overlay server on 127.0.0.1; 0 disables it
+	std::wstring terminalTarget; // "-" for the console (or stdout), \\.\pipe\name to serve a pipe, else a file path
+	int terminalColumns = 0;     // 0 selects the default
+
+	bool HasStream() const noexcept { return !streamTarget.empty(); }
+	bool HasHttpServer() const noexcept { return httpPort != 0; }
+	bool HasTerminal() const noexcept { return !terminalTarget.empty(); }
+
+	// Parses the process command line; unknown flags are ignored
+	static LaunchOptions Parse();
+};
@@ -0,0 +1,110 @@
+#include "PackCommandLine.h"
+#include "ConsoleOutput.h"
+#include <windows.h>
+#include <shellapi.h>
+#include <shlwapi.h>
+#include <wincodec.h>
+#include <string>
+#include <vector>
+#include "../utils/Configuration.h"
+#include "../utils/FileIO.h"
+#include "../utils/SkinContainer.h"
+#include "../utils/SkinPackLoader.h"
+#include "../utils/RAII/Com.h"
+
+namespace {
+	constexpr int EXIT_OK = 0;
+	constexpr int EXIT_USAGE = 1;
+	constexpr int EXIT_FAILED = 2;
+
+	void WriteUsage() {
+		ConsoleOutput::Write(L"usage: BongoCat.exe pack <folder> [<output>] [--raw]\n"
+			L"  <folder>  skin folder with rest.png, left.png, right.png, blink.png and optional skin.ini\n"
+			L"  <output>  defaults to <folder>.bcskin\n"
+			L"  --raw     store frames uncompressed instead of LZ4\n");
+	}
+
+	int Pack(const std::wstring& folderArgument, std::wstring output, SkinContainer::Encoding encoding) {
+		wchar_t fullPath[MAX_PATH] = { 0 };
+		if (!GetFullPathNameW(folderArgument.c_str(), MAX_PATH, fullPath, nullptr)) return EXIT_USAGE;
+		PathRemoveBackslashW(fullPath);
+		const std::wstring folder = fullPath;
+		if (output.empty()) output = folder + Configuration::SKIN_PACK_CONTAINER_EXTENSION;
+
+		ComInitWrapper com(COINIT_MULTITHREADED);
+		IWICImagingFactory* rawFactory = nullptr;
+		if (!com.isValid() || FAILED(CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&rawFactory)))) {
+			ConsoleOutput::Write(L"error: image decoder unavailable\n");
+			return EXIT_FAILED;
+		}
+		ComWrapper<IWICImagingFactory> factory(rawFactory, true);
+
+		SkinPack pack;
+		pack.folder = PathFindFileNameW(folder.c_str());
+		SkinPackLoader::ReadManifest(folder, pack);
+
+		const uint8_t* frames[Configuration::NUMBER_IMAGES] = {};
+		for (int i = 0; i < Configuration::NUMBER_IMAGES; ++i) {
+			const std::wstring path = folder + L"\\" + Configuration::SKIN_PACK_FRAME_FILES[i];
+			pack.frames[i] = SkinPackLoader::DecodePng(factory.get(), path, pack.pixelArt);
+			frames[i] = pack.frames[i] ? SkinPackLoader::GetPixels(*pack.frames[i]) : nullptr;
+			if (!frames[i]) {
+				ConsoleOutput::Write(L"error: cannot decode " + path + L"\n");
+				return EXIT_FAILED;
+			}
+		}
+
+		SkinContainer::Metadata metadata;
+		metadata.name.assign(pack.name.begin(), pack.name.end());
+		metadata.unlockThreshold = static_cast<uint32_t>(pack.unlockThreshold);
+		metadata.pixelArt = pack.pixelArt;
+		const std::vector<uint8_t> bytes = SkinContainer::Build(metadata, Configuration::IMAGE_WIDTH, Configuration::IMAGE_HEIGHT,
+			frames, Configuration::NUMBER_IMAGES, encoding);
+		if (bytes.empty() || !FileIO::WriteAtomic(output, bytes)) {
+			ConsoleOutput::Write(L"error: cannot write " + output + L"\n");
+			return EXIT_FAILED;
+		}
+
+		wchar_t line[64] = { 0 };
+		swprintf_s(line, L" (%zu bytes)\n", bytes.size());
+		ConsoleOutput::Write(L"wrote " + output + line);
+		return EXIT_OK;
+	}
+}
+
+bool PackCommandLine::TryRun(int& exitCode) {
+	int argc = 0;
+	LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+	if (!argv) return false;
+	if (argc < 2 || _wcsicmp(argv[1], L"pack") != 0) {
+		LocalFree(argv);
+		return false;
+	}
+
+	ConsoleOutput::Attach();
+
+	std::vector<std::wstring> paths;
+	SkinContainer::Encoding encoding = SkinContainer::Encoding::Lz4;
+	bool parsed = true;
+	for (int i = 2; i < argc; ++i) {
+		if (_wcsicmp(argv[i], L"--raw") == 0) {
+			encoding = SkinContainer::Encoding::Raw;
+		}
+		else if (paths.size() < 2) {
+			paths.emplace_back(argv[i]);
+		}
+		else {
+			parsed = false;
+		}
+	}
+	LocalFree(argv);
+	if (!parsed || paths.empty()) {
+		WriteUsage();
+		exitCode = EXIT_USAGE;
+		return true;
+	}
+
+	exitCode = Pack(paths[0], paths.size() > 1 ? paths[1] : std::wstring(), encoding);
+	if (exitCode == EXIT_USAGE) WriteUsage();
+	return true;
+}
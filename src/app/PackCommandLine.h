@@ -0,0 +1,7 @@
+#pragma once
+
+// `BongoCat.exe pack <folder> [<output>] [--raw]`: converts a PNG skin folder to a .bcskin file
+namespace PackCommandLine {
+	// Returns false when the process was not started as `pack`; otherwise runs it and sets exitCode
+	bool TryRun(int& exitCode);
+}
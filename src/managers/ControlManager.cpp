@@ -0,0 +1,180 @@
+#include "ControlManager.h"
+#include "../app/BongoCatApp.h"
+#include "../utils/Configuration.h"
+#include <sddl.h>
+#include <cstring>
+
+ControlManager::ControlManager(BongoCatApp* app)
+	: m_app(app)
+	, m_targetWindow(nullptr) {
+}
+
+ControlManager::~ControlManager() {
+	Shutdown();
+}
+
+bool ControlManager::Initialize() {
+	if (!m_app || !m_app->GetMainWindow()) return false;
+	m_targetWindow = m_app->GetMainWindow();
+	m_pipeName = ControlProtocol::GetPipeName();
+
+	m_stopEvent = HandleWrapper(CreateEventW(nullptr, TRUE, FALSE, nullptr), true);
+	if (!m_stopEvent.isValid()) return false;
+
+	// Fails if another process already holds the name, so clients never reach an impostor
+	HANDLE pipe = CreatePipe(m_pipeName);
+	if (pipe == INVALID_HANDLE_VALUE) return false;
+	m_pipe = HandleWrapper(pipe, true);
+
+	m_worker = std::thread(&ControlManager::ServerLoop, this);
+	return true;
+}
+
+void ControlManager::Shutdown() {
+	if (!m_worker.joinable()) {
+		m_pipe = HandleWrapper();
+		return;
+	}
+	SetEvent(m_stopEvent.get());
+
+	// The worker may be inside SendMessage to this thread; keep servicing sent
+	// messages while waiting so shutdown cannot deadlock on it
+	HANDLE worker = m_worker.native_handle();
+	while (MsgWaitForMultipleObjects(1, &worker, FALSE, INFINITE, QS_SENDMESSAGE) == WAIT_OBJECT_0 + 1) {
+		MSG msg;
+		PeekMessageW(&msg, nullptr, 0, 0, PM_NOREMOVE | PM_QS_SENDMESSAGE);
+	}
+	m_worker.join();
+	m_pipe = HandleWrapper();
+	m_stopEvent = HandleWrapper();
+}
+
+HANDLE ControlManager::CreatePipe(const std::wstring& name) {
+	// Only this user (and SYSTEM) may connect or add instances
+	HANDLE rawToken = nullptr;
+	if (!OpenProcessToken(GetCurrentProcess(), TOKEN_QUERY, &rawToken)) return INVALID_HANDLE_VALUE;
+	HandleWrapper token(rawToken, true);
+	DWORD size = 0;
+	GetTokenInformation(token.get(), TokenUser, nullptr, 0, &size);
+	std::vector<BYTE> user(size);
+	LPWSTR rawSid = nullptr;
+	if (size == 0 || !GetTokenInformation(token.get(), TokenUser, user.data(), size, &size) ||
+		!ConvertSidToStringSidW(reinterpret_cast<TOKEN_USER*>(user.data())->User.Sid, &rawSid)) {
+		return INVALID_HANDLE_VALUE;
+	}
+	LocalMemoryWrapper sid(rawSid, true);
+	const std::wstring sddl = std::wstring(L"D:P(A;;GA;;;SY)(A;;GA;;;") + rawSid + L")";
+	PSECURITY_DESCRIPTOR rawDescriptor = nullptr;
+	if (!ConvertStringSecurityDescriptorToSecurityDescriptorW(sddl.c_str(), SDDL_REVISION_1, &rawDescriptor, nullptr)) {
+		return INVALID_HANDLE_VALUE;
+	}
+	LocalMemoryWrapper descriptor(rawDescriptor, true);
+	SECURITY_ATTRIBUTES attributes = { sizeof(attributes), rawDescriptor, FALSE };
+
+	return CreateNamedPipeW(name.c_str(), PIPE_ACCESS_DUPLEX | FILE_FLAG_OVERLAPPED | FILE_FLAG_FIRST_PIPE_INSTANCE,
+		PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+		1, Configuration::CONTROL_PIPE_BUFFER_SIZE, Configuration::CONTROL_PIPE_BUFFER_SIZE, 0, &attributes);
+}
+
+void ControlManager::ServerLoop() {
+	HandleWrapper ioEvent(CreateEventW(nullptr, TRUE, FALSE, nullptr), true);
+	if (!ioEvent.isValid()) return;
+
+	// One instance for the whole run: disconnecting keeps the name ours between clients
+	while (WaitForSingleObject(m_stopEvent.get(), 0) == WAIT_TIMEOUT) {
+		OVERLAPPED overlapped = {};
+		overlapped.hEvent = ioEvent.get();
+		if (WaitForClient(m_pipe.get(), overlapped)) {
+			ServeClient(m_pipe.get(), overlapped);
+		}
+		else if (WaitForSingleObject(m_stopEvent.get(), 0) != WAIT_TIMEOUT) {
+			return;
+		}
+		// Also clears a client that closed before its connect completed
+		DisconnectNamedPipe(m_pipe.get());
+	}
+}
+
+bool ControlManager::WaitForIo(HANDLE pipe, OVERLAPPED& overlapped, DWORD& transferred, DWORD timeout) {
+	HANDLE waits[2] = { overlapped.hEvent, m_stopEvent.get() };
+	if (WaitForMultipleObjects(2, waits, FALSE, timeout) != WAIT_OBJECT_0) {
+		CancelIoEx(pipe, &overlapped);
+		GetOverlappedResult(pipe, &overlapped, &transferred, TRUE);
+		return false;
+	}
+	return GetOverlappedResult(pipe, &overlapped, &transferred, FALSE) != FALSE;
+}
+
+bool ControlManager::WaitForClient(HANDLE pipe, OVERLAPPED& overlapped) {
+	ResetEvent(overlapped.hEvent);
+	if (ConnectNamedPipe(pipe, &overlapped)) return true;
+	switch (GetLastError()) {
+	case ERROR_PIPE_CONNECTED:
+		return true;
+	case ERROR_IO_PENDING: {
+		DWORD unused = 0;
+		return WaitForIo(pipe, overlapped, unused);
+	}
+	default:
+		return false;
+	}
+}
+
+void ControlManager::ServeClient(HANDLE pipe, OVERLAPPED& overlapped) {
+	using ControlProtocol::Request;
+	using ControlProtocol::Response;
+
+	std::vector<BYTE> pending;
+	std::vector<ControlCall> calls;
+	std::vector<BYTE> replies;
+	BYTE buffer[Configuration::CONTROL_PIPE_BUFFER_SIZE];
+
+	for (;;) {
+		DWORD received = 0;
+		ResetEvent(overlapped.hEvent);
+		if (!ReadFile(pipe, buffer, sizeof(buffer), nullptr, &overlapped)) {
+			if (GetLastError() != ERROR_IO_PENDING) return; // client went away
+		}
+		// A stalled client would hold the only instance; every other caller waits behind it
+		if (!WaitForIo(pipe, overlapped, received, Configuration::CONTROL_CLIENT_IDLE_TIMEOUT) || received == 0) return;
+
+		// Requests may be split or coalesced by the pipe; decode every complete record
+		pending.insert(pending.end(), buffer, buffer + received);
+		const size_t complete = pending.size() / sizeof(Request);
+		if (complete == 0) continue;
+
+		calls.resize(complete);
+		for (size_t i = 0; i < complete; ++i) {
+			memcpy(&calls[i].request, pending.data() + i * sizeof(Request), sizeof(Request));
+		}
+		pending.erase(pending.begin(), pending.begin() + complete * sizeof(Request));
+
+		DispatchBatch(calls);
+
+		replies.resize(complete * sizeof(Response));
+		for (size_t i = 0; i < complete; ++i) {
+			memcpy(replies.data() + i * sizeof(Response), &calls[i].response, sizeof(Response));
+		}
+
+		DWORD written = 0;
+		ResetEvent(overlapped.hEvent);
+		if (!WriteFile(pipe, replies.data(), static_cast<DWORD>(replies.size()), nullptr, &overlapped)) {
+			if (GetLastError() != ERROR_IO_PENDING) return;
+		}
+		if (!WaitForIo(pipe, overlapped, written, Configuration::CONTROL_CLIENT_IDLE_TIMEOUT) || written != replies.size()) return;
+	}
+}
+
+void ControlManager::DispatchBatch(std::vector<ControlCall>& calls) {
+	for (ControlCall& call : calls) {
+		call.response = {};
+		call.response.version = ControlProtocol::VERSION;
+		call.response.command = call.request.command;
+		call.response.status = static_cast<uint8_t>(ControlProtocol::Status::Unavailable);
+	}
+
+	// One synchronous hop to the UI thread per batch; the UI thread owns all app state.
+	// Plain SendMessage: a timed-out send may still be delivered later, after `calls` is gone.
+	SendMessageW(m_targetWindow, Configuration::WM_APP_CONTROL,
+		static_cast<WPARAM>(calls.size()), reinterpret_cast<LPARAM>(calls.data()));
+}
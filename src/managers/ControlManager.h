@@ -0,0 +1,38 @@
+#pragma once
+#include <windows.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../utils/RAII/Handle.h"
+#include "../utils/ControlProtocol.h"
+
+class BongoCatApp;
+
+// Local control channel: a named pipe served on a worker thread.
+// Requests are batched and marshalled to the UI thread in one hop per read.
+class ControlManager {
+private:
+	BongoCatApp* m_app;
+	HWND m_targetWindow;
+	std::wstring m_pipeName;
+	HandleWrapper m_pipe; // the only instance, reused for every client
+	HandleWrapper m_stopEvent;
+	std::thread m_worker;
+
+	static HANDLE CreatePipe(const std::wstring& name);
+
+	// Worker thread
+	void ServerLoop();
+	bool WaitForClient(HANDLE pipe, OVERLAPPED& overlapped);
+	void ServeClient(HANDLE pipe, OVERLAPPED& overlapped);
+	bool WaitForIo(HANDLE pipe, OVERLAPPED& overlapped, DWORD& transferred, DWORD timeout = INFINITE);
+	void DispatchBatch(std::vector<ControlCall>& calls);
+
+public:
+	ControlManager(BongoCatApp* app);
+	~ControlManager();
+
+	// Initialization and cleanup
+	bool Initialize();
+	void Shutdown();
+};
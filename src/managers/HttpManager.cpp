@@ -0,0 +1,589 @@
+// winsock2 must precede windows.h
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <mswsock.h>
+#include "HttpManager.h"
+#include "ImageManager.h"
+#include "../app/BongoCatApp.h"
+#include "../utils/Configuration.h"
+#include "../utils/Metrics.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+	constexpr ULONG_PTR KEY_IO = 0;
+	constexpr ULONG_PTR KEY_STATE = 1;
+	constexpr ULONG_PTR KEY_STOP = 2;
+	constexpr DWORD ACCEPT_ADDRESS_SIZE = sizeof(sockaddr_in) + 16;
+
+	enum class IoKind : uint8_t { Accept, Receive, Send };
+
+	struct IoContext {
+		OVERLAPPED overlapped;
+		IoKind kind;
+		HttpConnection* connection;
+	};
+}
+
+struct HttpConnection {
+	SOCKET socket = INVALID_SOCKET;
+	IoContext receiveIo = {};
+	IoContext sendIo = {};
+	char acceptBuffer[2 * ACCEPT_ADDRESS_SIZE] = {};
+	std::string request;
+	// Queued bytes plus an optional static body (resource memory, never copied)
+	std::string outbox;
+	const BYTE* outboxBody = nullptr;
+	DWORD outboxBodySize = 0;
+	std::string inflight;
+	DWORD inflightSize = 0;
+	int pendingOps = 0; // posted I/O, plus one while a handler runs; freed at zero once closing
+	bool sending = false;
+	bool subscriber = false;
+	bool closing = false;
+	bool closeAfterSend = false;
+};
+
+namespace {
+	// Browser-source page: frames are immutable per URL, so after one cycle the browser serves them from cache
+	const char OVERLAY_PAGE[] =
+		"<!DOCTYPE html><html><head><meta charset=\"utf-8\"><title>Bongo Cat</title>"
+		"<style>html,body{margin:0;background:transparent}img{display:block;image-rendering:pixelated}</style>"
+		"</head><body><img id=\"cat\" src=\"/frame.png\" alt=\"\"><script>"
+		"const cat=document.getElementById('cat');"
+		"new EventSource('/events').onmessage=e=>{const s=JSON.parse(e.data);cat.src='/skins/'+s.skin+'/'+s.frame+'.png';};"
+		"</script></body></html>";
+
+	uint32_t Fnv1a(const BYTE* data, size_t size) {
+		uint32_t hash = 2166136261u;
+		for (size_t i = 0; i < size; ++i) {
+			hash = (hash ^ data[i]) * 16777619u;
+		}
+		return hash;
+	}
+
+	// Case-insensitive header lookup; empty when absent
+	std::string HeaderValue(const std::string& head, const char* name) {
+		const size_t nameLength = strlen(name);
+		size_t lineStart = head.find("\r\n");
+		while (lineStart != std::string::npos) {
+			lineStart += 2;
+			const size_t lineEnd = head.find("\r\n", lineStart);
+			const size_t length = (lineEnd == std::string::npos ? head.size() : lineEnd) - lineStart;
+			if (length > nameLength && head[lineStart + nameLength] == ':' && _strnicmp(head.c_str() + lineStart, name, nameLength) == 0) {
+				size_t valueStart = lineStart + nameLength + 1;
+				size_t valueEnd = lineStart + length;
+				while (valueStart < valueEnd && head[valueStart] == ' ') ++valueStart;
+				while (valueEnd > valueStart && head[valueEnd - 1] == ' ') --valueEnd;
+				return head.substr(valueStart, valueEnd - valueStart);
+			}
+			lineStart = lineEnd;
+		}
+		return std::string();
+	}
+
+	void QueueText(HttpConnection& connection, const char* status, const char* contentType, const std::string& body, bool close) {
+		char header[256] = { 0 };
+		snprintf(header, sizeof(header), "HTTP/1.1 %s\r\nContent-Type: %s\r\nContent-Length: %zu\r\nCache-Control: no-store\r\n%s\r\n",
+			status, contentType, body.size(), close ? "Connection: close\r\n" : "");
+		connection.outbox.append(header).append(body);
+		connection.closeAfterSend = connection.closeAfterSend || close;
+	}
+
+	void QueueNotModified(HttpConnection& connection, const std::string& etag) {
+		connection.outbox.append("HTTP/1.1 304 Not Modified\r\nETag: ").append(etag).append("\r\n\r\n");
+	}
+}
+
+HttpManager::HttpManager(BongoCatApp* app, int port)
+	: m_app(app)
+	, m_port(port)
+	, m_winsockStarted(false)
+	, m_listenSocket(INVALID_SOCKET)
+	, m_acceptEx(nullptr)
+	, m_state()
+	, m_postedSkin(-1)
+	, m_postedFrame(-1)
+	, m_broadcastSkin(-1)
+	, m_broadcastFrame(-1) {
+}
+
+HttpManager::~HttpManager() {
+	Shutdown();
+}
+
+bool HttpManager::Initialize() {
+	if (!m_app || m_port <= 0 || m_port > 65535) return false;
+
+	WSADATA data = {};
+	if (WSAStartup(MAKEWORD(2, 2), &data) != 0) return false;
+	m_winsockStarted = true;
+
+	m_completionPort = HandleWrapper(CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1), true);
+	if (!m_completionPort.isValid() || !BuildFrameCache() || !OpenListener()) {
+		Shutdown();
+		return false;
+	}
+	m_hostSuffix = ":" + std::to_string(m_port);
+
+	for (int i = 0; i < Configuration::HTTP_PENDING_ACCEPTS; ++i) {
+		PostAccept();
+	}
+	m_worker = std::thread(&HttpManager::ServerLoop, this);
+	return true;
+}
+
+void HttpManager::Shutdown() {
+	if (m_worker.joinable()) {
+		PostQueuedCompletionStatus(m_completionPort.get(), 0, KEY_STOP, nullptr);
+		m_worker.join();
+	}
+	else if (m_listenSocket != INVALID_SOCKET) {
+		// Failed start: cancel any accepts posted so far
+		closesocket(static_cast<SOCKET>(m_listenSocket));
+		m_listenSocket = INVALID_SOCKET;
+		Drain();
+	}
+	m_completionPort = HandleWrapper();
+	m_frames.clear();
+	if (m_winsockStarted) {
+		WSACleanup();
+		m_winsockStarted = false;
+	}
+}
+
+void HttpManager::Publish(const StateSnapshot::Snapshot& value) {
+	StateSnapshot::Write(m_state, value);
+	if (value.skin == m_postedSkin && value.catState == m_postedFrame) return;
+	m_postedSkin = value.skin;
+	m_postedFrame = value.catState;
+	if (m_completionPort.isValid()) {
+		PostQueuedCompletionStatus(m_completionPort.get(), 0, KEY_STATE, nullptr);
+	}
+}
+
+bool HttpManager::BuildFrameCache() {
+	ImageManager* images = m_app->GetImageManager();
+	if (!images) return false;
+
+	// The embedded PNGs are the encoded frames; hash them once for ETags
+	m_frames.assign(static_cast<size_t>(Configuration::SKIN_COUNT) * Configuration::NUMBER_IMAGES, CachedFrame());
+	for (int skin = 0; skin < Configuration::SKIN_COUNT; ++skin) {
+		for (int frame = 0; frame < Configuration::NUMBER_IMAGES; ++frame) {
+			CachedFrame& entry = m_frames[static_cast<size_t>(skin) * Configuration::NUMBER_IMAGES + frame];
+			if (!images->GetEncodedImage(skin, frame, entry.data, entry.size)) continue;
+
+			char etag[32] = { 0 };
+			snprintf(etag, sizeof(etag), "\"%d-%d-%08x\"", skin, frame, Fnv1a(entry.data, entry.size));
+			entry.etag = etag;
+
+			char header[256] = { 0 };
+			snprintf(header, sizeof(header), "HTTP/1.1 200 OK\r\nContent-Type: image/png\r\nContent-Length: %lu\r\nETag: %s\r\n"
+				"Cache-Control: public, max-age=31536000, immutable\r\n\r\n", static_cast<unsigned long>(entry.size), etag);
+			entry.immutableHeader = header;
+			snprintf(header, sizeof(header), "HTTP/1.1 200 OK\r\nContent-Type: image/png\r\nContent-Length: %lu\r\nETag: %s\r\n"
+				"Cache-Control: no-cache\r\n\r\n", static_cast<unsigned long>(entry.size), etag);
+			entry.currentHeader = header;
+		}
+	}
+	return true;
+}
+
+bool HttpManager::OpenListener() {
+	SOCKET listener = WSASocketW(AF_INET, SOCK_STREAM, IPPROTO_TCP, nullptr, 0, WSA_FLAG_OVERLAPPED);
+	if (listener == INVALID_SOCKET) return false;
+	m_listenSocket = listener;
+
+	BOOL exclusive = TRUE;
+	setsockopt(listener, SOL_SOCKET, SO_EXCLUSIVEADDRUSE, reinterpret_cast<const char*>(&exclusive), sizeof(exclusive));
+
+	// Loopback only; the server is never reachable from the network
+	sockaddr_in address = {};
+	address.sin_family = AF_INET;
+	address.sin_port = htons(static_cast<u_short>(m_port));
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	if (bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == SOCKET_ERROR) return false;
+	if (listen(listener, SOMAXCONN) == SOCKET_ERROR) return false;
+	if (!CreateIoCompletionPort(reinterpret_cast<HANDLE>(listener), m_completionPort.get(), KEY_IO, 0)) return false;
+
+	GUID acceptExId = WSAID_ACCEPTEX;
+	LPFN_ACCEPTEX acceptEx = nullptr;
+	DWORD bytes = 0;
+	if (WSAIoctl(listener, SIO_GET_EXTENSION_FUNCTION_POINTER, &acceptExId, sizeof(acceptExId),
+		&acceptEx, sizeof(acceptEx), &bytes, nullptr, nullptr) == SOCKET_ERROR || !acceptEx) {
+		return false;
+	}
+	m_acceptEx = reinterpret_cast<void*>(acceptEx);
+	return true;
+}
+
+void HttpManager::ServerLoop() {
+	for (;;) {
+		DWORD transferred = 0;
+		ULONG_PTR key = 0;
+		OVERLAPPED* overlapped = nullptr;
+		const BOOL succeeded = GetQueuedCompletionStatus(m_completionPort.get(), &transferred, &key, &overlapped, INFINITE);
+		if (!overlapped) {
+			if (!succeeded) return;
+			if (key == KEY_STOP) {
+				closesocket(static_cast<SOCKET>(m_listenSocket));
+				m_listenSocket = INVALID_SOCKET;
+				Drain();
+				return;
+			}
+			if (key == KEY_STATE) Broadcast();
+			continue;
+		}
+
+		// The completed operation's reference is dropped only after its handler returns,
+		// so a Close anywhere inside the handler cannot free the connection under it
+		IoContext* io = CONTAINING_RECORD(overlapped, IoContext, overlapped);
+		HttpConnection* connection = io->connection;
+		switch (io->kind) {
+		case IoKind::Accept:
+			OnAccept(connection, succeeded != FALSE);
+			break;
+		case IoKind::Receive:
+			OnReceive(connection, succeeded != FALSE);
+			break;
+		case IoKind::Send:
+			OnSend(connection, succeeded != FALSE, transferred);
+			break;
+		}
+		connection->pendingOps--;
+		ReleaseIfIdle(connection);
+	}
+}
+
+bool HttpManager::PostAccept() {
+	SOCKET socket = WSASocketW(AF_INET, SOCK_STREAM, IPPROTO_TCP, nullptr, 0, WSA_FLAG_OVERLAPPED);
+	if (socket == INVALID_SOCKET) return false;
+
+	HttpConnection* connection = new HttpConnection();
+	connection->socket = socket;
+	connection->receiveIo.kind = IoKind::Accept;
+	connection->receiveIo.connection = connection;
+	connection->sendIo.kind = IoKind::Send;
+	connection->sendIo.connection = connection;
+	m_connections.insert(connection);
+
+	LPFN_ACCEPTEX acceptEx = reinterpret_cast<LPFN_ACCEPTEX>(m_acceptEx);
+	DWORD received = 0;
+	connection->pendingOps++;
+	if (!acceptEx(static_cast<SOCKET>(m_listenSocket), socket, connection->acceptBuffer, 0,
+		ACCEPT_ADDRESS_SIZE, ACCEPT_ADDRESS_SIZE, &received, &connection->receiveIo.overlapped)
+		&& WSAGetLastError() != ERROR_IO_PENDING) {
+		connection->pendingOps--;
+		Close(connection);
+		return false;
+	}
+	return true;
+}
+
+void HttpManager::OnAccept(HttpConnection* connection, bool succeeded) {
+	if (connection->closing) return;
+
+	// Keep the accept backlog full whatever happens to this connection
+	PostAccept();
+
+	SOCKET listener = static_cast<SOCKET>(m_listenSocket);
+	u_long nonBlocking = 1;
+	if (!succeeded || m_connections.size() > Configuration::HTTP_MAX_CONNECTIONS
+		|| setsockopt(connection->socket, SOL_SOCKET, SO_UPDATE_ACCEPT_CONTEXT, reinterpret_cast<const char*>(&listener), sizeof(listener)) == SOCKET_ERROR
+		|| ioctlsocket(connection->socket, FIONBIO, &nonBlocking) == SOCKET_ERROR
+		|| !CreateIoCompletionPort(reinterpret_cast<HANDLE>(connection->socket), m_completionPort.get(), KEY_IO, 0)) {
+		Close(connection);
+		return;
+	}
+
+	connection->receiveIo.kind = IoKind::Receive;
+	PostReceive(connection);
+}
+
+bool HttpManager::PostReceive(HttpConnection* connection) {
+	// Zero-byte receive: no buffer is pinned while the connection idles
+	WSABUF buffer = { 0, nullptr };
+	DWORD flags = 0;
+	ZeroMemory(&connection->receiveIo.overlapped, sizeof(OVERLAPPED));
+	connection->pendingOps++;
+	if (WSARecv(connection->socket, &buffer, 1, nullptr, &flags, &connection->receiveIo.overlapped, nullptr) == SOCKET_ERROR
+		&& WSAGetLastError() != WSA_IO_PENDING) {
+		connection->pendingOps--;
+		Close(connection);
+		return false;
+	}
+	return true;
+}
+
+void HttpManager::OnReceive(HttpConnection* connection, bool succeeded) {
+	if (connection->closing) return;
+	if (!succeeded) {
+		Close(connection);
+		return;
+	}
+
+	// Data is ready; drain it without blocking
+	char buffer[Configuration::HTTP_RECEIVE_CHUNK];
+	for (;;) {
+		const int received = recv(connection->socket, buffer, sizeof(buffer), 0);
+		if (received > 0) {
+			if (!connection->subscriber) {
+				connection->request.append(buffer, static_cast<size_t>(received));
+				if (connection->request.size() > Configuration::HTTP_MAX_REQUEST_SIZE) {
+					Close(connection);
+					return;
+				}
+			}
+			continue;
+		}
+		if (received == 0 || WSAGetLastError() != WSAEWOULDBLOCK) {
+			Close(connection);
+			return;
+		}
+		break;
+	}
+
+	ProcessRequests(connection);
+	if (!connection->closing) {
+		PostReceive(connection);
+	}
+}
+
+void HttpManager::Flush(HttpConnection* connection) {
+	if (connection->closing || connection->sending) return;
+	if (connection->outbox.empty() && !connection->outboxBody) {
+		if (connection->closeAfterSend) Close(connection);
+		return;
+	}
+
+	connection->inflight.swap(connection->outbox);
+	connection->outbox.clear();
+
+	WSABUF buffers[2] = {};
+	DWORD bufferCount = 1;
+	buffers[0].buf = &connection->inflight[0];
+	buffers[0].len = static_cast<ULONG>(connection->inflight.size());
+	connection->inflightSize = buffers[0].len;
+	if (connection->outboxBody) {
+		buffers[1].buf = reinterpret_cast<CHAR*>(const_cast<BYTE*>(connection->outboxBody));
+		buffers[1].len = connection->outboxBodySize;
+		connection->inflightSize += buffers[1].len;
+		bufferCount = 2;
+		connection->outboxBody = nullptr;
+		connection->outboxBodySize = 0;
+	}
+
+	ZeroMemory(&connection->sendIo.overlapped, sizeof(OVERLAPPED));
+	connection->sending = true;
+	connection->pendingOps++;
+	if (WSASend(connection->socket, buffers, bufferCount, nullptr, 0, &connection->sendIo.overlapped, nullptr) == SOCKET_ERROR
+		&& WSAGetLastError() != WSA_IO_PENDING) {
+		connection->pendingOps--;
+		connection->sending = false;
+		Close(connection);
+	}
+}
+
+void HttpManager::OnSend(HttpConnection* connection, bool succeeded, DWORD transferred) {
+	connection->sending = false;
+	if (connection->closing) return;
+	if (!succeeded || transferred != connection->inflightSize) {
+		Close(connection);
+		return;
+	}
+
+	connection->inflight.clear();
+	Flush(connection);
+	if (!connection->closing && !connection->sending) {
+		ProcessRequests(connection);
+	}
+}
+
+void HttpManager::ProcessRequests(HttpConnection* connection) {
+	// One response in flight per connection; pipelined requests wait their turn
+	while (!connection->closing && !connection->sending && !connection->subscriber) {
+		const size_t end = connection->request.find("\r\n\r\n");
+		if (end == std::string::npos) return;
+		const std::string head = connection->request.substr(0, end);
+		connection->request.erase(0, end + 4);
+		HandleRequest(connection, head);
+	}
+}
+
+void HttpManager::HandleRequest(HttpConnection* connection, const std::string& head) {
+	const size_t lineEnd = head.find("\r\n");
+	const std::string line = head.substr(0, lineEnd);
+	const size_t methodEnd = line.find(' ');
+	const size_t targetEnd = methodEnd == std::string::npos ? std::string::npos : line.find(' ', methodEnd + 1);
+	if (targetEnd == std::string::npos) {
+		QueueText(*connection, "400 Bad Request", "text/plain", "Bad Request", true);
+		Flush(connection);
+		return;
+	}
+	const std::string method = line.substr(0, methodEnd);
+	std::string path = line.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+	path = path.substr(0, path.find('?'));
+
+	// Reject foreign Host names so a web page cannot reach the server through DNS rebinding
+	const std::string host = HeaderValue(head, "Host");
+	if (host != "127.0.0.1" + m_hostSuffix && host != "localhost" + m_hostSuffix) {
+		QueueText(*connection, "403 Forbidden", "text/plain", "Forbidden", true);
+		Flush(connection);
+		return;
+	}
+	if (method != "GET") {
+		QueueText(*connection, "405 Method Not Allowed", "text/plain", "Method Not Allowed", true);
+		Flush(connection);
+		return;
+	}
+
+	const StateSnapshot::Snapshot state = ReadState();
+	int skin = 0;
+	int frame = 0;
+	int consumed = 0;
+	const CachedFrame* cached = nullptr;
+	bool immutable = false;
+	if (path == "/frame.png") {
+		cached = FindFrame(state.skin, state.catState);
+	}
+	else if (sscanf_s(path.c_str(), "/skins/%d/%d.png%n", &skin, &frame, &consumed) == 2 && consumed == static_cast<int>(path.size())) {
+		cached = FindFrame(skin, frame);
+		immutable = true;
+	}
+	else if (path == "/") {
+		QueueText(*connection, "200 OK", "text/html; charset=utf-8", OVERLAY_PAGE, false);
+		Flush(connection);
+		return;
+	}
+	else if (path == "/stats") {
+		QueueText(*connection, "200 OK", "application/json", FormatStats(state), false);
+		Flush(connection);
+		return;
+	}
+#if BONGOCAT_METRICS
+	else if (path == "/metrics") {
+		QueueText(*connection, "200 OK", "text/plain; version=0.0.4", Metrics::FormatText(Metrics::Collect()), false);
+		Flush(connection);
+		return;
+	}
+#endif
+	else if (path == "/events") {
+		connection->outbox.append("HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-store\r\n\r\nretry: 1000\n\n");
+		connection->outbox.append(FormatEvent(state));
+		connection->subscriber = true;
+		connection->request.clear();
+		Flush(connection);
+		return;
+	}
+	else {
+		QueueText(*connection, "404 Not Found", "text/plain", "Not Found", false);
+		Flush(connection);
+		return;
+	}
+
+	if (!cached) {
+		QueueText(*connection, "404 Not Found", "text/plain", "Not Found", false);
+	}
+	else if (HeaderValue(head, "If-None-Match").find(cached->etag) != std::string::npos) {
+		QueueNotModified(*connection, cached->etag);
+	}
+	else {
+		connection->outbox.append(immutable ? cached->immutableHeader : cached->currentHeader);
+		connection->outboxBody = cached->data;
+		connection->outboxBodySize = cached->size;
+	}
+	Flush(connection);
+}
+
+void HttpManager::Broadcast() {
+	const StateSnapshot::Snapshot state = ReadState();
+	if (state.skin == m_broadcastSkin && state.catState == m_broadcastFrame) return;
+	m_broadcastSkin = state.skin;
+	m_broadcastFrame = state.catState;
+
+	// Collect first: Flush and Close may change the set
+	const std::string event = FormatEvent(state);
+	std::vector<HttpConnection*> subscribers;
+	for (HttpConnection* connection : m_connections) {
+		if (connection->subscriber && !connection->closing) subscribers.push_back(connection);
+	}
+	for (HttpConnection* connection : subscribers) {
+		// Held like a completion handler holds its connection; freed below if Flush closed it
+		connection->pendingOps++;
+		// A reader this far behind is stalled; drop it rather than buffer without bound
+		if (connection->outbox.size() > Configuration::HTTP_MAX_QUEUED_EVENT_BYTES) {
+			Close(connection);
+		}
+		else {
+			connection->outbox.append(event);
+			Flush(connection);
+		}
+		connection->pendingOps--;
+		ReleaseIfIdle(connection);
+	}
+}
+
+void HttpManager::Close(HttpConnection* connection) {
+	if (connection->closing) return;
+	connection->closing = true;
+	connection->subscriber = false;
+	// Pending operations complete with an error and release the connection
+	closesocket(connection->socket);
+	connection->socket = INVALID_SOCKET;
+	ReleaseIfIdle(connection);
+}
+
+void HttpManager::ReleaseIfIdle(HttpConnection* connection) {
+	if (!connection->closing || connection->pendingOps > 0) return;
+	m_connections.erase(connection);
+	delete connection;
+}
+
+void HttpManager::Drain() {
+	const std::vector<HttpConnection*> open(m_connections.begin(), m_connections.end());
+	for (HttpConnection* connection : open) {
+		Close(connection);
+	}
+
+	// Connections can only be freed once the kernel is done with their OVERLAPPEDs
+	while (!m_connections.empty()) {
+		DWORD transferred = 0;
+		ULONG_PTR key = 0;
+		OVERLAPPED* overlapped = nullptr;
+		GetQueuedCompletionStatus(m_completionPort.get(), &transferred, &key, &overlapped, Configuration::HTTP_DRAIN_TIMEOUT);
+		if (!overlapped) {
+			if (GetLastError() == WAIT_TIMEOUT) return; // leak rather than free memory still owned by I/O
+			continue;
+		}
+		IoContext* io = CONTAINING_RECORD(overlapped, IoContext, overlapped);
+		io->connection->pendingOps--;
+		ReleaseIfIdle(io->connection);
+	}
+}
+
+const HttpManager::CachedFrame* HttpManager::FindFrame(int skin, int frame) const {
+	if (skin < 0 || skin >= Configuration::SKIN_COUNT || frame < 0 || frame >= Configuration::NUMBER_IMAGES) return nullptr;
+	const CachedFrame& entry = m_frames[static_cast<size_t>(skin) * Configuration::NUMBER_IMAGES + frame];
+	return entry.data ? &entry : nullptr;
+}
+
+StateSnapshot::Snapshot HttpManager::ReadState() const {
+	StateSnapshot::Snapshot value{};
+	StateSnapshot::TryRead(m_state, value);
+	return value;
+}
+
+std::string HttpManager::FormatEvent(const StateSnapshot::Snapshot& value) const {
+	char event[96] = { 0 };
+	snprintf(event, sizeof(event), "data: {\"skin\":%d,\"frame\":%d}\n\n", value.skin, value.catState);
+	return event;
+}
+
+std::string HttpManager::FormatStats(const StateSnapshot::Snapshot& value) const {
+	const ULONGLONG now = GetTickCount64();
+	const unsigned long long idleMs = (value.lastInputTick != 0 && now >= value.lastInputTick) ? now - value.lastInputTick : 0;
+	char json[256] = { 0 };
+	snprintf(json, sizeof(json), "{\"skin\":%d,\"frame\":%d,\"clicks\":%llu,\"keysPerMinute\":%u,\"idleMs\":%llu}",
+		value.skin, value.catState, static_cast<unsigned long long>(value.clickCount), value.keysPerMinute, idleMs);
+	return json;
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <windows.h>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "../utils/RAII/Handle.h"
+#include "../utils/StateSnapshot.h"
+
+class BongoCatApp;
+struct HttpConnection; // winsock-dependent; defined in the .cpp
+
+// Optional localhost HTTP server for browser-source overlays.
+// A single IOCP worker serves the embedded skin PNGs with precomputed headers and
+// pushes frame changes over Server-Sent Events. Idle connections cost one zero-byte receive.
+class HttpManager {
+private:
+	// Response for one skin frame, built once at startup
+	struct CachedFrame {
+		const BYTE* data = nullptr;
+		DWORD size = 0;
+		std::string etag;
+		std::string immutableHeader; // /skins/<skin>/<frame>.png
+		std::string currentHeader;   // /frame.png, revalidated by ETag
+	};
+
+	BongoCatApp* m_app;
+	int m_port;
+	std::string m_hostSuffix;  // ":<port>" for the Host check
+	bool m_winsockStarted;
+	UINT_PTR m_listenSocket;  // SOCKET
+	void* m_acceptEx;         // LPFN_ACCEPTEX
+	HandleWrapper m_completionPort;
+	std::vector<CachedFrame> m_frames; // skin-major, NUMBER_IMAGES per skin
+	std::thread m_worker;
+
+	// Latest state: written by the UI thread, read by the worker
+	StateSnapshot::SharedBlock m_state;
+	int32_t m_postedSkin;
+	int32_t m_postedFrame;
+
+	// Worker-owned
+	std::unordered_set<HttpConnection*> m_connections;
+	int32_t m_broadcastSkin;
+	int32_t m_broadcastFrame;
+
+	// Setup
+	bool BuildFrameCache();
+	bool OpenListener();
+
+	// Worker thread
+	void ServerLoop();
+	bool PostAccept();
+	void OnAccept(HttpConnection* connection, bool succeeded);
+	void OnReceive(HttpConnection* connection, bool succeeded);
+	void OnSend(HttpConnection* connection, bool succeeded, DWORD transferred);
+	bool PostReceive(HttpConnection* connection);
+	void Flush(HttpConnection* connection);
+	void ProcessRequests(HttpConnection* connection);
+	void HandleRequest(HttpConnection* connection, const std::string& head);
+	void Broadcast();
+	void Close(HttpConnection* connection);
+	void ReleaseIfIdle(HttpConnection* connection);
+	void Drain();
+
+	// Responses
+	std::string FormatEvent(const StateSnapshot::Snapshot& value) const;
+	std::string FormatStats(const StateSnapshot::Snapshot& value) const;
+	const CachedFrame* FindFrame(int skin, int frame) const;
+	StateSnapshot::Snapshot ReadState() const;
+
+public:
+	HttpManager(BongoCatApp* app, int port);
+	~HttpManager();
+
+	// Initialization and cleanup
+	bool Initialize();
+	void Shutdown();
+
+	// UI thread: stores the state and wakes subscribers when the frame changed
+	void Publish(const StateSnapshot::Snapshot& value);
+};
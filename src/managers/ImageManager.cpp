@@ -3,11 +3,24 @@
 #include <gdiplus.h>
 #include <cstring>
 #include "../utils/Configuration.h"
+#include "../utils/Resampler.h"
+#include "../utils/FrameBlend.h"
+#include "../utils/FrameOutline.h"
+#include "../utils/FrameCache.h"
+#include "../utils/SkinPresentation.h"
 #include "../utils/RAII/Gdi.h"
 #include "../utils/RAII/GdiPlus.h"
+#include "../utils/Metrics.h"
+#include "../utils/Trace.h"
 
 ImageManager::ImageManager(HINSTANCE hInstance)
-	: m_hInstance(hInstance) {
+	: m_hInstance(hInstance)
+	, m_skinId(Configuration::SKIN_DEFAULT)
+	, m_baseHash(0)
+	, m_sourceHash(0)
+	, m_tint()
+	, m_outline(FrameOutline::STYLE_NONE)
+	, m_transitionsEnabled(false) {
 }
 
 ImageManager::~ImageManager() {
@@ -18,9 +31,20 @@ bool ImageManager::Initialize(int skinId) {
 }
 
 void ImageManager::Cleanup() {
+	ReleaseNativeSurfaces();
 	m_images.clear();
+	m_baseImages.clear();
+	m_packFrames.clear();
+	m_baseHash = 0;
+	m_sourceHash = 0;
+	m_transitionFrames.clear();
+	m_timeline.Clear();
+	m_scaled.clear();
 	// Optionally release capacity eagerly to minimize peak memory during skin swaps
 	m_images.shrink_to_fit();
+	m_baseImages.shrink_to_fit();
+	m_scaled.shrink_to_fit();
+	METRIC_SET(FrameBytes, 0);
 }
 
 HBITMAP ImageManager::LoadPNGFromResources(int resourceID) {
@@ -74,23 +98,9 @@ HBITMAP ImageManager::LoadPNGFromResources(int resourceID) {
 	}
 
 	// Create top-down 32bpp DIB and copy pixels
-	ScreenDCWrapper screenDC;
-	if (!screenDC.isValid()) {
-		destBitmap->UnlockBits(&data);
-		return nullptr;
-	}
-
-	BITMAPINFO bmi = {};
-	bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-	bmi.bmiHeader.biWidth = rect.Width;
-	bmi.bmiHeader.biHeight = -rect.Height; // top-down DIB
-	bmi.bmiHeader.biPlanes = Configuration::PLANES_COUNT;
-	bmi.bmiHeader.biBitCount = Configuration::BITS_PER_PIXEL; // 32 bpp
-	bmi.bmiHeader.biCompression = BI_RGB;
-
 	void* dibPixels = nullptr;
-	HBITMAP hDib = CreateDIBSection(screenDC.get(), &bmi, DIB_RGB_COLORS, &dibPixels, nullptr, 0);
-	if (!hDib || !dibPixels) {
+	HBITMAP hDib = CreateFrameBitmap(rect.Width, rect.Height, &dibPixels);
+	if (!hDib) {
 		destBitmap->UnlockBits(&data);
 		return nullptr;
 	}
@@ -124,7 +134,29 @@ HBITMAP ImageManager::LoadPNGFromResources(int resourceID) {
 	return hDib;
 }
 
+HBITMAP ImageManager::CreateFrameBitmap(int width, int height, void** bits) {
+	*bits = nullptr;
+	ScreenDCWrapper screenDC;
+	if (!screenDC.isValid()) return nullptr;
+
+	BITMAPINFO bmi = {};
+	bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+	bmi.bmiHeader.biWidth = width;
+	bmi.bmiHeader.biHeight = -height; // top-down DIB
+	bmi.bmiHeader.biPlanes = Configuration::PLANES_COUNT;
+	bmi.bmiHeader.biBitCount = Configuration::BITS_PER_PIXEL; // 32 bpp
+	bmi.bmiHeader.biCompression = BI_RGB;
+
+	HBITMAP hDib = CreateDIBSection(screenDC.get(), &bmi, DIB_RGB_COLORS, bits, nullptr, 0);
+	if (hDib && !*bits) {
+		DeleteObject(hDib);
+		return nullptr;
+	}
+	return hDib;
+}
+
 bool ImageManager::LoadImages(int skinId) {
+	TRACE_SCOPE("LoadImages");
 	// Validate skin ID using utility
 	if (!ValidationUtils::IsValidSkin(skinId)) {
 		return false;
@@ -132,25 +164,458 @@ bool ImageManager::LoadImages(int skinId) {
 
 	// Cleanup existing images first
 	Cleanup();
+	m_skinId = skinId;
+
+	// Pack frames were decoded off the UI thread; nothing to do here but reference them
+	if (const SkinPack* pack = SkinPacks::Find(skinId)) {
+		if (!LoadPackImages(*pack)) {
+			Cleanup();
+			return false;
+		}
+		BakeFrames();
+		if (m_transitionsEnabled) {
+			BuildTransitions();
+		}
+		UpdateFrameBytes();
+		return true;
+	}
+
+#if BONGOCAT_METRICS
+	LARGE_INTEGER frequency = {};
+	LARGE_INTEGER start = {};
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&start);
+#endif
+
+	// Warm starts copy the decoded frames out of the disk cache instead of decoding the PNGs
+	const SIZE nativeSize = { Configuration::IMAGE_WIDTH, Configuration::IMAGE_HEIGHT };
+	m_baseHash = HashEmbeddedImages(skinId);
+	const uint64_t cacheKey = FrameCache::MakeKey(m_baseHash, nativeSize.cx, nativeSize.cy,
+		Configuration::NUMBER_IMAGES, FrameCache::DecodedSkin);
+	if (!m_baseHash || !LoadCachedFrames(cacheKey, nativeSize, Configuration::NUMBER_IMAGES, m_baseImages)) {
+		for (int i = 0; i < Configuration::NUMBER_IMAGES; i++) {
+			HBITMAP hbmp = LoadPNGFromResources(Configuration::GetSkinResourceId(skinId, i));
+			if (!hbmp) {
+				// Cleanup any partially loaded images
+				Cleanup();
+				return false;
+			}
+			// Store RAII wrapper by value
+			m_baseImages.emplace_back(hbmp, true);
+		}
+		if (m_baseHash) StoreCachedFrames(cacheKey, nativeSize, m_baseImages);
+	}
+
+#if BONGOCAT_METRICS
+	LARGE_INTEGER end = {};
+	QueryPerformanceCounter(&end);
+	METRIC_ADD(DecodeMicroseconds, (end.QuadPart - start.QuadPart) * 1000000 / frequency.QuadPart);
+#endif
+	BakeFrames();
+	if (m_transitionsEnabled) {
+		BuildTransitions();
+	}
+	UpdateFrameBytes();
+	return true;
+}
+
+bool ImageManager::LoadPackImages(const SkinPack& pack) {
+	for (const std::shared_ptr<const SkinPackFrame>& frame : pack.frames) {
+		if (!frame || !frame->bitmap.isValid()) return false;
+		m_baseImages.emplace_back(frame->bitmap.get(), false);
+		m_packFrames.push_back(frame);
+	}
+	return true;
+}
+
+bool ImageManager::SetAccessories(std::vector<std::shared_ptr<const SkinPackFrame>> layers) {
+	if (layers == m_accessories) return false;
+	m_accessories = std::move(layers);
+	RebuildFrames();
+	return true;
+}
+
+bool ImageManager::SetTint(const ColorTransform::Tint& tint) {
+	if (tint == m_tint || !ColorTransform::IsValid(tint)) return false;
+	m_tint = tint;
+	RebuildFrames();
+	return true;
+}
+
+bool ImageManager::SetOutline(int outline) {
+	if (outline == m_outline || !FrameOutline::IsValid(outline)) return false;
+	m_outline = outline;
+	RebuildFrames();
+	return true;
+}
+
+void ImageManager::RebuildFrames() {
+	if (m_baseImages.empty()) return;
+	// Everything presented derives from the baked frames, so it is rebuilt once here
+	ReleaseNativeSurfaces();
+	m_scaled.clear();
+	m_transitionFrames.clear();
+	m_timeline.Clear();
+	BakeFrames();
+	if (m_transitionsEnabled) {
+		BuildTransitions();
+	}
+	UpdateFrameBytes();
+}
 
-	int baseID = Configuration::SKIN_BASE_RESOURCE_ID + (skinId * Configuration::RESOURCES_PER_SKIN);
+bool ImageManager::BakeFrames() {
+	TRACE_SCOPE("BakeFrames");
+	ReleaseNativeSurfaces();
+	m_images.clear();
+	m_sourceHash = m_baseHash;
+	if (!HasFrameEffects()) {
+		// Nothing to recolor, wear or outline: present the decoded frames themselves
+		for (const BitmapWrapper& frame : m_baseImages) {
+			m_images.emplace_back(frame.get(), false);
+		}
+		return true;
+	}
 
-	for (int i = 0; i < Configuration::NUMBER_IMAGES; i++) {
-		HBITMAP hbmp = LoadPNGFromResources(baseID + i);
+	// Recolored, composited and outlined once per skin, tint, accessory set and outline; presents still blit a single surface per frame
+	GdiFlush();
+	const size_t pixelCount = static_cast<size_t>(Configuration::IMAGE_WIDTH) * Configuration::IMAGE_HEIGHT;
+	const bool tinted = !m_tint.IsIdentity();
+	const ColorTransform::Matrix matrix = ColorTransform::Build(m_tint);
+	if (tinted && m_sourceHash) m_sourceHash = FrameCache::Hash(&matrix, sizeof(matrix), m_sourceHash);
+	std::vector<const BYTE*> layers;
+	for (const std::shared_ptr<const SkinPackFrame>& accessory : m_accessories) {
+		const BYTE* layer = accessory ? GetBitmapPixels(accessory->bitmap.get()) : nullptr;
+		if (layer) layers.push_back(layer);
+		// Scaled sets of this combination get their own disk cache entries
+		if (layer && m_sourceHash) m_sourceHash = FrameCache::Hash(layer, pixelCount * Configuration::BYTES_PER_PIXEL, m_sourceHash);
+	}
+	if (m_outline != FrameOutline::STYLE_NONE && m_sourceHash) m_sourceHash = FrameCache::Hash(&m_outline, sizeof(m_outline), m_sourceHash);
+	for (const BitmapWrapper& frame : m_baseImages) {
+		const BYTE* base = GetBitmapPixels(frame.get());
+		void* bits = nullptr;
+		HBITMAP hbmp = base ? CreateFrameBitmap(Configuration::IMAGE_WIDTH, Configuration::IMAGE_HEIGHT, &bits) : nullptr;
 		if (!hbmp) {
-			// Cleanup any partially loaded images
-			Cleanup();
+			// Out of GDI memory: show the plain skin rather than nothing
+			m_images.clear();
+			m_sourceHash = m_baseHash;
+			for (const BitmapWrapper& plain : m_baseImages) {
+				m_images.emplace_back(plain.get(), false);
+			}
 			return false;
 		}
-		// Store RAII wrapper by value
+		if (tinted) {
+			ColorTransform::Apply(matrix, base, static_cast<uint8_t*>(bits), pixelCount);
+		}
+		else {
+			memcpy(bits, base, pixelCount * Configuration::BYTES_PER_PIXEL);
+		}
+		for (const BYTE* layer : layers) {
+			FrameBlend::Over(layer, static_cast<uint8_t*>(bits), pixelCount);
+		}
+		// Outlines follow the worn accessories too
+		FrameOutline::Apply(m_outline, static_cast<uint8_t*>(bits), Configuration::IMAGE_WIDTH, Configuration::IMAGE_HEIGHT);
 		m_images.emplace_back(hbmp, true);
 	}
 	return true;
 }
 
+uint64_t ImageManager::HashEmbeddedImages(int skinId) const {
+	uint64_t hash = FrameCache::Hash(nullptr, 0);
+	for (int i = 0; i < Configuration::NUMBER_IMAGES; ++i) {
+		const BYTE* data = nullptr;
+		DWORD size = 0;
+		if (!GetEncodedImage(skinId, i, data, size)) return 0;
+		hash = FrameCache::Hash(data, size, hash);
+	}
+	return hash;
+}
+
+bool ImageManager::LoadCachedFrames(uint64_t key, SIZE size, int count, std::vector<BitmapWrapper>& frames) {
+	frames.clear();
+	std::vector<uint8_t*> bits;
+	for (int i = 0; i < count; ++i) {
+		void* frameBits = nullptr;
+		HBITMAP hbmp = CreateFrameBitmap(size.cx, size.cy, &frameBits);
+		if (!hbmp) break;
+		frames.emplace_back(hbmp, true);
+		bits.push_back(static_cast<uint8_t*>(frameBits));
+	}
+	if (frames.size() != static_cast<size_t>(count) || !FrameCache::Load(key, size.cx, size.cy, count, bits.data())) {
+		frames.clear();
+		return false;
+	}
+	return true;
+}
+
+void ImageManager::StoreCachedFrames(uint64_t key, SIZE size, const std::vector<BitmapWrapper>& frames) {
+	std::vector<const uint8_t*> pixels;
+	for (const BitmapWrapper& frame : frames) {
+		const BYTE* framePixels = GetBitmapPixels(frame.get());
+		if (!framePixels) return;
+		pixels.push_back(framePixels);
+	}
+	GdiFlush();
+	FrameCache::Store(key, size.cx, size.cy, static_cast<int>(pixels.size()), pixels.data());
+}
+
+void ImageManager::SetTransitionsEnabled(bool enabled) {
+	if (enabled == m_transitionsEnabled) return;
+	m_transitionsEnabled = enabled;
+	// Scaled sets hold every frame, so they are rebuilt with the new frame list
+	ReleaseNativeSurfaces();
+	m_scaled.clear();
+	m_transitionFrames.clear();
+	m_timeline.Clear();
+	if (enabled && !m_images.empty()) {
+		BuildTransitions();
+	}
+	UpdateFrameBytes();
+}
+
+bool ImageManager::BuildTransitions() {
+	TRACE_SCOPE("BuildTransitions");
+	ReleaseNativeSurfaces();
+	m_transitionFrames.clear();
+	m_timeline.Clear();
+	if (m_images.size() != Configuration::NUMBER_IMAGES) return false;
+
+	// Blended once per skin; playback only selects frames
+	GdiFlush();
+	const size_t pixelCount = static_cast<size_t>(Configuration::IMAGE_WIDTH) * Configuration::IMAGE_HEIGHT;
+	for (int pair = 0; pair < Configuration::CROSSFADE_PAIR_COUNT; ++pair) {
+		const int from = Configuration::CROSSFADE_PAIRS[pair][0];
+		const int to = Configuration::CROSSFADE_PAIRS[pair][1];
+		const BYTE* fromPixels = GetImagePixels(from);
+		const BYTE* toPixels = GetImagePixels(to);
+		if (!fromPixels || !toPixels) break;
+
+		uint8_t frames[Configuration::CROSSFADE_STEPS] = {};
+		int built = 0;
+		for (; built < Configuration::CROSSFADE_STEPS; ++built) {
+			void* bits = nullptr;
+			HBITMAP hbmp = CreateFrameBitmap(Configuration::IMAGE_WIDTH, Configuration::IMAGE_HEIGHT, &bits);
+			if (!hbmp) break;
+			FrameBlend::CrossFade(fromPixels, toPixels, static_cast<uint8_t*>(bits), pixelCount,
+				TransitionTimeline::EaseOutWeight(built, Configuration::CROSSFADE_STEPS));
+			frames[built] = static_cast<uint8_t>(GetFrameCount());
+			m_transitionFrames.emplace_back(hbmp, true);
+		}
+		if (built != Configuration::CROSSFADE_STEPS) {
+			// Out of GDI memory: fall back to hard cuts everywhere
+			m_transitionFrames.clear();
+			m_timeline.Clear();
+			return false;
+		}
+		m_timeline.Add(from, to, frames, built);
+	}
+	return true;
+}
+
+SIZE ImageManager::GetFrameSize(int scalePercent) const {
+	if (SkinPresentation::IsPixelArt(m_skinId)) {
+		// Whole factors only, so every source pixel stays a square block
+		scalePercent = ((scalePercent + 50) / 100) * 100;
+		if (scalePercent < 100) scalePercent = 100;
+	}
+	SIZE size = { MulDiv(Configuration::IMAGE_WIDTH, scalePercent, 100), MulDiv(Configuration::IMAGE_HEIGHT, scalePercent, 100) };
+	return size;
+}
+
+HBITMAP ImageManager::GetImage(int index, SIZE size) {
+	if (size.cx == Configuration::IMAGE_WIDTH && size.cy == Configuration::IMAGE_HEIGHT) {
+		return GetImage(index);
+	}
+	if (!ValidationUtils::IsValidImageIndex(index, GetFrameCount())) {
+		return nullptr;
+	}
+
+	const ScaledFrameSet* scaled = FindFrameSet(size);
+	return scaled ? scaled->images[index].get() : nullptr;
+}
+
+HDC ImageManager::GetFrameSurface(int index, SIZE size) {
+	if (!ValidationUtils::IsValidImageIndex(index, GetFrameCount())) {
+		return nullptr;
+	}
+	ScaledFrameSet* set = FindFrameSet(size);
+	if (!set || !PrepareSurfaces(*set)) return nullptr;
+	return set->surfaces[index].get();
+}
+
+RECT ImageManager::GetFrameDamage(int from, int to, SIZE size) {
+	const RECT whole = { 0, 0, size.cx, size.cy };
+	const int count = GetFrameCount();
+	if (!ValidationUtils::IsValidImageIndex(from, count) || !ValidationUtils::IsValidImageIndex(to, count)) {
+		return whole;
+	}
+	ScaledFrameSet* set = FindFrameSet(size);
+	if (!set || set->damage.empty()) return whole;
+
+	RECT& damage = set->damage[static_cast<size_t>(from) * count + to];
+	if (damage.left < 0) {
+		GdiFlush();
+		const BYTE* fromPixels = GetBitmapPixels(set->images[from].get());
+		const BYTE* toPixels = GetBitmapPixels(set->images[to].get());
+		if (!fromPixels || !toPixels) return whole;
+		damage = MeasureDamage(fromPixels, toPixels, size);
+		set->damage[static_cast<size_t>(to) * count + from] = damage;
+	}
+	return damage;
+}
+
+ImageManager::ScaledFrameSet* ImageManager::FindFrameSet(SIZE size) {
+	if (size.cx == Configuration::IMAGE_WIDTH && size.cy == Configuration::IMAGE_HEIGHT) {
+		if (m_native.images.empty()) {
+			m_native.size = size;
+			for (int i = 0; i < GetFrameCount(); ++i) {
+				m_native.images.emplace_back(GetImage(i), false);
+			}
+		}
+		return m_native.images.empty() ? nullptr : &m_native;
+	}
+
+	for (size_t i = 0; i < m_scaled.size(); ++i) {
+		if (m_scaled[i].size.cx == size.cx && m_scaled[i].size.cy == size.cy) {
+			// Keep the active size at the front so eviction drops the stalest
+			if (i != 0) std::swap(m_scaled[0], m_scaled[i]);
+			return &m_scaled[0];
+		}
+	}
+	return BuildScaledSet(size);
+}
+
+bool ImageManager::PrepareSurfaces(ScaledFrameSet& set) {
+	if (!set.surfaces.empty()) return true;
+	TRACE_SCOPE("PrepareSurfaces");
+	// Selected once here instead of on every present; a bitmap lives in at most one DC
+	for (const BitmapWrapper& image : set.images) {
+		HDC surface = CreateCompatibleDC(nullptr);
+		if (!surface) {
+			set.surfaces.clear();
+			return false;
+		}
+		set.surfaces.emplace_back(surface, true);
+		HGDIOBJ previous = SelectObject(surface, image.get());
+		if (!previous || previous == HGDI_ERROR) {
+			set.surfaces.clear();
+			return false;
+		}
+	}
+	const RECT unmeasured = { -1, -1, -1, -1 };
+	set.damage.assign(set.images.size() * set.images.size(), unmeasured);
+	return true;
+}
+
+RECT ImageManager::MeasureDamage(const BYTE* from, const BYTE* to, SIZE size) {
+	const size_t stride = static_cast<size_t>(size.cx) * Configuration::BYTES_PER_PIXEL;
+	RECT damage = { 0, 0, 0, 0 };
+	int top = 0;
+	while (top < size.cy && memcmp(from + top * stride, to + top * stride, stride) == 0) ++top;
+	if (top == size.cy) return damage; // identical frames
+	int bottom = size.cy;
+	while (memcmp(from + (bottom - 1) * stride, to + (bottom - 1) * stride, stride) == 0) --bottom;
+
+	int left = size.cx;
+	int right = 0;
+	for (int y = top; y < bottom; ++y) {
+		const uint32_t* a = reinterpret_cast<const uint32_t*>(from + y * stride);
+		const uint32_t* b = reinterpret_cast<const uint32_t*>(to + y * stride);
+		int x = 0;
+		while (x < left && a[x] == b[x]) ++x;
+		left = x;
+		x = size.cx;
+		while (x > right && a[x - 1] == b[x - 1]) --x;
+		right = x;
+	}
+	damage = { left, top, right, bottom };
+	return damage;
+}
+
+void ImageManager::ReleaseNativeSurfaces() {
+	// The DCs go before the borrowed bitmaps, which cannot be deleted while selected
+	m_native.damage.clear();
+	m_native.surfaces.clear();
+	m_native.images.clear();
+}
+
+ImageManager::ScaledFrameSet* ImageManager::BuildScaledSet(SIZE size) {
+	TRACE_SCOPE("BuildScaledSet");
+	if (size.cx <= 0 || size.cy <= 0) return nullptr;
+	const Resampler::Filter filter = SkinPresentation::IsPixelArt(m_skinId)
+		? Resampler::Filter::Nearest : Resampler::Filter::Bilinear;
+
+	// Resampled from the decoded frames, never from the PNGs, unless an earlier run cached this size
+	ScaledFrameSet scaled = { size, {}, {}, {} };
+	const uint64_t cacheKey = m_sourceHash ? FrameCache::MakeKey(m_sourceHash, size.cx, size.cy, GetFrameCount(),
+		filter == Resampler::Filter::Nearest ? FrameCache::ScaledNearest : FrameCache::ScaledBilinear) : 0;
+	if (!cacheKey || !LoadCachedFrames(cacheKey, size, GetFrameCount(), scaled.images)) {
+		for (int i = 0; i < GetFrameCount(); ++i) {
+			const BYTE* source = GetImagePixels(i);
+			void* bits = nullptr;
+			HBITMAP hbmp = source ? CreateFrameBitmap(size.cx, size.cy, &bits) : nullptr;
+			if (!hbmp) return nullptr;
+			Resampler::Resize(source, Configuration::IMAGE_WIDTH, Configuration::IMAGE_HEIGHT,
+				Configuration::IMAGE_WIDTH * Configuration::BYTES_PER_PIXEL,
+				static_cast<uint8_t*>(bits), size.cx, size.cy, size.cx * Configuration::BYTES_PER_PIXEL, filter);
+			scaled.images.emplace_back(hbmp, true);
+		}
+		if (cacheKey) StoreCachedFrames(cacheKey, size, scaled.images);
+	}
+
+	m_scaled.insert(m_scaled.begin(), std::move(scaled));
+	if (m_scaled.size() > Configuration::SCALED_FRAME_SET_CACHE) {
+		m_scaled.pop_back();
+	}
+	UpdateFrameBytes();
+	return &m_scaled.front();
+}
+
+void ImageManager::UpdateFrameBytes() const {
+#if BONGOCAT_METRICS
+	size_t frames = static_cast<size_t>(GetFrameCount());
+	if (HasFrameEffects()) frames += m_baseImages.size(); // the undecorated frames are kept for re-baking
+	size_t pixels = frames * Configuration::IMAGE_WIDTH * Configuration::IMAGE_HEIGHT;
+	for (const ScaledFrameSet& scaled : m_scaled) {
+		pixels += scaled.images.size() * static_cast<size_t>(scaled.size.cx) * static_cast<size_t>(scaled.size.cy);
+	}
+	METRIC_SET(FrameBytes, pixels * Configuration::BYTES_PER_PIXEL);
+#endif
+}
+
 HBITMAP ImageManager::GetImage(int index) const {
-	if (!ValidationUtils::IsValidImageIndex(index, static_cast<int>(m_images.size()))) {
+	if (!ValidationUtils::IsValidImageIndex(index, GetFrameCount())) {
 		return nullptr;
 	}
-	return m_images[index].get();
+	const size_t imageCount = m_images.size();
+	return static_cast<size_t>(index) < imageCount
+		? m_images[index].get()
+		: m_transitionFrames[static_cast<size_t>(index) - imageCount].get();
+}
+
+bool ImageManager::GetEncodedImage(int skinId, int index, const BYTE*& data, DWORD& size) const {
+	data = nullptr;
+	size = 0;
+	// Built-in skins only; pack skins have no embedded PNG, and this may run off the UI thread
+	if (skinId < 0 || skinId >= Configuration::SKIN_COUNT || !ValidationUtils::IsValidImageIndex(index, Configuration::NUMBER_IMAGES)) {
+		return false;
+	}
+	const int resourceID = Configuration::GetSkinResourceId(skinId, index);
+	HRSRC resource = FindResourceW(m_hInstance, MAKEINTRESOURCEW(resourceID), L"PNG");
+	if (!resource) return false;
+	HGLOBAL loaded = LoadResource(m_hInstance, resource);
+	if (!loaded) return false;
+	data = static_cast<const BYTE*>(LockResource(loaded));
+	size = SizeofResource(m_hInstance, resource);
+	return data != nullptr && size != 0;
+}
+
+const BYTE* ImageManager::GetImagePixels(int index) const {
+	return GetBitmapPixels(GetImage(index));
+}
+
+const BYTE* ImageManager::GetBitmapPixels(HBITMAP bitmap) {
+	if (!bitmap) return nullptr;
+	DIBSECTION section = {};
+	if (GetObjectW(bitmap, sizeof(section), &section) != sizeof(section)) return nullptr;
+	return static_cast<const BYTE*>(section.dsBm.bmBits);
 }
@@ -1,19 +1,64 @@
 #pragma once
 #include <windows.h>
 #include <memory>
+#include <cstdint>
 #include <vector>
 #include "../utils/Configuration.h"
 #include "../utils/RAII/Gdi.h"
 #include "../utils/ValidationUtils.h"
+#include "../utils/ColorTransform.h"
+#include "../utils/FrameOutline.h"
+#include "../utils/SkinPacks.h"
+#include "../states/TransitionTimeline.h"
 // Concrete class; no interface indirection
 
 class ImageManager {
 private:
+	// One skin's frames at a window size. Presented frames stay selected into their own memory
+	// DCs, so a present only names a surface; the damage between two frames is measured once.
+	struct ScaledFrameSet {
+		SIZE size;
+		std::vector<BitmapWrapper> images;
+		std::vector<DeviceContextWrapper> surfaces; // after images, so the DCs let go of their bitmaps first
+		std::vector<RECT> damage;                   // [from * count + to]; left < 0 until measured
+	};
+
 	HINSTANCE m_hInstance;
-	std::vector<BitmapWrapper> m_images;
+	int m_skinId;
+	uint64_t m_baseHash;   // embedded PNG bytes of the skin; 0 for packs
+	uint64_t m_sourceHash; // base frames plus frame effects; 0 keeps frame sets out of the disk cache
+	std::vector<BitmapWrapper> m_baseImages; // decoded skin frames
+	std::vector<BitmapWrapper> m_images;     // presented frames: the base frames, or copies with tint, accessories and outline baked in
+	// Pack frames and accessory layers are borrowed from the catalog; these keep them alive while in use
+	std::vector<std::shared_ptr<const SkinPackFrame>> m_packFrames;
+	std::vector<std::shared_ptr<const SkinPackFrame>> m_accessories; // drawn in order
+	ColorTransform::Tint m_tint;
+	int m_outline; // FrameOutline style
+	// Cross-fade frames, indexed after the images; built only while transitions are on
+	std::vector<BitmapWrapper> m_transitionFrames;
+	TransitionTimeline m_timeline;
+	bool m_transitionsEnabled;
+	std::vector<ScaledFrameSet> m_scaled; // most recently used first
+	// Surfaces of the unscaled frames, which borrow the bitmaps above; released before they change
+	ScaledFrameSet m_native;
 
 	// Helper methods
 	HBITMAP LoadPNGFromResources(int resourceID);
+	bool LoadPackImages(const SkinPack& pack);
+	uint64_t HashEmbeddedImages(int skinId) const;
+	static bool LoadCachedFrames(uint64_t key, SIZE size, int count, std::vector<BitmapWrapper>& frames);
+	static void StoreCachedFrames(uint64_t key, SIZE size, const std::vector<BitmapWrapper>& frames);
+	static const BYTE* GetBitmapPixels(HBITMAP bitmap);
+	ScaledFrameSet* BuildScaledSet(SIZE size);
+	ScaledFrameSet* FindFrameSet(SIZE size);
+	static bool PrepareSurfaces(ScaledFrameSet& set);
+	static RECT MeasureDamage(const BYTE* from, const BYTE* to, SIZE size);
+	void ReleaseNativeSurfaces();
+	bool HasFrameEffects() const noexcept { return !m_accessories.empty() || !m_tint.IsIdentity() || m_outline != FrameOutline::STYLE_NONE; }
+	bool BakeFrames();
+	void RebuildFrames();
+	bool BuildTransitions();
+	void UpdateFrameBytes() const;
 
 public:
 	ImageManager(HINSTANCE hInstance);
@@ -23,9 +68,36 @@ public:
 	bool Initialize(int skinId);
 	void Cleanup();
 
-	// Image loading
+	// Image loading (built-in skins from resources, pack skins from the adopted catalog)
 	bool LoadImages(int skinId);
+	// Top-down 32bpp DIB usable from any thread
+	static HBITMAP CreateFrameBitmap(int width, int height, void** bits);
+
+	// Accessory layers composited over every frame of this and later skins; false if unchanged
+	bool SetAccessories(std::vector<std::shared_ptr<const SkinPackFrame>> layers);
+	// Recoloring of the skin (not its accessories) for this and later skins; false if unchanged
+	bool SetTint(const ColorTransform::Tint& tint);
+	// Outline or drop shadow (FrameOutline style) drawn around this and later skins; false if unchanged
+	bool SetOutline(int outline);
+
+	// Cross-fade frames and their timeline
+	void SetTransitionsEnabled(bool enabled);
+	const TransitionTimeline& GetTimeline() const noexcept { return m_timeline; }
 
-	// Image access
+	// Image access (indices past GetImageCount() are cross-fade frames)
 	HBITMAP GetImage(int index) const;
+	// Frame at a window size; resampled once from the decoded frames and cached per size
+	HBITMAP GetImage(int index, SIZE size);
+	// Memory DC with the frame at a window size selected into it, created once per frame set
+	HDC GetFrameSurface(int index, SIZE size);
+	// Bounds of the pixels that differ between two frames at a window size (the whole frame if unknown)
+	RECT GetFrameDamage(int from, int to, SIZE size);
+	// Window size for a scale percentage (pixel-art skins snap to whole factors)
+	SIZE GetFrameSize(int scalePercent) const;
+	int GetImageCount() const noexcept { return static_cast<int>(m_images.size()); }
+	int GetFrameCount() const noexcept { return static_cast<int>(m_images.size() + m_transitionFrames.size()); }
+	// Top-down premultiplied BGRA bits of a loaded frame (stride = width * 4)
+	const BYTE* GetImagePixels(int index) const;
+	// Embedded PNG of a built-in skin frame; module resources stay mapped for the process lifetime
+	bool GetEncodedImage(int skinId, int index, const BYTE*& data, DWORD& size) const;
 };
@@ -1,5 +1,8 @@
 #include "InputManager.h"
 #include "../utils/Configuration.h"
+#include "../utils/KeyboardLayout.h"
+#include "../utils/Metrics.h"
+#include "../utils/Trace.h"
 #include <atomic>
 #include "../states/ApplicationState.h"
 #include "../app/BongoCatApp.h"
@@ -20,6 +23,7 @@ namespace {
 // Global hook procedures
 LRESULT CALLBACK LowLevelKeyboardProc(int nCode, WPARAM wParam, LPARAM lParam) {
 	if (nCode >= HC_ACTION) {
+		METRIC_INC(KeyboardHookCalls);
 		BongoCatApp* app = GetHooksApp();
 		if (app && app->GetInputManager()) {
 			app->GetInputManager()->OnKeyboardEvent(wParam, lParam);
@@ -30,6 +34,7 @@ LRESULT CALLBACK LowLevelKeyboardProc(int nCode, WPARAM wParam, LPARAM lParam) {
 
 LRESULT CALLBACK LowLevelMouseProc(int nCode, WPARAM wParam, LPARAM lParam) {
 	if (nCode >= HC_ACTION) {
+		METRIC_INC(MouseHookCalls);
 		BongoCatApp* app = GetHooksApp();
 		if (app && app->GetInputManager()) {
 			app->GetInputManager()->OnMouseEvent(wParam, lParam);
@@ -90,27 +95,89 @@ void InputManager::RemoveHooks() {
 void InputManager::OnKeyboardEvent(WPARAM wParam, LPARAM lParam) {
 	if (!m_app || !m_app->GetState()) return;
 
+	const KBDLLHOOKSTRUCT* info = reinterpret_cast<const KBDLLHOOKSTRUCT*>(lParam);
+	if (!info) return;
+	const uint8_t key = static_cast<uint8_t>(info->vkCode);
+
 	bool keydown = (wParam == WM_KEYDOWN || wParam == WM_SYSKEYDOWN);
 	bool keyup = (wParam == WM_KEYUP || wParam == WM_SYSKEYUP);
 
-	if (keydown && !m_app->GetState()->IsKeyPressed()) {
-		m_app->GetState()->SetKeyPressed(true);
-		HWND mainWindow = m_app->GetMainWindow();
-		if (mainWindow) {
-			// Use SendNotifyMessage for better performance - non-blocking
-			SendNotifyMessage(mainWindow, Configuration::WM_APP_INPUT_EVENT, 0, 0);
-		}
+	// Every distinct new keydown counts; auto-repeat of a held key is filtered by the key set
+	bool fresh = keydown && m_app->GetState()->PressKey(key);
+	if (keydown && !fresh && (GetAsyncKeyState(key) & 0x8000) == 0) {
+		// A "repeat" of a key the system reports up means its keyup was missed; start over
+		m_app->GetState()->ReleaseKey(key);
+		fresh = m_app->GetState()->PressKey(key);
+	}
+	if (fresh) {
+		m_app->GetState()->GetKeyRate().Record(GetTickCount64());
+		NotifyInput(KeyboardLayout::GetPawSide(info->scanCode, (info->flags & LLKHF_EXTENDED) != 0), info->time);
 	}
 	else if (keyup) {
-		m_app->GetState()->SetKeyPressed(false);
+		m_app->GetState()->ReleaseKey(key);
 	}
 }
 
 void InputManager::OnMouseEvent(WPARAM wParam, LPARAM lParam) {
-	if (wParam == WM_LBUTTONDOWN || wParam == WM_RBUTTONDOWN || wParam == WM_MBUTTONDOWN) {
-		if (m_app && m_app->GetMainWindow()) {
-			// Use SendNotifyMessage for better performance - non-blocking
-			SendNotifyMessage(m_app->GetMainWindow(), Configuration::WM_APP_INPUT_EVENT, 0, 0);
-		}
+	if (!m_app || !m_app->GetState()) return;
+	const MSLLHOOKSTRUCT* info = reinterpret_cast<const MSLLHOOKSTRUCT*>(lParam);
+	if (!info) return;
+
+	// Hottest path (1-8 kHz on gaming mice): accumulate only, never wake the UI
+	if (wParam == WM_MOUSEMOVE) {
+		m_app->GetState()->GetMouseOdometer().OnMove(info->pt.x, info->pt.y);
+		return;
+	}
+
+	bool drivesPaw = (wParam == WM_LBUTTONDOWN || wParam == WM_RBUTTONDOWN || wParam == WM_MBUTTONDOWN);
+	if (wParam == WM_MOUSEWHEEL || wParam == WM_MOUSEHWHEEL) {
+		// High-resolution wheels report fractions of a notch; only whole notches drive paws
+		const int notches = m_app->GetState()->GetMouseOdometer().OnWheel(GET_WHEEL_DELTA_WPARAM(info->mouseData));
+		drivesPaw = notches > 0 && m_app->GetState()->GetMouseExtrasDrivePaws();
 	}
+	else if (wParam == WM_XBUTTONDOWN) {
+		drivesPaw = m_app->GetState()->GetMouseExtrasDrivePaws();
+	}
+
+	if (drivesPaw) {
+		NotifyInput(PawSide::Any, info->time);
+	}
+}
+
+void InputManager::NotifyInput(PawSide side, DWORD eventTime) {
+	HWND mainWindow = m_app->GetMainWindow();
+	if (!mainWindow) return;
+	TRACE_INSTANT("InputHook");
+
+	// The OS stamps input with the millisecond tick clock; later stages use QPC
+	InputTiming timing;
+	timing.hookStamp = InputLatency::Stamp();
+	timing.hookDelayMs = static_cast<uint32_t>(GetTickCount() - eventTime);
+	m_app->GetState()->GetLatency().Record(LatencyStage::HookToQueue, static_cast<uint64_t>(timing.hookDelayMs) * 1000);
+
+	// Hidden: nothing to draw, so count right here instead of waking the window procedure
+	if (!m_app->GetState()->IsVisible()) {
+		m_app->GetState()->SetLastInputTick(GetTickCount64());
+		m_app->GetState()->IncrementClickCount();
+		m_app->PublishState();
+		return;
+	}
+
+	WPARAM wParam = 0;
+	LPARAM lParam = 0;
+	EncodeInputEvent(side, timing, wParam, lParam);
+	// Use SendNotifyMessage for better performance - non-blocking
+	SendNotifyMessage(mainWindow, Configuration::WM_APP_INPUT_EVENT, wParam, lParam);
+}
+
+void InputManager::EncodeInputEvent(PawSide side, const InputTiming& timing, WPARAM& wParam, LPARAM& lParam) noexcept {
+	const uint32_t delayMs = timing.hookDelayMs < 0xFFFFFFu ? timing.hookDelayMs : 0xFFFFFFu; // 24 bits
+	wParam = static_cast<WPARAM>(static_cast<uint32_t>(side) | (delayMs << 8));
+	lParam = static_cast<LPARAM>(timing.hookStamp);
+}
+
+void InputManager::DecodeInputEvent(WPARAM wParam, LPARAM lParam, PawSide& side, InputTiming& timing) noexcept {
+	side = static_cast<PawSide>(wParam & 0xFF);
+	timing.hookDelayMs = static_cast<uint32_t>(wParam >> 8) & 0xFFFFFFu;
+	timing.hookStamp = static_cast<uint32_t>(lParam);
 }
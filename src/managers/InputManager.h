@@ -2,6 +2,8 @@
 #include <windows.h>
 #include <memory>
 #include "../utils/RAII/Hook.h"
+#include "../states/CatStateMachine.h"
+#include "../states/LatencyHistogram.h"
 
 // Forward declaration
 class BongoCatApp;
@@ -19,6 +21,7 @@ private:
 	// Helper methods
 	bool InstallHooks();
 	void RemoveHooks();
+	void NotifyInput(PawSide side, DWORD eventTime);
 
 public:
 	InputManager(BongoCatApp* app);
@@ -31,4 +34,8 @@ public:
 	// Event handlers (called from global hook procedures)
 	void OnKeyboardEvent(WPARAM wParam, LPARAM lParam);
 	void OnMouseEvent(WPARAM wParam, LPARAM lParam);
+
+	// WM_APP_INPUT_EVENT parameters: wParam = side | hook delay ms << 8, lParam = hook stamp
+	static void EncodeInputEvent(PawSide side, const InputTiming& timing, WPARAM& wParam, LPARAM& lParam) noexcept;
+	static void DecodeInputEvent(WPARAM wParam, LPARAM lParam, PawSide& side, InputTiming& timing) noexcept;
 };
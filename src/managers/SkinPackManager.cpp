@@ -0,0 +1,294 @@
+#include "SkinPackManager.h"
+#include "../app/BongoCatApp.h"
+#include "../utils/Configuration.h"
+#include "../utils/SkinPackLoader.h"
+#include "../utils/RAII/Com.h"
+#include <wincodec.h>
+#include <shlobj.h>
+#include <shlwapi.h>
+#include <algorithm>
+#include <vector>
+
+namespace {
+	std::wstring GetPacksRoot() {
+		PWSTR localAppData = nullptr;
+		if (FAILED(SHGetKnownFolderPath(FOLDERID_LocalAppData, 0, nullptr, &localAppData)) || !localAppData) {
+			if (localAppData) CoTaskMemFree(localAppData);
+			return L"";
+		}
+		std::wstring root = localAppData;
+		CoTaskMemFree(localAppData);
+		root += L"\\";
+		root += Configuration::SKIN_PACK_DIRECTORY;
+		// Created up front so there is a folder to drop packs into and to watch
+		const int created = SHCreateDirectoryExW(nullptr, root.c_str(), nullptr);
+		if (created != ERROR_SUCCESS && created != ERROR_ALREADY_EXISTS) return L"";
+		return root;
+	}
+
+	bool IsContainer(const wchar_t* fileName) {
+		const wchar_t* extension = PathFindExtensionW(fileName);
+		return _wcsicmp(extension, Configuration::SKIN_PACK_CONTAINER_EXTENSION) == 0;
+	}
+
+	// Pack folders and .bcskin files directly under the root; the accessories folder is not a pack
+	std::vector<std::wstring> ListPacks(const std::wstring& root) {
+		std::vector<std::wstring> packs;
+		WIN32_FIND_DATAW data = {};
+		HANDLE find = FindFirstFileExW((root + L"\\*").c_str(), FindExInfoBasic, &data,
+			FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+		if (find == INVALID_HANDLE_VALUE) return packs;
+		do {
+			if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+				if (wcscmp(data.cFileName, L".") == 0 || wcscmp(data.cFileName, L"..") == 0) continue;
+				if (_wcsicmp(data.cFileName, Configuration::SKIN_PACK_ACCESSORY_DIRECTORY) == 0) continue;
+			}
+			else if (!IsContainer(data.cFileName)) {
+				continue;
+			}
+			packs.emplace_back(data.cFileName);
+		} while (FindNextFileW(find, &data));
+		FindClose(find);
+
+		// Name order fixes the skin ids, so it must not depend on enumeration order
+		std::sort(packs.begin(), packs.end(), [](const std::wstring& a, const std::wstring& b) {
+			return _wcsicmp(a.c_str(), b.c_str()) < 0;
+		});
+		if (packs.size() > static_cast<size_t>(Configuration::SKIN_PACK_MAX)) {
+			packs.resize(Configuration::SKIN_PACK_MAX);
+		}
+		return packs;
+	}
+
+	// Accessory PNGs in name order, which fixes the accessory ids
+	std::vector<std::wstring> ListAccessories(const std::wstring& directory) {
+		std::vector<std::wstring> files;
+		WIN32_FIND_DATAW data = {};
+		HANDLE find = FindFirstFileExW((directory + L"\\" + Configuration::SKIN_PACK_ACCESSORY_PATTERN).c_str(),
+			FindExInfoBasic, &data, FindExSearchNameMatch, nullptr, 0);
+		if (find == INVALID_HANDLE_VALUE) return files;
+		do {
+			if (!(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) files.emplace_back(data.cFileName);
+		} while (FindNextFileW(find, &data));
+		FindClose(find);
+
+		std::sort(files.begin(), files.end(), [](const std::wstring& a, const std::wstring& b) {
+			return _wcsicmp(a.c_str(), b.c_str()) < 0;
+		});
+		if (files.size() > static_cast<size_t>(Configuration::ACCESSORY_MAX)) {
+			files.resize(Configuration::ACCESSORY_MAX);
+		}
+		return files;
+	}
+
+	bool IsSameSource(const SkinPackFrame& frame, const WIN32_FILE_ATTRIBUTE_DATA& attributes) {
+		const ULONGLONG size = (static_cast<ULONGLONG>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+		return frame.fileSize == size && CompareFileTime(&frame.writeTime, &attributes.ftLastWriteTime) == 0;
+	}
+
+	const SkinPack* FindPack(const SkinPackCatalog* catalog, const std::wstring& folder) {
+		if (!catalog) return nullptr;
+		for (const SkinPack& pack : catalog->packs) {
+			if (_wcsicmp(pack.folder.c_str(), folder.c_str()) == 0) return &pack;
+		}
+		return nullptr;
+	}
+
+	const SkinAccessory* FindAccessory(const SkinPackCatalog* catalog, const std::wstring& file) {
+		if (!catalog) return nullptr;
+		for (const SkinAccessory& accessory : catalog->accessories) {
+			if (_wcsicmp(accessory.file.c_str(), file.c_str()) == 0) return &accessory;
+		}
+		return nullptr;
+	}
+
+	bool IsSameCatalog(const SkinPackCatalog& a, const SkinPackCatalog& b) {
+		if (a.packs.size() != b.packs.size() || a.accessories.size() != b.accessories.size()) return false;
+		for (size_t i = 0; i < a.packs.size(); ++i) {
+			const SkinPack& x = a.packs[i];
+			const SkinPack& y = b.packs[i];
+			if (x.folder != y.folder || x.name != y.name ||
+				x.unlockThreshold != y.unlockThreshold || x.pixelArt != y.pixelArt ||
+				x.frames != y.frames) {
+				return false;
+			}
+		}
+		for (size_t i = 0; i < a.accessories.size(); ++i) {
+			if (a.accessories[i].file != b.accessories[i].file || a.accessories[i].layer != b.accessories[i].layer) return false;
+		}
+		return true;
+	}
+}
+
+SkinPackManager::SkinPackManager(BongoCatApp* app)
+	: m_app(app)
+	, m_targetWindow(nullptr) {
+}
+
+SkinPackManager::~SkinPackManager() {
+	Shutdown();
+}
+
+bool SkinPackManager::Initialize() {
+	if (!m_app || !m_app->GetMainWindow()) return false;
+	m_targetWindow = m_app->GetMainWindow();
+
+	m_stopEvent = HandleWrapper(CreateEventW(nullptr, TRUE, FALSE, nullptr), true);
+	if (!m_stopEvent.isValid()) return false;
+
+	m_worker = std::thread(&SkinPackManager::WatchLoop, this);
+	return true;
+}
+
+void SkinPackManager::Shutdown() {
+	if (!m_worker.joinable()) return;
+	SetEvent(m_stopEvent.get());
+	// The worker only posts to the UI thread, so joining cannot deadlock
+	m_worker.join();
+	m_stopEvent = HandleWrapper();
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_pending.reset();
+}
+
+std::shared_ptr<const SkinPackCatalog> SkinPackManager::TakeCatalog() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return std::move(m_pending);
+}
+
+void SkinPackManager::Publish(std::shared_ptr<const SkinPackCatalog> catalog) {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pending = std::move(catalog);
+	}
+	PostMessageW(m_targetWindow, Configuration::WM_APP_SKIN_PACKS, 0, 0);
+}
+
+std::shared_ptr<const SkinPackCatalog> SkinPackManager::Scan(IWICImagingFactory* factory, const std::wstring& root,
+	const SkinPackCatalog* previous) const {
+	auto catalog = std::make_shared<SkinPackCatalog>();
+	for (const std::wstring& folder : ListPacks(root)) {
+		if (WaitForSingleObject(m_stopEvent.get(), 0) != WAIT_TIMEOUT) break;
+
+		const std::wstring folderPath = root + L"\\" + folder;
+		SkinPack pack;
+		pack.folder = folder;
+		const SkinPack* old = FindPack(previous, folder);
+
+		if (IsContainer(folder.c_str())) {
+			// One file holds every frame, so it is reused or reloaded as a whole
+			WIN32_FILE_ATTRIBUTE_DATA attributes = {};
+			const bool exists = GetFileAttributesExW(folderPath.c_str(), GetFileExInfoStandard, &attributes) != FALSE;
+			if (exists && old && old->frames[0] && IsSameSource(*old->frames[0], attributes)) {
+				catalog->packs.push_back(*old);
+			}
+			else if (SkinPackLoader::LoadContainer(folderPath, pack)) {
+				catalog->packs.push_back(std::move(pack));
+			}
+			else if (exists && old) {
+				catalog->packs.push_back(*old); // caught mid-write
+			}
+			continue;
+		}
+
+		SkinPackLoader::ReadManifest(folderPath, pack);
+		bool complete = true;
+		for (int i = 0; i < Configuration::NUMBER_IMAGES; ++i) {
+			const std::wstring path = folderPath + L"\\" + Configuration::SKIN_PACK_FRAME_FILES[i];
+			const std::shared_ptr<const SkinPackFrame> oldFrame = (old && old->pixelArt == pack.pixelArt) ? old->frames[i] : nullptr;
+
+			// Only frames whose file changed are decoded again
+			WIN32_FILE_ATTRIBUTE_DATA attributes = {};
+			const bool exists = GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &attributes) != FALSE;
+			if (exists && oldFrame && IsSameSource(*oldFrame, attributes)) {
+				pack.frames[i] = oldFrame;
+				continue;
+			}
+			pack.frames[i] = exists ? SkinPackLoader::DecodePng(factory, path, pack.pixelArt) : nullptr;
+			// A file caught mid-save fails to decode; keep showing the last good frame until it settles
+			if (!pack.frames[i] && exists) pack.frames[i] = oldFrame;
+			if (!pack.frames[i]) {
+				complete = false;
+				break;
+			}
+		}
+		if (complete) catalog->packs.push_back(std::move(pack));
+	}
+
+	// Accessories decode like pack frames: to frame size, premultiplied, reused while the file is unchanged
+	const std::wstring accessoryDirectory = root + L"\\" + Configuration::SKIN_PACK_ACCESSORY_DIRECTORY;
+	for (const std::wstring& file : ListAccessories(accessoryDirectory)) {
+		if (WaitForSingleObject(m_stopEvent.get(), 0) != WAIT_TIMEOUT) break;
+
+		const std::wstring path = accessoryDirectory + L"\\" + file;
+		const SkinAccessory* old = FindAccessory(previous, file);
+		SkinAccessory accessory;
+		accessory.file = file;
+		accessory.name = file.substr(0, static_cast<size_t>(PathFindExtensionW(file.c_str()) - file.c_str()));
+
+		WIN32_FILE_ATTRIBUTE_DATA attributes = {};
+		if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &attributes)) continue;
+		if (old && old->layer && IsSameSource(*old->layer, attributes)) {
+			accessory.layer = old->layer;
+		}
+		else {
+			accessory.layer = SkinPackLoader::DecodePng(factory, path, false);
+			if (!accessory.layer && old) accessory.layer = old->layer;
+		}
+		if (accessory.layer) catalog->accessories.push_back(std::move(accessory));
+	}
+	return catalog;
+}
+
+void SkinPackManager::WatchLoop() {
+	ComInitWrapper com(COINIT_MULTITHREADED);
+	if (!com.isValid()) return;
+	IWICImagingFactory* rawFactory = nullptr;
+	if (FAILED(CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&rawFactory)))) return;
+	ComWrapper<IWICImagingFactory> factory(rawFactory, true);
+
+	const std::wstring root = GetPacksRoot();
+	if (root.empty()) return;
+
+	std::shared_ptr<const SkinPackCatalog> catalog = Scan(factory.get(), root, nullptr);
+	Publish(catalog);
+
+	HANDLE rawDirectory = CreateFileW(root.c_str(), FILE_LIST_DIRECTORY,
+		FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+		FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+	if (rawDirectory == INVALID_HANDLE_VALUE) return;
+	HandleWrapper directory(rawDirectory, true);
+	HandleWrapper ioEvent(CreateEventW(nullptr, TRUE, FALSE, nullptr), true);
+	if (!ioEvent.isValid()) return;
+
+	// Notifications only trigger a rescan; the file stamps decide what is decoded again
+	std::vector<DWORD> changes(Configuration::SKIN_PACK_CHANGE_BUFFER / sizeof(DWORD));
+	const DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME |
+		FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE;
+	HANDLE waits[2] = { m_stopEvent.get(), ioEvent.get() };
+	for (;;) {
+		OVERLAPPED overlapped = {};
+		overlapped.hEvent = ioEvent.get();
+		ResetEvent(ioEvent.get());
+		if (!ReadDirectoryChangesW(directory.get(), changes.data(), static_cast<DWORD>(changes.size() * sizeof(DWORD)),
+			TRUE, filter, nullptr, &overlapped, nullptr)) {
+			return;
+		}
+		DWORD transferred = 0;
+		if (WaitForMultipleObjects(2, waits, FALSE, INFINITE) != WAIT_OBJECT_0 + 1) {
+			CancelIoEx(directory.get(), &overlapped);
+			GetOverlappedResult(directory.get(), &overlapped, &transferred, TRUE);
+			return;
+		}
+		// An overflowed buffer completes with nothing transferred; the rescan covers it either way
+		GetOverlappedResult(directory.get(), &overlapped, &transferred, FALSE);
+
+		// Editors save in bursts (truncate, write, rename); let the folder settle first
+		if (WaitForSingleObject(m_stopEvent.get(), Configuration::SKIN_PACK_SETTLE_DELAY) != WAIT_TIMEOUT) return;
+
+		std::shared_ptr<const SkinPackCatalog> next = Scan(factory.get(), root, catalog.get());
+		if (WaitForSingleObject(m_stopEvent.get(), 0) != WAIT_TIMEOUT) return;
+		if (IsSameCatalog(*next, *catalog)) continue;
+		catalog = std::move(next);
+		Publish(catalog);
+	}
+}
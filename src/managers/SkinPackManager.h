@@ -0,0 +1,41 @@
+#pragma once
+#include <windows.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "../utils/SkinPacks.h"
+#include "../utils/RAII/Handle.h"
+
+class BongoCatApp;
+struct IWICImagingFactory;
+
+// Skin packs from disk (folders of PNGs or .bcskin files): scanned, decoded and watched on a worker thread.
+// Each rescan publishes an immutable catalog; the UI thread adopts it on WM_APP_SKIN_PACKS.
+class SkinPackManager {
+private:
+	BongoCatApp* m_app;
+	HWND m_targetWindow;
+	HandleWrapper m_stopEvent;
+	std::thread m_worker;
+
+	std::mutex m_mutex;
+	std::shared_ptr<const SkinPackCatalog> m_pending; // guarded by m_mutex
+
+	// Worker thread
+	void WatchLoop();
+	std::shared_ptr<const SkinPackCatalog> Scan(IWICImagingFactory* factory, const std::wstring& root,
+		const SkinPackCatalog* previous) const;
+	void Publish(std::shared_ptr<const SkinPackCatalog> catalog);
+
+public:
+	SkinPackManager(BongoCatApp* app);
+	~SkinPackManager();
+
+	// Initialization and cleanup
+	bool Initialize();
+	void Shutdown();
+
+	// Latest published catalog, or nullptr if it was already taken (UI thread)
+	std::shared_ptr<const SkinPackCatalog> TakeCatalog();
+};
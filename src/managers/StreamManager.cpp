@@ -0,0 +1,163 @@
+#include "StreamManager.h"
+#include "ImageManager.h"
+#include "../app/BongoCatApp.h"
+#include "../utils/Configuration.h"
+#include "../utils/PixelConvert.h"
+#include "../utils/OutputTarget.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+	constexpr char Y4M_FRAME_TAG[] = "FRAME\n";
+	constexpr size_t Y4M_FRAME_TAG_SIZE = sizeof(Y4M_FRAME_TAG) - 1;
+	constexpr LONGLONG HUNDRED_NS_PER_SECOND = 10000000;
+
+	// QPC ticks to 100 ns units without overflowing on long uptimes
+	LONGLONG TicksTo100ns(LONGLONG ticks, LONGLONG frequency) {
+		return (ticks / frequency) * HUNDRED_NS_PER_SECOND + (ticks % frequency) * HUNDRED_NS_PER_SECOND / frequency;
+	}
+}
+
+StreamManager::StreamManager(BongoCatApp* app, const LaunchOptions& options)
+	: m_app(app)
+	, m_target(options.streamTarget)
+	, m_format(options.streamFormat)
+	, m_fps(options.streamFps > 0 ? options.streamFps : Configuration::STREAM_DEFAULT_FPS)
+	, m_currentFrame(0) {
+}
+
+StreamManager::~StreamManager() {
+	Shutdown();
+}
+
+bool StreamManager::Initialize() {
+	if (!m_app || m_target.empty()) return false;
+
+	if (m_format == StreamFormat::Y4m) {
+		char header[128] = { 0 };
+		snprintf(header, sizeof(header), "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n",
+			Configuration::IMAGE_WIDTH, Configuration::IMAGE_HEIGHT, m_fps);
+		m_header = header;
+	}
+
+	OnImagesChanged();
+
+	m_stopEvent = HandleWrapper(CreateEventW(nullptr, TRUE, FALSE, nullptr), true);
+	if (!m_stopEvent.isValid()) return false;
+
+	m_worker = std::thread(&StreamManager::StreamLoop, this);
+	return true;
+}
+
+void StreamManager::Shutdown() {
+	if (!m_worker.joinable()) return;
+	SetEvent(m_stopEvent.get());
+
+	// A blocking connect or write to a stalled reader only returns when cancelled
+	HANDLE worker = m_worker.native_handle();
+	while (WaitForSingleObject(worker, Configuration::STREAM_CANCEL_RETRY_DELAY) == WAIT_TIMEOUT) {
+		CancelSynchronousIo(worker);
+	}
+	m_worker.join();
+	m_stopEvent = HandleWrapper();
+}
+
+void StreamManager::OnImagesChanged() {
+	std::shared_ptr<const FrameSet> frames = EncodeFrames();
+	std::lock_guard<std::mutex> lock(m_framesMutex);
+	m_frames = std::move(frames);
+}
+
+std::shared_ptr<const StreamManager::FrameSet> StreamManager::EncodeFrames() const {
+	auto frames = std::make_shared<FrameSet>();
+	ImageManager* images = m_app ? m_app->GetImageManager() : nullptr;
+	if (!images) return frames;
+
+	const int width = Configuration::IMAGE_WIDTH;
+	const int height = Configuration::IMAGE_HEIGHT;
+	const size_t pixelCount = static_cast<size_t>(width) * height;
+
+	GdiFlush();
+	for (int i = 0; i < images->GetImageCount(); ++i) {
+		const BYTE* pixels = images->GetImagePixels(i);
+		if (!pixels) return std::make_shared<FrameSet>();
+
+		std::vector<BYTE> record;
+		if (m_format == StreamFormat::Bgra) {
+			record.assign(pixels, pixels + pixelCount * Configuration::BYTES_PER_PIXEL);
+		}
+		else {
+			record.resize(Y4M_FRAME_TAG_SIZE + pixelCount + pixelCount / 2);
+			memcpy(record.data(), Y4M_FRAME_TAG, Y4M_FRAME_TAG_SIZE);
+			BYTE* yPlane = record.data() + Y4M_FRAME_TAG_SIZE;
+			BYTE* uPlane = yPlane + pixelCount;
+			BYTE* vPlane = uPlane + pixelCount / 4;
+			PixelConvert::BgraToI420(pixels, width, height, width * Configuration::BYTES_PER_PIXEL, yPlane, uPlane, vPlane);
+		}
+		frames->records.push_back(std::move(record));
+	}
+	return frames;
+}
+
+void StreamManager::StreamLoop() {
+	HandleWrapper timer;
+#ifdef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+	timer = HandleWrapper(CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS), true);
+#endif
+	if (!timer.isValid()) {
+		timer = HandleWrapper(CreateWaitableTimerW(nullptr, FALSE, nullptr), true);
+	}
+	if (!timer.isValid()) return;
+
+	HandleWrapper output = OutputTarget::Open(m_target, Configuration::STREAM_PIPE_BUFFER_SIZE);
+	if (!output.isValid()) return;
+
+	if (!OutputTarget::IsPipe(m_target)) {
+		StreamTo(output.get(), timer.get());
+		return;
+	}
+
+	// Served pipe: stream to one reader at a time until shutdown
+	while (WaitForSingleObject(m_stopEvent.get(), 0) == WAIT_TIMEOUT) {
+		if (!OutputTarget::WaitForReader(output.get())) return;
+		StreamTo(output.get(), timer.get());
+		DisconnectNamedPipe(output.get());
+	}
+}
+
+bool StreamManager::StreamTo(HANDLE output, HANDLE timer) {
+	if (!m_header.empty() && !OutputTarget::WriteAll(output, m_header.data(), m_header.size())) return false;
+
+	LARGE_INTEGER frequency = {};
+	LARGE_INTEGER start = {};
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&start);
+	const LONGLONG period = HUNDRED_NS_PER_SECOND / m_fps;
+	HANDLE waits[2] = { m_stopEvent.get(), timer };
+
+	for (LONGLONG frame = 1;; ++frame) {
+		std::shared_ptr<const FrameSet> frames;
+		{
+			std::lock_guard<std::mutex> lock(m_framesMutex);
+			frames = m_frames;
+		}
+		if (frames && !frames->records.empty()) {
+			int index = m_currentFrame.load(std::memory_order_relaxed);
+			if (index < 0 || index >= static_cast<int>(frames->records.size())) index = 0;
+			const std::vector<BYTE>& record = frames->records[index];
+			if (!OutputTarget::WriteAll(output, record.data(), record.size())) return false;
+		}
+
+		// Absolute schedule keeps the rate exact; a stalled reader drops frames instead of bursting
+		LARGE_INTEGER now = {};
+		QueryPerformanceCounter(&now);
+		const LONGLONG elapsed = TicksTo100ns(now.QuadPart - start.QuadPart, frequency.QuadPart);
+		if (frame * period <= elapsed) {
+			frame = elapsed / period + 1;
+		}
+		LARGE_INTEGER dueTime = {};
+		dueTime.QuadPart = -(frame * period - elapsed); // negative: relative
+		if (!SetWaitableTimer(timer, &dueTime, 0, nullptr, nullptr, FALSE)) return false;
+		if (WaitForMultipleObjects(2, waits, FALSE, INFINITE) != WAIT_OBJECT_0 + 1) return false;
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <windows.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../app/LaunchOptions.h"
+#include "../utils/RAII/Handle.h"
+
+class BongoCatApp;
+
+// Fixed-rate raw video of the cat (Y4M or BGRA) to stdout, a file or a served pipe.
+// Frames are encoded once per skin; each tick is a single write of a cached record.
+class StreamManager {
+private:
+	// Immutable per-skin encoding, shared with the worker
+	struct FrameSet {
+		std::vector<std::vector<BYTE>> records; // one complete record per image
+	};
+
+	BongoCatApp* m_app;
+	std::wstring m_target;
+	StreamFormat m_format;
+	int m_fps;
+	std::string m_header;
+
+	std::mutex m_framesMutex;
+	std::shared_ptr<const FrameSet> m_frames;
+	std::atomic<int> m_currentFrame;
+
+	HandleWrapper m_stopEvent;
+	std::thread m_worker;
+
+	// Encoding (UI thread)
+	std::shared_ptr<const FrameSet> EncodeFrames() const;
+
+	// Worker thread
+	void StreamLoop();
+	bool StreamTo(HANDLE output, HANDLE timer);
+
+public:
+	StreamManager(BongoCatApp* app, const LaunchOptions& options);
+	~StreamManager();
+
+	// Initialization and cleanup
+	bool Initialize();
+	void Shutdown();
+
+	// UI thread notifications
+	void OnImagesChanged();
+	void SetCurrentFrame(int index) noexcept { m_currentFrame.store(index, std::memory_order_relaxed); }
+};
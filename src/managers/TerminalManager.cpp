@@ -0,0 +1,196 @@
+#include "TerminalManager.h"
+#include "ImageManager.h"
+#include "../app/BongoCatApp.h"
+#include "../utils/Configuration.h"
+#include "../utils/OutputTarget.h"
+#include "../utils/Resampler.h"
+#include "../utils/TerminalArt.h"
+
+TerminalManager::TerminalManager(BongoCatApp* app, const LaunchOptions& options)
+	: m_app(app)
+	, m_target(options.terminalTarget)
+	, m_columns(options.terminalColumns > 0 ? options.terminalColumns : Configuration::TERMINAL_DEFAULT_COLUMNS)
+	, m_currentFrame(0) {
+}
+
+TerminalManager::~TerminalManager() {
+	Shutdown();
+}
+
+bool TerminalManager::Initialize() {
+	if (!m_app || m_target.empty()) return false;
+
+	// Opened before encoding: a console narrower than the grid would wrap every row
+	m_output = OpenOutput();
+	if (!m_output.isValid()) return false;
+	CONSOLE_SCREEN_BUFFER_INFO info = {};
+	if (m_console.isValid() && GetConsoleScreenBufferInfo(m_console.get(), &info) && info.dwSize.X - 1 < m_columns) {
+		// One column spare so a full row never leaves the cursor waiting to wrap
+		m_columns = info.dwSize.X - 1 > Configuration::TERMINAL_MIN_COLUMNS ? info.dwSize.X - 1 : Configuration::TERMINAL_MIN_COLUMNS;
+	}
+
+	OnImagesChanged();
+
+	m_stopEvent = HandleWrapper(CreateEventW(nullptr, TRUE, FALSE, nullptr), true);
+	m_changedEvent = HandleWrapper(CreateEventW(nullptr, FALSE, FALSE, nullptr), true);
+	if (!m_stopEvent.isValid() || !m_changedEvent.isValid()) {
+		RestoreConsole();
+		m_output = HandleWrapper();
+		return false;
+	}
+
+	m_worker = std::thread(&TerminalManager::RenderLoop, this);
+	return true;
+}
+
+void TerminalManager::Shutdown() {
+	if (!m_worker.joinable()) {
+		RestoreConsole();
+		m_output = HandleWrapper();
+		return;
+	}
+	SetEvent(m_stopEvent.get());
+
+	// A blocking connect or write to a stalled reader only returns when cancelled
+	HANDLE worker = m_worker.native_handle();
+	while (WaitForSingleObject(worker, Configuration::STREAM_CANCEL_RETRY_DELAY) == WAIT_TIMEOUT) {
+		CancelSynchronousIo(worker);
+	}
+	m_worker.join();
+	m_output = HandleWrapper();
+	m_stopEvent = HandleWrapper();
+	m_changedEvent = HandleWrapper();
+}
+
+void TerminalManager::OnImagesChanged() {
+	std::shared_ptr<const FrameSet> frames = EncodeFrames();
+	{
+		std::lock_guard<std::mutex> lock(m_framesMutex);
+		m_frames = std::move(frames);
+	}
+	if (m_changedEvent.isValid()) SetEvent(m_changedEvent.get());
+}
+
+void TerminalManager::SetCurrentFrame(int index) noexcept {
+	if (m_currentFrame.exchange(index, std::memory_order_relaxed) != index && m_changedEvent.isValid()) {
+		SetEvent(m_changedEvent.get());
+	}
+}
+
+std::shared_ptr<const TerminalManager::FrameSet> TerminalManager::EncodeFrames() const {
+	auto frames = std::make_shared<FrameSet>();
+	ImageManager* images = m_app ? m_app->GetImageManager() : nullptr;
+	if (!images) return frames;
+
+	// Nearest keeps the art's flat colors, so neighboring cells share SGR state and diffs stay small
+	const int width = m_columns;
+	const int height = MulDiv(width, Configuration::IMAGE_HEIGHT, Configuration::IMAGE_WIDTH);
+	std::vector<uint8_t> scaled(static_cast<size_t>(width) * height * Configuration::BYTES_PER_PIXEL);
+	std::vector<TerminalArt::Grid> grids;
+
+	GdiFlush();
+	for (int i = 0; i < images->GetImageCount(); ++i) {
+		const BYTE* pixels = images->GetImagePixels(i);
+		if (!pixels) return std::make_shared<FrameSet>();
+		Resampler::Resize(pixels, Configuration::IMAGE_WIDTH, Configuration::IMAGE_HEIGHT, Configuration::IMAGE_WIDTH * Configuration::BYTES_PER_PIXEL,
+			scaled.data(), width, height, width * Configuration::BYTES_PER_PIXEL, Resampler::Filter::Nearest);
+		grids.push_back(TerminalArt::FromPixels(scaled.data(), width, height));
+	}
+
+	frames->count = static_cast<int>(grids.size());
+	frames->paints.resize(grids.size());
+	frames->transitions.resize(grids.size() * grids.size());
+	for (size_t from = 0; from < grids.size(); ++from) {
+		TerminalArt::AppendPaint(grids[from], frames->paints[from]);
+		for (size_t to = 0; to < grids.size(); ++to) {
+			if (from == to) continue;
+			TerminalArt::AppendDiff(grids[from], grids[to], frames->transitions[from * grids.size() + to]);
+		}
+	}
+	return frames;
+}
+
+HandleWrapper TerminalManager::OpenOutput() {
+	if (m_target != L"-") {
+		return OutputTarget::Open(m_target, Configuration::TERMINAL_PIPE_BUFFER_SIZE);
+	}
+	HandleWrapper output = OutputTarget::Open(m_target, Configuration::TERMINAL_PIPE_BUFFER_SIZE);
+	if (!output.isValid()) {
+		// A GUI-subsystem process started from a console has no stdout of its own; borrow the console
+		AttachConsole(ATTACH_PARENT_PROCESS);
+		HANDLE console = CreateFileW(L"CONOUT$", GENERIC_READ | GENERIC_WRITE, FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr);
+		if (console == INVALID_HANDLE_VALUE) return HandleWrapper();
+		output = HandleWrapper(console, true);
+	}
+	// Consoles interpret VT sequences and take UTF-8 bytes only when asked to
+	DWORD mode = 0;
+	if (GetConsoleMode(output.get(), &mode)) {
+		if (!SetConsoleMode(output.get(), mode | ENABLE_PROCESSED_OUTPUT | ENABLE_VIRTUAL_TERMINAL_PROCESSING)) return HandleWrapper();
+		m_console = HandleWrapper(output.get(), false);
+		m_consoleMode = mode;
+		m_consoleCodePage = GetConsoleOutputCP();
+		SetConsoleOutputCP(CP_UTF8);
+	}
+	return output;
+}
+
+void TerminalManager::RestoreConsole() {
+	if (!m_console.isValid()) return;
+	SetConsoleMode(m_console.get(), m_consoleMode);
+	if (m_consoleCodePage) SetConsoleOutputCP(m_consoleCodePage);
+	m_console = HandleWrapper();
+}
+
+void TerminalManager::RenderLoop() {
+	const HandleWrapper& output = m_output;
+	if (!OutputTarget::IsPipe(m_target)) {
+		DrawTo(output.get());
+		RestoreConsole();
+		return;
+	}
+
+	// Served pipe: each reader gets a full paint, then diffs, until shutdown
+	while (WaitForSingleObject(m_stopEvent.get(), 0) == WAIT_TIMEOUT) {
+		if (!OutputTarget::WaitForReader(output.get())) return;
+		DrawTo(output.get());
+		DisconnectNamedPipe(output.get());
+	}
+}
+
+bool TerminalManager::DrawTo(HANDLE output) {
+	std::string enter;
+	TerminalArt::AppendEnter(enter);
+	if (!OutputTarget::WriteAll(output, enter.data(), enter.size())) return false;
+
+	std::shared_ptr<const FrameSet> shown;
+	int shownIndex = -1;
+	HANDLE waits[2] = { m_stopEvent.get(), m_changedEvent.get() };
+	for (;;) {
+		std::shared_ptr<const FrameSet> frames;
+		{
+			std::lock_guard<std::mutex> lock(m_framesMutex);
+			frames = m_frames;
+		}
+		if (frames && frames->count > 0) {
+			int index = m_currentFrame.load(std::memory_order_relaxed);
+			if (index < 0 || index >= frames->count) index = 0;
+			// Bursts coalesce: only the newest frame is drawn, straight from whatever is on screen
+			const std::string* bytes = nullptr;
+			if (frames != shown) {
+				bytes = &frames->paints[index];
+			}
+			else if (index != shownIndex) {
+				bytes = &frames->transitions[static_cast<size_t>(shownIndex) * frames->count + index];
+			}
+			if (bytes && !OutputTarget::WriteAll(output, bytes->data(), bytes->size())) return false;
+			shown = frames;
+			shownIndex = index;
+		}
+
+		if (WaitForMultipleObjects(2, waits, FALSE, INFINITE) != WAIT_OBJECT_0 + 1) break;
+	}
+
+	std::string leave;
+	TerminalArt::AppendLeave(leave);
+	return OutputTarget::WriteAll(output, leave.data(), leave.size());
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <windows.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../app/LaunchOptions.h"
+#include "../utils/RAII/Handle.h"
+
+class BongoCatApp;
+
+// The cat drawn as VT text (half blocks, 24-bit color) on a console, a pipe or a file.
+// Every frame's full paint and every frame-to-frame diff are encoded once per skin; a frame
+// change is a single write of the precomputed diff.
+class TerminalManager {
+private:
+	// Immutable per-skin encoding, shared with the worker
+	struct FrameSet {
+		int count = 0;
+		std::vector<std::string> paints;      // clear and draw, per frame
+		std::vector<std::string> transitions; // [from * count + to]; empty on the diagonal
+	};
+
+	BongoCatApp* m_app;
+	std::wstring m_target;
+	int m_columns;
+
+	std::mutex m_framesMutex;
+	std::shared_ptr<const FrameSet> m_frames;
+	std::atomic<int> m_currentFrame;
+
+	HandleWrapper m_stopEvent;
+	HandleWrapper m_changedEvent; // auto-reset; new frame or new frame set
+	std::thread m_worker;
+
+	// Opened on the UI thread before the worker starts; the worker owns it from then on
+	HandleWrapper m_output;
+	// Console output (target "-" without a redirected stdout)
+	HandleWrapper m_console;
+	DWORD m_consoleMode = 0;
+	UINT m_consoleCodePage = 0;
+
+	// UI thread
+	std::shared_ptr<const FrameSet> EncodeFrames() const;
+	HandleWrapper OpenOutput();
+
+	// Worker thread (and UI thread when no worker runs)
+	void RestoreConsole();
+	void RenderLoop();
+	bool DrawTo(HANDLE output);
+
+public:
+	TerminalManager(BongoCatApp* app, const LaunchOptions& options);
+	~TerminalManager();
+
+	// Initialization and cleanup
+	bool Initialize();
+	void Shutdown();
+
+	// UI thread notifications
+	void OnImagesChanged();
+	void SetCurrentFrame(int index) noexcept;
+};
@@ -1,4 +1,5 @@
 #include "WindowManager.h"
+#include <wtsapi32.h>
 #include "../app/BongoCatApp.h"
 #include "../utils/RAII/Window.h"
 #include "../utils/RAII/Gdi.h"
@@ -8,7 +9,13 @@
 #include "../utils/SettingsService.h"
 #include "../utils/ValidationUtils.h"
 #include "../utils/SkinPresentation.h"
+#include "../utils/SkinPacks.h"
 #include "../utils/SkinService.h"
+#include "../utils/HeatmapService.h"
+#include "InputManager.h"
+#include "ImageManager.h"
+#include "../utils/Metrics.h"
+#include "../utils/Trace.h"
 #include "../utils/Configuration.h"
 #include "../utils/Localization.h"
 // Resource.h is supplied by the build system include paths
@@ -23,6 +30,60 @@
 // Global WndProc
 extern LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam);
 
+namespace {
+	// WinEvent callbacks carry no context; one window manager owns presence tracking
+	WindowManager* g_presenceOwner = nullptr;
+
+	// Color menu entries; hue presets share one name format
+	struct TintPreset {
+		ColorTransform::Tint tint;
+		UINT nameId;
+		const wchar_t* fallbackName;
+	};
+	const TintPreset TINT_PRESETS[] = {
+		{ { 0, 100, ColorTransform::PALETTE_NONE }, IDS_TINT_ORIGINAL, L"Original" },
+		{ { 60, 100, ColorTransform::PALETTE_NONE }, IDS_TINT_HUE_FORMAT, L"Hue %+d\u00B0" },
+		{ { 120, 100, ColorTransform::PALETTE_NONE }, IDS_TINT_HUE_FORMAT, L"Hue %+d\u00B0" },
+		{ { 180, 100, ColorTransform::PALETTE_NONE }, IDS_TINT_HUE_FORMAT, L"Hue %+d\u00B0" },
+		{ { -120, 100, ColorTransform::PALETTE_NONE }, IDS_TINT_HUE_FORMAT, L"Hue %+d\u00B0" },
+		{ { -60, 100, ColorTransform::PALETTE_NONE }, IDS_TINT_HUE_FORMAT, L"Hue %+d\u00B0" },
+		{ { 0, 160, ColorTransform::PALETTE_NONE }, IDS_TINT_VIVID, L"Vivid" },
+		{ { 0, 50, ColorTransform::PALETTE_NONE }, IDS_TINT_PASTEL, L"Pastel" },
+		{ { 0, 0, ColorTransform::PALETTE_NONE }, IDS_TINT_GRAYSCALE, L"Grayscale" },
+		{ { 0, 100, ColorTransform::PALETTE_SEPIA }, IDS_TINT_SEPIA, L"Sepia" },
+		{ { 0, 100, ColorTransform::PALETTE_MIDNIGHT }, IDS_TINT_MIDNIGHT, L"Midnight" }
+	};
+	constexpr int TINT_PRESET_COUNT = static_cast<int>(sizeof(TINT_PRESETS) / sizeof(TINT_PRESETS[0]));
+
+	// Localized menu entry with an English fallback
+	struct MenuEntry {
+		UINT nameId;
+		const wchar_t* fallbackName;
+	};
+
+	// Outline menu entries, indexed by FrameOutline style
+	const MenuEntry OUTLINE_ITEMS[FrameOutline::STYLE_COUNT] = {
+		{ IDS_OUTLINE_NONE, L"None" },
+		{ IDS_OUTLINE_LINE, L"Line" },
+		{ IDS_OUTLINE_SHADOW, L"Drop shadow" }
+	};
+
+	// Click counter menu entries, indexed by Configuration::COUNTER_* mode
+	const MenuEntry COUNTER_ITEMS[Configuration::COUNTER_MODE_COUNT] = {
+		{ IDS_COUNTER_OFF, L"Off" },
+		{ IDS_COUNTER_TOTAL, L"Total" },
+		{ IDS_COUNTER_SESSION, L"This session" }
+	};
+
+	void CALLBACK ForegroundEventProc(HWINEVENTHOOK, DWORD event, HWND, LONG, LONG, DWORD, DWORD) {
+		if (!g_presenceOwner) return;
+		// Keyups sent to another desktop never reach the hook; focus changes are left to the
+		// GetAsyncKeyState check on the next keydown
+		if (event == EVENT_SYSTEM_DESKTOPSWITCH) g_presenceOwner->ClearHeldKeys();
+		g_presenceOwner->UpdatePresence();
+	}
+}
+
 WindowManager::WindowManager(BongoCatApp* app)
 	: m_app(app) {
 }
@@ -90,6 +151,13 @@ bool WindowManager::InitializeWindow() {
 
 	// Initialize timers
 	if (!InitializeTimers()) return false;
+	StartPresenceTracking();
+	StartPowerTracking();
+	m_presentScheduler.Start(m_app->GetMainWindow());
+
+	// Size for the monitor the window opened on
+	m_dpi = GetDpiForWindow(m_app->GetMainWindow());
+	ApplyScale();
 
 	::ShowWindow(m_app->GetMainWindow(), SW_SHOW);
 	m_app->RedrawCurrentImage();
@@ -116,6 +184,9 @@ bool WindowManager::Initialize() {
 void WindowManager::Shutdown() {
 	// Ensure timers are stopped before destroying the window
 	StopAnimationTimers();
+	StopPresenceTracking();
+	StopPowerTracking();
+	m_presentScheduler.Stop();
 	if (m_mainWindow.get()) {
 		DestroyWindow(m_mainWindow.get());
 		m_mainWindow = WindowWrapper();
@@ -132,17 +203,30 @@ void WindowManager::Shutdown() {
 
 LRESULT WindowManager::WindowProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam) {
 	switch (message) {
-	case Configuration::WM_APP_INPUT_EVENT:
-		OnInputEvent();
+	case Configuration::WM_APP_INPUT_EVENT: {
+		PawSide side = PawSide::Any;
+		InputTiming timing;
+		InputManager::DecodeInputEvent(wParam, lParam, side, timing);
+		OnInputEvent(side, timing);
+		break;
+	}
+
+	case Configuration::WM_APP_PRESENT:
+		m_presentScheduler.OnPaced();
+		if (m_app) m_app->RedrawCurrentImage();
 		break;
 
 	case Configuration::WM_TRAYICON:
 		OnTrayIcon(lParam);
 		break;
 
-	case Configuration::WM_APP_SHOW_APP:
-		// Use our app-visible method so timers/state are restored properly
-		SetVisible(true);
+	case Configuration::WM_APP_SKIN_PACKS:
+		if (m_app) m_app->OnSkinPacksChanged();
+		break;
+
+	case Configuration::WM_APP_CONTROL:
+		// Sent synchronously by the control channel worker
+		OnControlBatch(reinterpret_cast<ControlCall*>(lParam), static_cast<size_t>(wParam));
 		break;
 
 	case WM_COMMAND:
@@ -153,29 +237,54 @@ LRESULT WindowManager::WindowProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM
 		return HTCAPTION;
 
 	case WM_TIMER:
+		METRIC_INC(TimerFires);
 		OnTimer(wParam);
 		break;
 
+	case WM_WTSSESSION_CHANGE:
+		if (wParam == WTS_SESSION_LOCK || wParam == WTS_SESSION_UNLOCK) {
+			// Keys released on the secure desktop (Win+L) would otherwise stay down
+			ClearHeldKeys();
+			m_sessionLocked = (wParam == WTS_SESSION_LOCK);
+			UpdatePresence();
+		}
+		break;
+
+	case WM_DISPLAYCHANGE:
+		UpdatePresence();
+		break;
+
+	case WM_DPICHANGED:
+		// Moved to a monitor with another scale: keep the suggested position, use our own size
+		m_dpi = HIWORD(wParam);
+		if (ApplyScale(reinterpret_cast<const RECT*>(lParam)) && m_app) {
+			m_app->RedrawCurrentImage();
+		}
+		break;
+
+	case WM_POWERBROADCAST:
+		if (wParam == PBT_POWERSETTINGCHANGE) {
+			OnPowerSettingChange(reinterpret_cast<const POWERBROADCAST_SETTING*>(lParam));
+		}
+		return TRUE;
+
 	case WM_EXITSIZEMOVE: {
-		// Persist position after move
+		// Persist position after move; the cat may now share a monitor with a fullscreen app
 		PersistWindowPosition();
+		UpdatePresence();
 		break;
 	}
 
 	case WM_QUERYENDSESSION:
 		// Persist on shutdown/logoff
 		PersistWindowPosition();
-		if (m_app && m_app->GetState()) {
-			SettingsService::WriteClickCount(m_app->GetState()->GetClickCount());
-		}
+		PersistCounters();
 		return TRUE;
 
 	case WM_ENDSESSION:
 		if (wParam) { // session is ending
 			PersistWindowPosition();
-			if (m_app && m_app->GetState()) {
-				SettingsService::WriteClickCount(m_app->GetState()->GetClickCount());
-			}
+			PersistCounters();
 		}
 		break;
 
@@ -202,11 +311,18 @@ void WindowManager::SetVisible(bool show) {
 
 	// Timers by visibility
 	if (show) {
+		if (m_releaseImagesTimer) m_releaseImagesTimer->Kill();
+		RestoreImages();
 		EnsureBlinkTimerRunning();
 		StopImageSwitchTimer();
+		if (m_topmostTimer && !m_topmostTimer->IsActive() && !m_app->GetState()->IsOccluded()) {
+			m_topmostTimer->Set(Configuration::TOPMOST_TIMER_DELAY);
+		}
 	}
 	else {
+		// Input is counted on the hook path while hidden; only the release timer stays armed
 		StopAnimationTimers();
+		if (m_releaseImagesTimer) m_releaseImagesTimer->Set(Configuration::IMAGE_RELEASE_GRACE);
 	}
 
 	// Reassert topmost when showing
@@ -229,21 +345,32 @@ HWND WindowManager::GetMainWindow() const {
 	return m_app ? m_app->GetMainWindow() : nullptr;
 }
 
-void WindowManager::OnInputEvent() {
+void WindowManager::OnInputEvent(PawSide side, const InputTiming& timing) {
 	if (m_app) {
-		m_app->OnInputEvent();
+		m_app->OnInputEvent(side, timing);
 	}
 }
 
 void WindowManager::OnTimer(UINT_PTR timerId) {
+	TRACE_SCOPE("OnTimer");
 	if (!m_app) return;
 	if (timerId == Configuration::ID_BLINK_TIMER) {
 		m_app->HandleStateEventAndRedraw(StateEvent::BlinkTimerExpired);
-		StartImageSwitchTimer(Configuration::BLINK_DELAY);
+		StartImageSwitchTimer(CurrentPolicy().blinkDelay);
 	}
 	else if (timerId == Configuration::ID_IMAGE_SWITCH_TIMER) {
 		m_app->HandleStateEventAndRedraw(StateEvent::TimerExpired);
 	}
+	else if (timerId == Configuration::ID_RELEASE_IMAGES_TIMER) {
+		// One-shot
+		if (m_releaseImagesTimer) m_releaseImagesTimer->Kill();
+		if (m_app->GetState() && !m_app->GetState()->IsVisible()) {
+			ReleaseImages();
+		}
+	}
+	else if (timerId == Configuration::ID_PRESENCE_TIMER) {
+		UpdatePresence();
+	}
 	else if (timerId == Configuration::ID_TOPMOST_TIMER) {
 		if (m_app->GetMainWindow()) {
 			SetWindowPos(m_app->GetMainWindow(), HWND_TOPMOST, 0, 0, 0, 0,
@@ -264,6 +391,19 @@ void WindowManager::OnTrayIcon(LPARAM lParam) {
 		if (clicksFormat.empty()) clicksFormat = L"Clicks: %d";
 		std::wstring clicksText = Localization::FormatWide(clicksFormat.c_str(), m_app->GetState()->GetClickCount());
 		AppendMenuW(menu.get(), MF_STRING | MF_GRAYED, Configuration::ID_TRAY_CLICKS, clicksText.c_str());
+		// Odometer totals are sampled here, so the UI reads them at most once per menu open
+		std::wstring mouseFormat = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRAY_MOUSE_STATS_FORMAT);
+		if (mouseFormat.empty()) mouseFormat = L"Mouse: %.1f m, %llu scrolls";
+		const MouseOdometer& odometer = m_app->GetState()->GetMouseOdometer();
+		std::wstring mouseText = Localization::FormatWide(mouseFormat.c_str(),
+			PixelsToMeters(odometer.GetDistancePixels()), static_cast<unsigned long long>(odometer.GetWheelNotches()));
+		AppendMenuW(menu.get(), MF_STRING | MF_GRAYED, Configuration::ID_TRAY_MOUSE_STATS, mouseText.c_str());
+		std::wstring latencyFormat = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRAY_LATENCY_FORMAT);
+		if (latencyFormat.empty()) latencyFormat = L"Input latency: %.1f / %.1f / %.1f ms";
+		const LatencyHistogram& latency = m_app->GetState()->GetLatency().Get(LatencyStage::InputToPresent);
+		std::wstring latencyText = Localization::FormatWide(latencyFormat.c_str(),
+			latency.GetPercentile(0.5) / 1000.0, latency.GetPercentile(0.99) / 1000.0, latency.GetPercentile(0.999) / 1000.0);
+		AppendMenuW(menu.get(), MF_STRING | MF_GRAYED, Configuration::ID_TRAY_LATENCY, latencyText.c_str());
 		AppendMenuW(menu.get(), MF_SEPARATOR, 0, nullptr);
 		bool isVisible = IsWindowVisible();
 		std::wstring showText = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRAY_SHOW);
@@ -274,14 +414,52 @@ void WindowManager::OnTrayIcon(LPARAM lParam) {
 		std::wstring resetPosText = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRAY_RESET_POSITION);
 		if (resetPosText.empty()) resetPosText = L"Reset position";
 		AppendMenuW(menu.get(), MF_STRING, Configuration::ID_TRAY_RESET_POSITION, resetPosText.c_str());
+		std::wstring heatmapText = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRAY_EXPORT_HEATMAP);
+		if (heatmapText.empty()) heatmapText = L"Export key heatmap";
+		AppendMenuW(menu.get(), MF_STRING, Configuration::ID_TRAY_EXPORT_HEATMAP, heatmapText.c_str());
+#if BONGOCAT_TRACING
+		std::wstring traceText = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRAY_SAVE_TRACE);
+		if (traceText.empty()) traceText = L"Save performance trace";
+		AppendMenuW(menu.get(), MF_STRING, Configuration::ID_TRAY_SAVE_TRACE, traceText.c_str());
+#endif
 		MenuWrapper skinMenu(CreateSkinMenu(), false);
 		std::wstring skinsText = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRAY_SKINS);
 		if (skinsText.empty()) skinsText = L"Skins";
 		AppendMenuW(menu.get(), MF_POPUP, (UINT_PTR)skinMenu.get(), skinsText.c_str());
+		if (SkinPacks::AccessoryCount() > 0) {
+			MenuWrapper accessoryMenu(CreateAccessoryMenu(), false);
+			std::wstring accessoriesText = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRAY_ACCESSORIES);
+			if (accessoriesText.empty()) accessoriesText = L"Accessories";
+			AppendMenuW(menu.get(), MF_POPUP, (UINT_PTR)accessoryMenu.get(), accessoriesText.c_str());
+		}
+		MenuWrapper colorMenu(CreateColorMenu(), false);
+		std::wstring colorText = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRAY_COLOR);
+		if (colorText.empty()) colorText = L"Color";
+		AppendMenuW(menu.get(), MF_POPUP, (UINT_PTR)colorMenu.get(), colorText.c_str());
+		MenuWrapper outlineMenu(CreateOutlineMenu(), false);
+		std::wstring outlineText = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRAY_OUTLINE);
+		if (outlineText.empty()) outlineText = L"Outline";
+		AppendMenuW(menu.get(), MF_POPUP, (UINT_PTR)outlineMenu.get(), outlineText.c_str());
+		MenuWrapper counterMenu(CreateCounterMenu(), false);
+		std::wstring counterText = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRAY_COUNTER);
+		if (counterText.empty()) counterText = L"Click counter";
+		AppendMenuW(menu.get(), MF_POPUP, (UINT_PTR)counterMenu.get(), counterText.c_str());
+		MenuWrapper sizeMenu(CreateSizeMenu(), false);
+		std::wstring sizeText = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRAY_SIZE);
+		if (sizeText.empty()) sizeText = L"Size";
+		AppendMenuW(menu.get(), MF_POPUP, (UINT_PTR)sizeMenu.get(), sizeText.c_str());
 		bool startup = RegistryUtils::ValueExists(HKEY_CURRENT_USER, Configuration::AUTOSTART_KEY, Configuration::AUTOSTART_VALUE);
 		std::wstring startupText = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRAY_STARTUP);
 		if (startupText.empty()) startupText = L"Run at startup";
 		AppendMenuW(menu.get(), MF_STRING | (startup ? MF_CHECKED : 0), Configuration::ID_TRAY_STARTUP, startupText.c_str());
+		std::wstring mouseExtrasText = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRAY_MOUSE_EXTRAS);
+		if (mouseExtrasText.empty()) mouseExtrasText = L"Scroll wheel and side buttons move paws";
+		AppendMenuW(menu.get(), MF_STRING | (m_app->GetState()->GetMouseExtrasDrivePaws() ? MF_CHECKED : 0),
+			Configuration::ID_TRAY_MOUSE_EXTRAS, mouseExtrasText.c_str());
+		std::wstring transitionsText = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRAY_TRANSITIONS);
+		if (transitionsText.empty()) transitionsText = L"Smooth transitions";
+		AppendMenuW(menu.get(), MF_STRING | (m_app->GetState()->GetTransitionsEnabled() ? MF_CHECKED : 0),
+			Configuration::ID_TRAY_TRANSITIONS, transitionsText.c_str());
 		AppendMenuW(menu.get(), MF_SEPARATOR, 0, nullptr);
 		std::wstring closeText = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRAY_CLOSE);
 		if (closeText.empty()) closeText = L"Close";
@@ -308,27 +486,162 @@ void WindowManager::OnCommand(WPARAM wParam) {
 	case Configuration::ID_TRAY_HIDE:
 		SetVisible(!IsWindowVisible());
 		break;
-	case Configuration::ID_TRAY_RESET_POSITION: {
-		// Move window to default bottom-right position
-		RECT workArea{};
-		SystemParametersInfo(SPI_GETWORKAREA, 0, &workArea, 0);
-		int x = workArea.right - Configuration::IMAGE_RIGHT_MARGIN;
-		int y = workArea.bottom - Configuration::IMAGE_BOTTOM_MARGIN;
-		SetWindowPos(m_app->GetMainWindow(), nullptr, x, y, 0, 0, SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE);
-		// Persist new position
-		SettingsService::WriteWindowPosition(x, y);
+	case Configuration::ID_TRAY_RESET_POSITION:
+		ResetWindowPosition();
+		break;
+	case Configuration::ID_TRAY_MOUSE_EXTRAS: {
+		bool enabled = !m_app->GetState()->GetMouseExtrasDrivePaws();
+		m_app->GetState()->SetMouseExtrasDrivePaws(enabled);
+		SettingsService::WriteMouseExtrasDrivePaws(enabled);
 		break;
 	}
-	case Configuration::ID_TRAY_SKIN_MARSHMALLOW:
-	case Configuration::ID_TRAY_SKIN_MOCHI:
-	case Configuration::ID_TRAY_SKIN_TOFFEE:
-	case Configuration::ID_TRAY_SKIN_HONEY:
-	case Configuration::ID_TRAY_SKIN_LATTE:
-	case Configuration::ID_TRAY_SKIN_TREACLE: {
-		int newSkin = LOWORD(wParam) - Configuration::ID_TRAY_SKIN_MARSHMALLOW;
-		SkinService::ApplySkinChange(m_app, newSkin);
+	case Configuration::ID_TRAY_TRANSITIONS: {
+		bool enabled = !m_app->GetState()->GetTransitionsEnabled();
+		m_app->GetState()->SetTransitionsEnabled(enabled);
+		SettingsService::WriteTransitions(enabled);
+		ResetPlayback();
+		InvalidatePresented();
+		if (m_app->GetImageManager()) m_app->GetImageManager()->SetTransitionsEnabled(enabled);
 		break;
 	}
+	case Configuration::ID_TRAY_EXPORT_HEATMAP:
+		ExportKeyHeatmap();
+		break;
+	case Configuration::ID_TRAY_SAVE_TRACE:
+		SaveTrace();
+		break;
+	case Configuration::ID_TRAY_SIZE_AUTO:
+		ApplyScaleSetting(Configuration::SCALE_AUTO);
+		break;
+	default: {
+		const int preset = LOWORD(wParam) - Configuration::ID_TRAY_SIZE_PRESET_FIRST;
+		if (preset >= 0 && preset < Configuration::SCALE_PRESET_COUNT) {
+			ApplyScaleSetting(Configuration::SCALE_PRESETS[preset]);
+		}
+		// Pack skins continue the built-in skin command range
+		const int skin = LOWORD(wParam) - Configuration::ID_TRAY_SKIN_FIRST;
+		if (skin >= 0 && skin < Configuration::SKIN_COUNT + SkinPacks::Count()) {
+			SkinService::ApplySkinChange(m_app, skin);
+		}
+		const int accessory = LOWORD(wParam) - Configuration::ID_TRAY_ACCESSORY_FIRST;
+		if (accessory >= 0 && accessory < SkinPacks::AccessoryCount()) {
+			SkinService::ToggleAccessory(m_app, accessory);
+		}
+		const int tint = LOWORD(wParam) - Configuration::ID_TRAY_TINT_FIRST;
+		if (tint >= 0 && tint < TINT_PRESET_COUNT) {
+			SkinService::ApplyTint(m_app, TINT_PRESETS[tint].tint);
+		}
+		const int outline = LOWORD(wParam) - Configuration::ID_TRAY_OUTLINE_FIRST;
+		if (FrameOutline::IsValid(outline)) {
+			SkinService::ApplyOutline(m_app, outline);
+		}
+		const int counterMode = LOWORD(wParam) - Configuration::ID_TRAY_COUNTER_FIRST;
+		if (ValidationUtils::IsValidCounterMode(counterMode)) {
+			ApplyCounterMode(counterMode);
+		}
+		break;
+	}
+	}
+}
+
+void WindowManager::OnControlBatch(ControlCall* calls, size_t count) {
+	if (!calls) return;
+	for (size_t i = 0; i < count; ++i) {
+		ExecuteControlCall(calls[i]);
+	}
+}
+
+void WindowManager::ExecuteControlCall(ControlCall& call) {
+	using ControlProtocol::Command;
+	using ControlProtocol::Status;
+	ControlProtocol::Response& response = call.response;
+	response.status = static_cast<uint8_t>(Status::Ok);
+
+	if (call.request.version != ControlProtocol::VERSION) {
+		response.status = static_cast<uint8_t>(Status::UnsupportedVersion);
+		return;
+	}
+	if (!m_app || !m_app->GetState()) {
+		response.status = static_cast<uint8_t>(Status::Unavailable);
+		return;
+	}
+
+	ApplicationState* state = m_app->GetState();
+	switch (static_cast<Command>(call.request.command)) {
+	case Command::Show:
+		SetVisible(true);
+		break;
+	case Command::Hide:
+		SetVisible(false);
+		break;
+	case Command::SetSkin: {
+		const int skinId = call.request.argument;
+		if (!ValidationUtils::IsValidSkin(skinId) || !state->CanUnlockSkin(skinId)) {
+			response.status = static_cast<uint8_t>(Status::InvalidArgument);
+			break;
+		}
+		SkinService::ApplySkinChange(m_app, skinId);
+		response.value = state->GetCurrentSkin();
+		if (state->GetCurrentSkin() != skinId) {
+			response.status = static_cast<uint8_t>(Status::Unavailable);
+		}
+		break;
+	}
+	case Command::ResetPosition:
+		ResetWindowPosition();
+		break;
+	case Command::QueryLatency: {
+		static_assert(ControlProtocol::LATENCY_STAGE_COUNT == static_cast<size_t>(LatencyStage::Count), "Latency stages are part of the wire format");
+		const InputLatency& latency = state->GetLatency();
+		for (size_t stage = 0; stage < ControlProtocol::LATENCY_STAGE_COUNT; ++stage) {
+			const LatencyHistogram& histogram = latency.Get(static_cast<LatencyStage>(stage));
+			response.values[stage * 3 + ControlProtocol::LATENCY_P50] = histogram.GetPercentile(0.5);
+			response.values[stage * 3 + ControlProtocol::LATENCY_P99] = histogram.GetPercentile(0.99);
+			response.values[stage * 3 + ControlProtocol::LATENCY_P999] = histogram.GetPercentile(0.999);
+		}
+		break;
+	}
+#if BONGOCAT_TRACING
+	case Command::SaveTrace:
+		if (Trace::ExportChromeJson().empty()) {
+			response.status = static_cast<uint8_t>(Status::Unavailable);
+		}
+		break;
+#endif
+#if BONGOCAT_METRICS
+	case Command::QueryMetrics: {
+		static_assert(Metrics::COUNTER_COUNT + Metrics::GAUGE_COUNT <= ControlProtocol::VALUE_COUNT, "Metrics must fit one response");
+		const Metrics::Values metrics = Metrics::Collect();
+		for (size_t i = 0; i < Metrics::COUNTER_COUNT; ++i) {
+			response.values[i] = metrics.counters[i];
+		}
+		for (size_t i = 0; i < Metrics::GAUGE_COUNT; ++i) {
+			response.values[Metrics::COUNTER_COUNT + i] = static_cast<uint64_t>(metrics.gauges[i]);
+		}
+		break;
+	}
+#endif
+	case Command::QueryStats: {
+		uint64_t keyPresses = 0;
+		for (uint32_t count : state->GetKeyPressCounts()) keyPresses += count;
+		response.values[ControlProtocol::STATS_CLICKS] = static_cast<uint64_t>(state->GetClickCount());
+		response.values[ControlProtocol::STATS_SKIN] = static_cast<uint64_t>(state->GetCurrentSkin());
+		response.values[ControlProtocol::STATS_VISIBLE] = state->IsVisible() ? 1 : 0;
+		response.values[ControlProtocol::STATS_MOUSE_DISTANCE_PX] = state->GetMouseOdometer().GetDistancePixels();
+		response.values[ControlProtocol::STATS_WHEEL_NOTCHES] = state->GetMouseOdometer().GetWheelNotches();
+		response.values[ControlProtocol::STATS_KEY_PRESSES] = keyPresses;
+		response.values[ControlProtocol::STATS_ACCESSORIES] = state->GetAccessories();
+		break;
+	}
+	case Command::SetAccessories:
+		if (call.request.argument < 0 || !SkinService::ApplyAccessories(m_app, static_cast<uint32_t>(call.request.argument))) {
+			response.status = static_cast<uint8_t>(Status::InvalidArgument);
+		}
+		response.value = static_cast<int32_t>(state->GetAccessories());
+		break;
+	default:
+		response.status = static_cast<uint8_t>(Status::UnknownCommand);
+		break;
 	}
 }
 
@@ -353,6 +666,78 @@ void WindowManager::PersistWindowPosition() {
 	}
 }
 
+void WindowManager::ResetWindowPosition() {
+	if (!m_app || !m_app->GetMainWindow()) return;
+	// Move window to default bottom-right position
+	RECT workArea{};
+	SystemParametersInfo(SPI_GETWORKAREA, 0, &workArea, 0);
+	// Margins grow with the frame so a scaled cat sits on the taskbar the same way
+	int x = workArea.right - MulDiv(Configuration::IMAGE_RIGHT_MARGIN, m_frameSize.cx, Configuration::IMAGE_WIDTH);
+	int y = workArea.bottom - MulDiv(Configuration::IMAGE_BOTTOM_MARGIN, m_frameSize.cy, Configuration::IMAGE_HEIGHT);
+	SetWindowPos(m_app->GetMainWindow(), nullptr, x, y, 0, 0, SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE);
+	// Persist new position
+	SettingsService::WriteWindowPosition(x, y);
+}
+
+void WindowManager::PersistCounters() {
+	if (!m_app || !m_app->GetState()) return;
+	ApplicationState* state = m_app->GetState();
+	SettingsService::WriteClickCount(state->GetClickCount());
+	SettingsService::WriteKeyPressCounts(state->GetKeyPressCounts());
+	SettingsService::WriteMouseOdometer(state->GetMouseOdometer().GetDistancePixels(),
+		state->GetMouseOdometer().GetWheelNotches());
+}
+
+void WindowManager::ExportKeyHeatmap() {
+	if (!m_app || !m_app->GetState()) return;
+	std::wstring path = HeatmapService::ExportCsv(m_app->GetState()->GetKeyPressCounts());
+	std::wstring title = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRAY_EXPORT_HEATMAP);
+	if (title.empty()) title = L"Export key heatmap";
+	if (path.empty()) {
+		std::wstring failed = Localization::LoadStringResource(m_app->GetInstance(), IDS_HEATMAP_EXPORT_FAILED);
+		if (failed.empty()) failed = L"Could not save the key heatmap.";
+		ShowTrayNotification(title.c_str(), failed.c_str(), NIIF_WARNING);
+		return;
+	}
+	std::wstring savedFormat = Localization::LoadStringResource(m_app->GetInstance(), IDS_HEATMAP_EXPORTED);
+	if (savedFormat.empty()) savedFormat = L"Saved to %s";
+	std::wstring saved = Localization::FormatWide(savedFormat.c_str(), path.c_str());
+	ShowTrayNotification(title.c_str(), saved.c_str());
+}
+
+void WindowManager::SaveTrace() {
+#if BONGOCAT_TRACING
+	if (!m_app) return;
+	std::wstring path = Trace::ExportChromeJson();
+	std::wstring title = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRAY_SAVE_TRACE);
+	if (title.empty()) title = L"Save performance trace";
+	if (path.empty()) {
+		std::wstring failed = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRACE_SAVE_FAILED);
+		if (failed.empty()) failed = L"Could not save the trace.";
+		ShowTrayNotification(title.c_str(), failed.c_str(), NIIF_WARNING);
+		return;
+	}
+	std::wstring savedFormat = Localization::LoadStringResource(m_app->GetInstance(), IDS_HEATMAP_EXPORTED);
+	if (savedFormat.empty()) savedFormat = L"Saved to %s";
+	std::wstring saved = Localization::FormatWide(savedFormat.c_str(), path.c_str());
+	ShowTrayNotification(title.c_str(), saved.c_str());
+#endif
+}
+
+double WindowManager::PixelsToMeters(uint64_t pixels) {
+	// Physical size of the primary display; falls back to 96 DPI when the monitor reports no size
+	double millimetersPerPixel = 25.4 / 96.0;
+	ScreenDCWrapper screenDC;
+	if (screenDC.isValid()) {
+		const int widthMm = GetDeviceCaps(screenDC.get(), HORZSIZE);
+		const int widthPx = GetDeviceCaps(screenDC.get(), HORZRES);
+		if (widthMm > 0 && widthPx > 0) {
+			millimetersPerPixel = static_cast<double>(widthMm) / static_cast<double>(widthPx);
+		}
+	}
+	return static_cast<double>(pixels) * millimetersPerPixel / 1000.0;
+}
+
 // ---- Drawing ----
 bool WindowManager::CreateGraphicsResources(HWND hWnd) {
 	ScreenDCWrapper screenDC;
@@ -366,7 +751,7 @@ bool WindowManager::CreateGraphicsResources(HWND hWnd) {
 
 	m_deviceContext = DeviceContextWrapper(hdcMem, true);
 
-	// No persistent DIB; select at draw time
+	// Frames present from their own surfaces; this one only holds the counter overlay's
 	return true;
 }
 
@@ -374,28 +759,108 @@ void WindowManager::CleanupGraphicsResources() {
 	m_deviceContext = DeviceContextWrapper();
 }
 
-void WindowManager::UpdateImageInternal(HWND hWnd, HBITMAP image) {
-	if (!image || !m_deviceContext.get()) return;
-
-	ScreenDCWrapper screenDC;
-	if (!screenDC.isValid()) return;
+void WindowManager::UpdateImageInternal(HWND hWnd, int frame) {
+	TRACE_SCOPE("UpdateImageInternal");
+	ImageManager* images = m_app ? m_app->GetImageManager() : nullptr;
+	HDC surface = images ? images->GetFrameSurface(frame, m_frameSize) : nullptr;
+	if (!surface) {
+		DiscardPendingInput();
+		return;
+	}
 
-	SelectedObjectWrapper selectImage(m_deviceContext.get(), image);
-	if (!selectImage.IsSelected()) return;
+	// Frame surfaces are selected once per frame set; a present only sends the region that
+	// differs from what the window already shows
+	const RECT whole = { 0, 0, m_frameSize.cx, m_frameSize.cy };
+	RECT dirty = whole;
+	const bool sameSize = m_presentedSize.cx == m_frameSize.cx && m_presentedSize.cy == m_frameSize.cy;
+	const bool known = m_presentedFrame >= 0 && sameSize;
+	bool overlay = false;
+	SelectedObjectWrapper selectComposed;
+	const ApplicationState* state = m_app->GetState();
+	if (state && state->GetCounterMode() != Configuration::COUNTER_OFF && m_counterOverlay.Prepare(m_frameSize)) {
+		// With the counter on, the frame is presented through the overlay's surface, which copies
+		// and sends only the frame damage plus the old and new digit regions
+		const int count = state->GetCounterMode() == Configuration::COUNTER_SESSION ? state->GetSessionClickCount() : state->GetClickCount();
+		RECT damage;
+		const bool damageKnown = known && m_presentedOverlay;
+		if (damageKnown) damage = images->GetFrameDamage(m_presentedFrame, frame, m_frameSize);
+		HBITMAP composed = m_counterOverlay.Compose(images->GetImage(frame, m_frameSize), static_cast<uint32_t>(count < 0 ? 0 : count),
+			damageKnown ? &damage : nullptr, dirty);
+		if (composed && m_deviceContext.get()) {
+			selectComposed = SelectedObjectWrapper(m_deviceContext.get(), composed);
+			if (!selectComposed.IsSelected()) {
+				m_counterOverlay.Invalidate();
+				return;
+			}
+			surface = m_deviceContext.get();
+			overlay = true;
+		}
+		else {
+			dirty = whole;
+		}
+	}
+	else {
+		// The overlay's surface is stale once plain frames were shown
+		m_counterOverlay.Invalidate();
+		if (known && !m_presentedOverlay) {
+			dirty = images->GetFrameDamage(m_presentedFrame, frame, m_frameSize);
+		}
+	}
+	if (!sameSize) dirty = whole;
+	if (IsRectEmpty(&dirty)) {
+		// Already on screen; the input changed nothing visible
+		DiscardPendingInput();
+		return;
+	}
 
-	RECT rect;
-	GetWindowRect(hWnd, &rect);
-	POINT ptPos = { rect.left, rect.top };
-	SIZE sizeWnd = { Configuration::IMAGE_WIDTH, Configuration::IMAGE_HEIGHT };
+	// No destination DC or position: the window keeps its place and the screen palette
+	SIZE sizeWnd = m_frameSize;
 	POINT ptSrc = { 0, 0 };
 	BLENDFUNCTION blend = { AC_SRC_OVER, 0, Configuration::FULL_OPACITY, AC_SRC_ALPHA };
 
-	UpdateLayeredWindow(hWnd, screenDC.get(), &ptPos, &sizeWnd,
-		m_deviceContext.get(), &ptSrc, 0, &blend, ULW_ALPHA);
+	UPDATELAYEREDWINDOWINFO info = { sizeof(info) };
+	info.psize = &sizeWnd;
+	info.hdcSrc = surface;
+	info.pptSrc = &ptSrc;
+	info.pblend = &blend;
+	info.dwFlags = ULW_ALPHA;
+	info.prcDirty = EqualRect(&dirty, &whole) ? nullptr : &dirty;
+	if (UpdateLayeredWindowIndirect(hWnd, &info)) {
+		// Only updates that reached the screen pace the next present and count as presents
+		m_presentScheduler.OnPresented();
+		METRIC_INC(Presents);
+		m_presentedFrame = frame;
+		m_presentedOverlay = overlay;
+		m_presentedSize = m_frameSize;
+		RecordPresentLatency();
+	}
+	else {
+		// The overlay already holds this frame and count; make the retry send everything
+		m_counterOverlay.Invalidate();
+		m_presentedFrame = -1;
+	}
 }
 
-void WindowManager::UpdateImage(HWND windowHandle, HBITMAP imageHandle) {
-	UpdateImageInternal(windowHandle, imageHandle);
+void WindowManager::UpdateImage(HWND windowHandle, int frame) {
+	UpdateImageInternal(windowHandle, frame);
+}
+
+void WindowManager::NoteInputForPresent(const InputTiming& timing, uint32_t queueStamp) noexcept {
+	// Inputs folded into one present share it; the oldest waited longest
+	if (m_inputPending) return;
+	m_inputPending = true;
+	m_pendingInput = timing;
+	m_pendingQueueStamp = queueStamp;
+}
+
+void WindowManager::RecordPresentLatency() {
+	if (!m_inputPending || !m_app || !m_app->GetState()) return;
+	m_inputPending = false;
+	InputLatency& latency = m_app->GetState()->GetLatency();
+	const uint32_t presentStamp = InputLatency::Stamp();
+	latency.Record(LatencyStage::StateMachineToPresent, latency.ElapsedMicros(m_pendingQueueStamp, presentStamp));
+	latency.Record(LatencyStage::InputToPresent,
+		static_cast<uint64_t>(m_pendingInput.hookDelayMs) * 1000 + latency.ElapsedMicros(m_pendingInput.hookStamp, presentStamp));
 }
 
 // ---- Tray ----
@@ -467,14 +932,14 @@ void WindowManager::AppendSkinItem(HMENU hSkinMenu, int skinId) {
 	if (unlocked) {
 		wcsncpy_s(skinText, skinName, _TRUNCATE);
 		AppendMenuW(hSkinMenu, MF_STRING | (m_app->GetState()->GetCurrentSkin() == skinId ? MF_CHECKED : 0),
-			Configuration::ID_TRAY_SKIN_MARSHMALLOW + skinId, skinText);
+			Configuration::ID_TRAY_SKIN_FIRST + skinId, skinText);
 	}
 	else {
 		std::wstring lockedFormat = Localization::LoadStringResource(m_app->GetInstance(), IDS_SKIN_LOCKED_FORMAT);
 		if (lockedFormat.empty()) lockedFormat = L"%s (%d clicks)";
 		std::wstring lockedText = Localization::FormatWide(lockedFormat.c_str(), skinName, unlockThreshold);
 		wcsncpy_s(skinText, lockedText.c_str(), _TRUNCATE);
-		AppendMenuW(hSkinMenu, MF_STRING | MF_GRAYED, Configuration::ID_TRAY_SKIN_MARSHMALLOW + skinId, skinText);
+		AppendMenuW(hSkinMenu, MF_STRING | MF_GRAYED, Configuration::ID_TRAY_SKIN_FIRST + skinId, skinText);
 	}
 }
 
@@ -483,36 +948,178 @@ HMENU WindowManager::CreateSkinMenu() {
 	for (int skinId = 0; skinId < Configuration::SKIN_COUNT; ++skinId) {
 		AppendSkinItem(hSkinMenu, skinId);
 	}
+	const int packCount = SkinPacks::Count();
+	if (packCount > 0) {
+		AppendMenuW(hSkinMenu, MF_SEPARATOR, 0, nullptr);
+		for (int skinId = Configuration::SKIN_COUNT; skinId < Configuration::SKIN_COUNT + packCount; ++skinId) {
+			AppendSkinItem(hSkinMenu, skinId);
+		}
+	}
 	return hSkinMenu;
 }
 
+HMENU WindowManager::CreateSizeMenu() {
+	HMENU hSizeMenu = CreatePopupMenu();
+	const int scale = m_app->GetState()->GetScale();
+	std::wstring autoText = Localization::LoadStringResource(m_app->GetInstance(), IDS_TRAY_SIZE_AUTO);
+	if (autoText.empty()) autoText = L"Match display";
+	AppendMenuW(hSizeMenu, MF_STRING | (scale == Configuration::SCALE_AUTO ? MF_CHECKED : 0),
+		Configuration::ID_TRAY_SIZE_AUTO, autoText.c_str());
+	for (int i = 0; i < Configuration::SCALE_PRESET_COUNT; ++i) {
+		std::wstring presetText = Localization::FormatWide(L"%d%%", Configuration::SCALE_PRESETS[i]);
+		AppendMenuW(hSizeMenu, MF_STRING | (scale == Configuration::SCALE_PRESETS[i] ? MF_CHECKED : 0),
+			Configuration::ID_TRAY_SIZE_PRESET_FIRST + i, presetText.c_str());
+	}
+	return hSizeMenu;
+}
+
+HMENU WindowManager::CreateColorMenu() {
+	HMENU hColorMenu = CreatePopupMenu();
+	const ColorTransform::Tint& current = m_app->GetState()->GetTint();
+	for (int i = 0; i < TINT_PRESET_COUNT; ++i) {
+		const TintPreset& preset = TINT_PRESETS[i];
+		std::wstring name = Localization::LoadStringResource(m_app->GetInstance(), preset.nameId);
+		if (name.empty()) name = preset.fallbackName;
+		if (preset.nameId == IDS_TINT_HUE_FORMAT) name = Localization::FormatWide(name.c_str(), preset.tint.hue);
+		AppendMenuW(hColorMenu, MF_STRING | (current == preset.tint ? MF_CHECKED : 0),
+			Configuration::ID_TRAY_TINT_FIRST + i, name.c_str());
+	}
+	return hColorMenu;
+}
+
+HMENU WindowManager::CreateOutlineMenu() {
+	HMENU hOutlineMenu = CreatePopupMenu();
+	const int current = m_app->GetState()->GetOutline();
+	for (int i = 0; i < FrameOutline::STYLE_COUNT; ++i) {
+		std::wstring name = Localization::LoadStringResource(m_app->GetInstance(), OUTLINE_ITEMS[i].nameId);
+		if (name.empty()) name = OUTLINE_ITEMS[i].fallbackName;
+		AppendMenuW(hOutlineMenu, MF_STRING | (current == i ? MF_CHECKED : 0),
+			Configuration::ID_TRAY_OUTLINE_FIRST + i, name.c_str());
+	}
+	return hOutlineMenu;
+}
+
+HMENU WindowManager::CreateCounterMenu() {
+	HMENU hCounterMenu = CreatePopupMenu();
+	const int current = m_app->GetState()->GetCounterMode();
+	for (int i = 0; i < Configuration::COUNTER_MODE_COUNT; ++i) {
+		std::wstring name = Localization::LoadStringResource(m_app->GetInstance(), COUNTER_ITEMS[i].nameId);
+		if (name.empty()) name = COUNTER_ITEMS[i].fallbackName;
+		AppendMenuW(hCounterMenu, MF_STRING | (current == i ? MF_CHECKED : 0),
+			Configuration::ID_TRAY_COUNTER_FIRST + i, name.c_str());
+	}
+	return hCounterMenu;
+}
+
+void WindowManager::ApplyCounterMode(int mode) {
+	m_app->GetState()->SetCounterMode(mode);
+	SettingsService::WriteCounterMode(mode);
+	if (mode == Configuration::COUNTER_OFF) {
+		m_counterOverlay.Release();
+	}
+	else {
+		m_counterOverlay.Invalidate();
+	}
+	m_app->RedrawCurrentImage();
+}
+
+HMENU WindowManager::CreateAccessoryMenu() {
+	HMENU hAccessoryMenu = CreatePopupMenu();
+	const uint32_t worn = m_app->GetState()->GetAccessories();
+	for (int id = 0; id < SkinPacks::AccessoryCount(); ++id) {
+		AppendMenuW(hAccessoryMenu, MF_STRING | ((worn & (1u << id)) ? MF_CHECKED : 0),
+			Configuration::ID_TRAY_ACCESSORY_FIRST + id, SkinPacks::FindAccessory(id)->name.c_str());
+	}
+	return hAccessoryMenu;
+}
+
+void WindowManager::ApplyScaleSetting(int scale) {
+	if (!m_app || !m_app->GetState()) return;
+	m_app->GetState()->SetScale(scale);
+	SettingsService::WriteScale(scale);
+	if (ApplyScale()) {
+		m_app->RedrawCurrentImage();
+	}
+}
+
+int WindowManager::SelectFrame(int targetImage) {
+	ImageManager* images = m_app ? m_app->GetImageManager() : nullptr;
+	const AnimationPolicy& policy = CurrentPolicy();
+	if (targetImage != m_playbackTarget) {
+		// Fades start only from a settled image; a change mid-fade cuts straight to the new target
+		const bool fade = images && policy.crossFades && m_app->GetState()->GetTransitionsEnabled();
+		m_playback = fade ? images->GetTimeline().Find(m_settledImage, targetImage) : TransitionTimeline::Span{ 0, 0 };
+		m_playbackTarget = targetImage;
+		m_playbackStep = 0;
+	}
+	// One step per paced present; without pacing the fade is skipped
+	if (m_playbackStep < m_playback.length && m_presentScheduler.ScheduleNext(policy.minPresentInterval)) {
+		return images->GetTimeline().FrameAt(m_playback, m_playbackStep++);
+	}
+	m_playback = { 0, 0 };
+	m_settledImage = targetImage;
+	return targetImage;
+}
+
+void WindowManager::ResetPlayback() noexcept {
+	m_settledImage = -1;
+	m_playbackTarget = -1;
+	m_playbackStep = 0;
+	m_playback = { 0, 0 };
+}
+
+bool WindowManager::ApplyScale(const RECT* suggested) {
+	if (!m_app || !m_app->GetMainWindow() || !m_app->GetImageManager() || !m_app->GetState()) return false;
+	const int scale = m_app->GetState()->GetScale();
+	const int percent = (scale == Configuration::SCALE_AUTO) ? MulDiv(100, m_dpi, USER_DEFAULT_SCREEN_DPI) : scale;
+	const SIZE size = m_app->GetImageManager()->GetFrameSize(percent);
+
+	const bool resized = size.cx != m_frameSize.cx || size.cy != m_frameSize.cy;
+	if (!resized && !suggested) return false;
+	m_frameSize = size;
+
+	UINT flags = SWP_NOZORDER | SWP_NOACTIVATE;
+	int x = 0, y = 0;
+	if (suggested) {
+		x = suggested->left;
+		y = suggested->top;
+	}
+	else {
+		flags |= SWP_NOMOVE;
+	}
+	SetWindowPos(m_app->GetMainWindow(), nullptr, x, y, size.cx, size.cy, flags);
+	return resized;
+}
+
 // ---- Timers ----
 bool WindowManager::InitializeTimers() {
 	if (!m_app || !m_app->GetMainWindow()) return false;
 	m_blinkTimer = std::make_unique<TimerWrapper>(m_app->GetMainWindow(), Configuration::ID_BLINK_TIMER);
 	m_imageSwitchTimer = std::make_unique<TimerWrapper>(m_app->GetMainWindow(), Configuration::ID_IMAGE_SWITCH_TIMER);
 	m_topmostTimer = std::make_unique<TimerWrapper>(m_app->GetMainWindow(), Configuration::ID_TOPMOST_TIMER);
+	m_releaseImagesTimer = std::make_unique<TimerWrapper>(m_app->GetMainWindow(), Configuration::ID_RELEASE_IMAGES_TIMER);
+	m_presenceTimer = std::make_unique<TimerWrapper>(m_app->GetMainWindow(), Configuration::ID_PRESENCE_TIMER);
 
-	if (!m_blinkTimer->Set(Configuration::BLINK_INTERVAL)) return false;
+	if (!m_blinkTimer->Set(CurrentPolicy().blinkInterval, CurrentPolicy().timerTolerance)) return false;
 	if (!m_topmostTimer->Set(Configuration::TOPMOST_TIMER_DELAY)) return false;
 	return true;
 }
 
 void WindowManager::EnsureBlinkTimerRunning() {
 	if (m_blinkTimer && !m_blinkTimer->IsActive()) {
-		m_blinkTimer->Set(Configuration::BLINK_INTERVAL);
+		m_blinkTimer->Set(CurrentPolicy().blinkInterval, CurrentPolicy().timerTolerance);
 	}
 }
 
 void WindowManager::RestartBlinkTimer() {
 	if (m_blinkTimer) {
-		m_blinkTimer->Restart(Configuration::BLINK_INTERVAL);
+		m_blinkTimer->Restart(CurrentPolicy().blinkInterval, CurrentPolicy().timerTolerance);
 	}
 }
 
 void WindowManager::StartImageSwitchTimer(UINT delayMs) {
 	if (m_imageSwitchTimer) {
-		m_imageSwitchTimer->Set(delayMs);
+		m_imageSwitchTimer->Set(delayMs, CurrentPolicy().timerTolerance);
 	}
 }
 
@@ -527,3 +1134,155 @@ void WindowManager::StopAnimationTimers() {
 	if (m_imageSwitchTimer) m_imageSwitchTimer->Kill();
 	if (m_topmostTimer) m_topmostTimer->Kill();
 }
+
+bool WindowManager::DeferPresent(UINT minInterval) {
+	if (m_presentScheduler.ShouldPresentNow(minInterval)) return false;
+	METRIC_INC(PresentsDeferred);
+	return true;
+}
+
+void WindowManager::StartPresenceTracking() {
+	// Both are best effort: without them the cat simply keeps presenting
+	m_sessionNotifications = WTSRegisterSessionNotification(m_app->GetMainWindow(), NOTIFY_FOR_THIS_SESSION) != FALSE;
+	if (!g_presenceOwner) {
+		g_presenceOwner = this;
+		m_foregroundHook = std::make_unique<WinEventHookWrapper>(EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND, ForegroundEventProc);
+		if (!m_foregroundHook->isValid()) {
+			m_foregroundHook.reset();
+		}
+		m_desktopHook = std::make_unique<WinEventHookWrapper>(EVENT_SYSTEM_DESKTOPSWITCH, EVENT_SYSTEM_DESKTOPSWITCH, ForegroundEventProc);
+		if (!m_desktopHook->isValid()) {
+			m_desktopHook.reset();
+		}
+	}
+	UpdatePresence();
+}
+
+void WindowManager::StopPresenceTracking() {
+	m_foregroundHook.reset();
+	m_desktopHook.reset();
+	if (g_presenceOwner == this) {
+		g_presenceOwner = nullptr;
+	}
+	if (m_presenceTimer) m_presenceTimer->Kill();
+	if (m_sessionNotifications && m_app && m_app->GetMainWindow()) {
+		WTSUnRegisterSessionNotification(m_app->GetMainWindow());
+	}
+	m_sessionNotifications = false;
+}
+
+void WindowManager::ClearHeldKeys() {
+	if (m_app && m_app->GetState()) m_app->GetState()->ClearKeyState();
+}
+
+bool WindowManager::IsFullscreenForeground() const {
+	// The same signal the shell uses to hold back toast notifications
+	QUERY_USER_NOTIFICATION_STATE state = QUNS_ACCEPTS_NOTIFICATIONS;
+	if (FAILED(SHQueryUserNotificationState(&state))) return false;
+	if (state != QUNS_BUSY && state != QUNS_RUNNING_D3D_FULL_SCREEN && state != QUNS_PRESENTATION_MODE) return false;
+
+	// That signal is session-wide; only a foreground window covering the cat's monitor hides it
+	HWND foreground = GetForegroundWindow();
+	HWND window = m_app ? m_app->GetMainWindow() : nullptr;
+	if (!foreground || !window) return false;
+	HMONITOR monitor = MonitorFromWindow(window, MONITOR_DEFAULTTONEAREST);
+	if (MonitorFromWindow(foreground, MONITOR_DEFAULTTONULL) != monitor) return false;
+	MONITORINFO info = { sizeof(info) };
+	RECT bounds;
+	if (!GetMonitorInfoW(monitor, &info) || !GetWindowRect(foreground, &bounds)) return false;
+	return bounds.left <= info.rcMonitor.left && bounds.top <= info.rcMonitor.top
+		&& bounds.right >= info.rcMonitor.right && bounds.bottom >= info.rcMonitor.bottom;
+}
+
+void WindowManager::UpdatePresence() {
+	if (!m_app || !m_app->GetState() || !m_app->GetMainWindow()) return;
+	ApplicationState* state = m_app->GetState();
+
+	const bool fullscreen = IsFullscreenForeground();
+	const bool occluded = m_sessionLocked || fullscreen;
+
+	// A fullscreen app can leave fullscreen without a foreground change; poll slowly only then
+	if (m_presenceTimer) {
+		if (fullscreen && !m_presenceTimer->IsActive()) m_presenceTimer->Set(Configuration::PRESENCE_RECHECK_INTERVAL);
+		else if (!fullscreen) m_presenceTimer->Kill();
+	}
+
+	if (occluded == state->IsOccluded()) return;
+	state->SetOccluded(occluded);
+
+	if (occluded) {
+		// Stop fighting the fullscreen app for topmost; the state machine keeps running
+		if (m_topmostTimer) m_topmostTimer->Kill();
+		return;
+	}
+
+	if (state->IsVisible()) {
+		if (m_topmostTimer) m_topmostTimer->Set(Configuration::TOPMOST_TIMER_DELAY);
+		::SetWindowPos(m_app->GetMainWindow(), HWND_TOPMOST, 0, 0, 0, 0,
+			SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
+		// Catch up with whatever the state machine did meanwhile
+		m_app->RedrawCurrentImage();
+	}
+}
+
+void WindowManager::StartPowerTracking() {
+	// Each registration posts the current value right away, which applies the initial policy
+	HWND hwnd = m_app->GetMainWindow();
+	m_powerSourceNotify = std::make_unique<PowerNotifyWrapper>(hwnd, GUID_ACDC_POWER_SOURCE);
+	m_powerSavingNotify = std::make_unique<PowerNotifyWrapper>(hwnd, GUID_POWER_SAVING_STATUS);
+}
+
+void WindowManager::StopPowerTracking() {
+	m_powerSourceNotify.reset();
+	m_powerSavingNotify.reset();
+}
+
+void WindowManager::OnPowerSettingChange(const POWERBROADCAST_SETTING* setting) {
+	if (!setting || setting->DataLength < sizeof(DWORD)) return;
+	const DWORD value = *reinterpret_cast<const DWORD*>(setting->Data);
+	if (IsEqualGUID(setting->PowerSetting, GUID_ACDC_POWER_SOURCE)) {
+		m_onBattery = (value != PoAc); // battery or short-term UPS
+	}
+	else if (IsEqualGUID(setting->PowerSetting, GUID_POWER_SAVING_STATUS)) {
+		m_powerSaving = (value != 0);
+	}
+	else {
+		return;
+	}
+	ApplyAnimationPolicy();
+}
+
+void WindowManager::ApplyAnimationPolicy() {
+	ApplicationState* state = m_app ? m_app->GetState() : nullptr;
+	if (!state) return;
+	const AnimationPolicy& policy = (m_onBattery || m_powerSaving) ? AnimationPolicies::PowerSaver : AnimationPolicies::Normal;
+	if (&state->GetAnimationPolicy() == &policy) return;
+	state->SetAnimationPolicy(policy);
+	// Re-arm the long-running timer so the new interval and slack apply now
+	if (m_blinkTimer && m_blinkTimer->IsActive()) {
+		m_blinkTimer->Restart(policy.blinkInterval, policy.timerTolerance);
+	}
+}
+
+const AnimationPolicy& WindowManager::CurrentPolicy() const {
+	ApplicationState* state = m_app ? m_app->GetState() : nullptr;
+	return state ? state->GetAnimationPolicy() : AnimationPolicies::Normal;
+}
+
+void WindowManager::ReleaseImages() {
+	ImageManager* images = m_app->GetImageManager();
+	if (!images || images->GetImageCount() == 0) return;
+	// The stream keeps its own encoded copy, so only the window's surfaces go
+	images->Cleanup();
+	m_counterOverlay.Release();
+	m_presentedFrame = -1;
+	// Hand the freed pages back to the OS now rather than under later memory pressure
+	SetProcessWorkingSetSize(GetCurrentProcess(), static_cast<SIZE_T>(-1), static_cast<SIZE_T>(-1));
+}
+
+void WindowManager::RestoreImages() {
+	ImageManager* images = m_app->GetImageManager();
+	if (!images || images->GetImageCount() != 0 || !m_app->GetState()) return;
+	// Same skin as before, so the stream's frame set is still valid
+	images->LoadImages(m_app->GetState()->GetCurrentSkin());
+}
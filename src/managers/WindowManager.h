@@ -2,10 +2,21 @@
 #include <windows.h>
 #include <memory>
 #include <utility>
+#include <cstdint>
 #include <shellapi.h>
 #include "../utils/RAII/Window.h"
 #include "../utils/RAII/Gdi.h"
 #include "../utils/RAII/Timer.h"
+#include "../utils/RAII/Hook.h"
+#include "../utils/RAII/Handle.h"
+#include "../states/CatStateMachine.h"
+#include "../states/LatencyHistogram.h"
+#include "../states/AnimationPolicy.h"
+#include "../states/TransitionTimeline.h"
+#include "../utils/Configuration.h"
+#include "../utils/ControlProtocol.h"
+#include "../utils/PresentScheduler.h"
+#include "../utils/CounterOverlay.h"
 // Tray and drawing are handled here
 
 class BongoCatApp;
@@ -26,24 +37,87 @@ private:
 	std::unique_ptr<TimerWrapper> m_blinkTimer;
 	std::unique_ptr<TimerWrapper> m_imageSwitchTimer;
 	std::unique_ptr<TimerWrapper> m_topmostTimer;
+	std::unique_ptr<TimerWrapper> m_releaseImagesTimer;
+	std::unique_ptr<TimerWrapper> m_presenceTimer;
+	// Present pacing
+	PresentScheduler m_presentScheduler;
+	// Click counter drawn over the presented frame
+	CounterOverlay m_counterOverlay;
+	// Scale: monitor DPI and the frame size it resolves to
+	UINT m_dpi = USER_DEFAULT_SCREEN_DPI;
+	SIZE m_frameSize = { Configuration::IMAGE_WIDTH, Configuration::IMAGE_HEIGHT };
+	// What the layered window shows, so the next present sends only what changed (-1: unknown)
+	int m_presentedFrame = -1;
+	bool m_presentedOverlay = false; // shown through the counter overlay's surface
+	SIZE m_presentedSize = { 0, 0 };
+	// Oldest input not yet shown; its present latency is recorded when a present lands
+	bool m_inputPending = false;
+	InputTiming m_pendingInput;
+	uint32_t m_pendingQueueStamp = 0;
+	// Cross-fade playback
+	int m_settledImage = -1;
+	int m_playbackTarget = -1;
+	int m_playbackStep = 0;
+	TransitionTimeline::Span m_playback = { 0, 0 };
+	// Presence (session lock, fullscreen foreground)
+	std::unique_ptr<WinEventHookWrapper> m_foregroundHook;
+	std::unique_ptr<WinEventHookWrapper> m_desktopHook; // desktop switches (UAC prompts, lock screen)
+	bool m_sessionNotifications = false;
+	bool m_sessionLocked = false;
+	// Power source (AC/battery, OS power saver)
+	std::unique_ptr<PowerNotifyWrapper> m_powerSourceNotify;
+	std::unique_ptr<PowerNotifyWrapper> m_powerSavingNotify;
+	bool m_onBattery = false;
+	bool m_powerSaving = false;
 
 	// Helper methods
 	ATOM RegisterWindowClass();
 	bool CreateMainWindow();
 	bool InitializeWindow();
 	void PersistWindowPosition();
+	void ResetWindowPosition();
+	void PersistCounters();
+	void ExportKeyHeatmap();
+	void SaveTrace();
+	static double PixelsToMeters(uint64_t pixels);
+	// Control channel helpers
+	void ExecuteControlCall(ControlCall& call);
 	// Drawing helpers
 	bool CreateGraphicsResources(HWND hWnd);
 	void CleanupGraphicsResources();
-	void UpdateImageInternal(HWND hWnd, HBITMAP image);
+	void UpdateImageInternal(HWND hWnd, int frame);
+	void RecordPresentLatency();
 	// Tray helpers
 	bool CreateTrayIcon();
 	void DestroyTrayIcon();
 	HMENU CreateSkinMenu();
 	void AppendSkinItem(HMENU hSkinMenu, int skinId);
+	HMENU CreateSizeMenu();
+	HMENU CreateAccessoryMenu();
+	HMENU CreateColorMenu();
+	HMENU CreateOutlineMenu();
+	HMENU CreateCounterMenu();
+	void ApplyCounterMode(int mode);
+	void ApplyScaleSetting(int scale);
 	// Timer helpers
 	bool InitializeTimers();
 
+	// Hidden-mode memory
+	void ReleaseImages();
+	void RestoreImages();
+
+	// Presence helpers
+	void StartPresenceTracking();
+	void StopPresenceTracking();
+	bool IsFullscreenForeground() const;
+
+	// Power helpers
+	void StartPowerTracking();
+	void StopPowerTracking();
+	void OnPowerSettingChange(const POWERBROADCAST_SETTING* setting);
+	void ApplyAnimationPolicy();
+	const AnimationPolicy& CurrentPolicy() const;
+
 public:
 	WindowManager(BongoCatApp* app);
 	~WindowManager();
@@ -59,22 +133,44 @@ public:
 	void SetVisible(bool show);
 	bool IsWindowVisible() const;
 	HWND GetMainWindow() const;
+	// Scale: resizes the window for the scale setting and monitor DPI; true when the size changed
+	bool ApplyScale(const RECT* suggested = nullptr);
+	SIZE GetFrameSize() const noexcept { return m_frameSize; }
+	// Frame to present for the state's image: a cross-fade step while one plays, else the image
+	int SelectFrame(int targetImage);
+	void ResetPlayback() noexcept;
 	// Drawing
-	void UpdateImage(HWND windowHandle, HBITMAP imageHandle);
+	void UpdateImage(HWND windowHandle, int frame);
+	// Input the next present will show; a deferred present keeps it until the folded present lands
+	void NoteInputForPresent(const InputTiming& timing, uint32_t queueStamp) noexcept;
+	// Nothing will show the pending input (skipped while hidden or occluded)
+	void DiscardPendingInput() noexcept { m_inputPending = false; }
+	// The next present redraws the whole window (frame bitmaps may be reused after a reload)
+	void InvalidatePresented() noexcept {
+		m_counterOverlay.Invalidate();
+		m_presentedFrame = -1;
+	}
 	// Timer controls
 	void EnsureBlinkTimerRunning();
 	void RestartBlinkTimer();
 	void StartImageSwitchTimer(UINT delayMs);
 	void StopImageSwitchTimer();
 	void StopAnimationTimers();
+	// Pacing: true when the present was folded into a later one that will show the latest state
+	bool DeferPresent(UINT minInterval);
 
 	// Notifications
 	void ShowTrayNotification(LPCWSTR title, LPCWSTR message, DWORD infoFlags = NIIF_INFO, UINT timeoutMs = 5000);
 
 	// Event handlers
-	void OnInputEvent();
+	void OnInputEvent(PawSide side, const InputTiming& timing);
 	void OnTimer(UINT_PTR timerId);
 	void OnTrayIcon(LPARAM lParam);
 	void OnCommand(WPARAM wParam);
 	void OnDestroy();
+	void OnControlBatch(ControlCall* calls, size_t count);
+	// Re-evaluates whether the cat can be seen; presents a catch-up frame when it can again
+	void UpdatePresence();
+	// Forgets every held key; called on desktop switches and session lock/unlock, whose keyups never reach the hook
+	void ClearHeldKeys();
 };
@@ -0,0 +1,34 @@
+#pragma once
+#include <windows.h>
+#include "../utils/Configuration.h"
+
+// Timing knobs read whenever a timer is armed or a frame is presented
+struct AnimationPolicy {
+	UINT imageSwitchDelay;    // how long a paw stays down
+	UINT blinkInterval;
+	UINT blinkDelay;
+	ULONG timerTolerance;     // coalescing slack handed to the OS; 0 keeps the system default
+	UINT minPresentInterval;  // milliseconds between presents; 0 means uncapped
+	bool crossFades;          // play cross-fades when the user enabled them
+};
+
+namespace AnimationPolicies {
+	constexpr AnimationPolicy Normal = {
+		Configuration::IMAGE_SWITCH_DELAY,
+		Configuration::BLINK_INTERVAL,
+		Configuration::BLINK_DELAY,
+		0,
+		0,
+		true
+	};
+
+	// On battery or with the OS power saver on: fewer, later, batchable wakeups
+	constexpr AnimationPolicy PowerSaver = {
+		Configuration::POWER_SAVER_IMAGE_SWITCH_DELAY,
+		Configuration::POWER_SAVER_BLINK_INTERVAL,
+		Configuration::BLINK_DELAY,
+		Configuration::POWER_SAVER_TIMER_TOLERANCE,
+		1000 / Configuration::POWER_SAVER_MAX_FPS,
+		false
+	};
+}
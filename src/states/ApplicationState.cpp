@@ -3,9 +3,19 @@
 
 ApplicationState::ApplicationState()
 	: m_clickCount(0)
-	, m_currentSkin(Configuration::SKIN_MARSHMALLOW)
-	, m_isKeyPressed(false)
-	, m_isVisible(true) {
+	, m_sessionClickCount(0)
+	, m_currentSkin(Configuration::SKIN_DEFAULT)
+	, m_accessories(0)
+	, m_outline(FrameOutline::STYLE_NONE)
+	, m_counterMode(Configuration::COUNTER_OFF)
+	, m_scale(Configuration::SCALE_AUTO)
+	, m_isVisible(true)
+	, m_isOccluded(false)
+	, m_animationPolicy(&AnimationPolicies::Normal)
+	, m_mouseExtrasDrivePaws(false)
+	, m_transitionsEnabled(false)
+	, m_lastInputTick(0)
+	, m_keyPressCounts{} {
 
 	// Create state machine
 	m_stateMachine = std::make_unique<CatStateMachine>();
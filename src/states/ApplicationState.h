@@ -1,14 +1,39 @@
 #pragma once
 #include <memory>
+#include <atomic>
+#include <array>
+#include <cstdint>
 #include "../utils/Configuration.h"
+#include "../utils/ColorTransform.h"
+#include "../utils/FrameOutline.h"
 #include "CatStateMachine.h"
+#include "KeyState.h"
+#include "MouseOdometer.h"
+#include "KeyRateMeter.h"
+#include "LatencyHistogram.h"
+#include "AnimationPolicy.h"
 
 class ApplicationState {
 private:
 	int m_clickCount;
+	int m_sessionClickCount;
 	int m_currentSkin;
-	bool m_isKeyPressed;
+	uint32_t m_accessories;
+	ColorTransform::Tint m_tint;
+	int m_outline;
+	int m_counterMode;
+	int m_scale;
 	bool m_isVisible;
+	bool m_isOccluded;
+	std::atomic<const AnimationPolicy*> m_animationPolicy;
+	bool m_mouseExtrasDrivePaws;
+	bool m_transitionsEnabled;
+	MouseOdometer m_mouseOdometer;
+	KeyRateMeter m_keyRate;
+	uint64_t m_lastInputTick;
+	InputLatency m_latency;
+	KeyStateSet m_keyState;
+	std::array<uint32_t, Configuration::KEY_CODE_COUNT> m_keyPressCounts;
 	std::unique_ptr<CatStateMachine> m_stateMachine;
 
 public:
@@ -19,20 +44,75 @@ public:
 
 	// Click state
 	int GetClickCount() const noexcept { return m_clickCount; }
-	void IncrementClickCount() noexcept { ++m_clickCount; }
+	int GetSessionClickCount() const noexcept { return m_sessionClickCount; }
+	void IncrementClickCount() noexcept { ++m_clickCount; ++m_sessionClickCount; }
 	void SetClickCount(int count) noexcept { m_clickCount = count; }
 
 	// Skin state
 	int GetCurrentSkin() const noexcept { return m_currentSkin; }
 	void SetCurrentSkin(int skin) noexcept { m_currentSkin = skin; }
+	// Worn accessories, bit n = accessory id n
+	uint32_t GetAccessories() const noexcept { return m_accessories; }
+	void SetAccessories(uint32_t accessories) noexcept { m_accessories = accessories; }
+	// Recoloring applied to every skin
+	const ColorTransform::Tint& GetTint() const noexcept { return m_tint; }
+	void SetTint(const ColorTransform::Tint& tint) noexcept { m_tint = tint; }
+	// FrameOutline style drawn around every skin
+	int GetOutline() const noexcept { return m_outline; }
+	void SetOutline(int outline) noexcept { m_outline = outline; }
+	// Click counter drawn on the cat (Configuration::COUNTER_*)
+	int GetCounterMode() const noexcept { return m_counterMode; }
+	void SetCounterMode(int mode) noexcept { m_counterMode = mode; }
+	// Window scale in percent, or Configuration::SCALE_AUTO to follow monitor DPI
+	int GetScale() const noexcept { return m_scale; }
+	void SetScale(int scale) noexcept { m_scale = scale; }
 
-	// Input state
-	bool IsKeyPressed() const noexcept { return m_isKeyPressed; }
-	void SetKeyPressed(bool pressed) noexcept { m_isKeyPressed = pressed; }
+	// Input state (per virtual-key; fresh presses are counted for the heatmap)
+	bool PressKey(uint8_t key) noexcept {
+		const bool fresh = m_keyState.Press(key);
+		m_keyPressCounts[key] += fresh ? 1u : 0u;
+		return fresh;
+	}
+	void ReleaseKey(uint8_t key) noexcept { m_keyState.Release(key); }
+	bool IsKeyDown(uint8_t key) const noexcept { return m_keyState.IsDown(key); }
+	bool IsAnyKeyDown() const noexcept { return m_keyState.AnyDown(); }
+	void ClearKeyState() noexcept { m_keyState.Clear(); }
+
+	// Input activity (tick values from GetTickCount64)
+	KeyRateMeter& GetKeyRate() noexcept { return m_keyRate; }
+	uint64_t GetLastInputTick() const noexcept { return m_lastInputTick; }
+	void SetLastInputTick(uint64_t tick) noexcept { m_lastInputTick = tick; }
+
+	// Input-to-present latency (recorded on the UI thread)
+	InputLatency& GetLatency() noexcept { return m_latency; }
+	const InputLatency& GetLatency() const noexcept { return m_latency; }
+
+	// Key heatmap
+	const std::array<uint32_t, Configuration::KEY_CODE_COUNT>& GetKeyPressCounts() const noexcept { return m_keyPressCounts; }
+	void SetKeyPressCounts(const std::array<uint32_t, Configuration::KEY_CODE_COUNT>& counts) noexcept { m_keyPressCounts = counts; }
+
+	// Mouse odometer (fed from the hook; read by the UI on demand)
+	MouseOdometer& GetMouseOdometer() noexcept { return m_mouseOdometer; }
+	const MouseOdometer& GetMouseOdometer() const noexcept { return m_mouseOdometer; }
+
+	// Whether wheel notches and X buttons also drive paws
+	bool GetMouseExtrasDrivePaws() const noexcept { return m_mouseExtrasDrivePaws; }
+	void SetMouseExtrasDrivePaws(bool enabled) noexcept { m_mouseExtrasDrivePaws = enabled; }
+
+	// Cross-fades between frames (off by default)
+	bool GetTransitionsEnabled() const noexcept { return m_transitionsEnabled; }
+	void SetTransitionsEnabled(bool enabled) noexcept { m_transitionsEnabled = enabled; }
 
 	// Visibility state
 	bool IsVisible() const noexcept { return m_isVisible; }
 	void SetVisible(bool visible) noexcept { m_isVisible = visible; }
+	// Shown but nobody can see it (locked session, fullscreen app in front)
+	bool IsOccluded() const noexcept { return m_isOccluded; }
+	void SetOccluded(bool occluded) noexcept { m_isOccluded = occluded; }
+
+	// Animation timing; swapped by pointer when the power source changes, never locked
+	const AnimationPolicy& GetAnimationPolicy() const noexcept { return *m_animationPolicy.load(std::memory_order_acquire); }
+	void SetAnimationPolicy(const AnimationPolicy& policy) noexcept { m_animationPolicy.store(&policy, std::memory_order_release); }
 
 	// Business logic
 	bool CanUnlockSkin(int skinId) const;
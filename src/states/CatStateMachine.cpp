@@ -1,5 +1,6 @@
 #include "CatStateMachine.h"
 #include "../utils/Configuration.h"
+#include "../utils/Metrics.h"
 #include <chrono>
 
 CatStateMachine::CatStateMachine(std::function<void(CatState)> onStateChanged,
@@ -26,8 +27,9 @@ void CatStateMachine::SetCurrentState(CatState state) {
 	}
 }
 
-void CatStateMachine::HandleEvent(StateEvent event) {
+void CatStateMachine::HandleEvent(StateEvent event, PawSide side) {
 	CatState currentState = m_currentState;
+	METRIC_INC(StateEvents);
 
 	// For input events, check if we should ignore rapid inputs
 	if (event == StateEvent::InputReceived) {
@@ -36,20 +38,31 @@ void CatStateMachine::HandleEvent(StateEvent event) {
 
 		// Ignore inputs that come too quickly (less than INPUT_DEBOUNCE_TIME ms apart)
 		if (timeSinceLastInput < Configuration::INPUT_DEBOUNCE_TIME) {
+			METRIC_INC(StateEventsDebounced);
 			return;
 		}
 
 		m_lastInputTime = nowMs;
+
+		// Sided keys pick their paw; PawSide::Any keeps alternating
+		if (side != PawSide::Any) {
+			m_nextPaw = (side == PawSide::Left) ? CatState::LeftPaw : CatState::RightPaw;
+		}
 	}
 
 	CatState nextState = getNextState(currentState, event);
 
 	if (nextState != currentState) {
 		SetCurrentState(nextState);
-		// Toggle the next paw AFTER transitioning on input, so first input uses current nextPaw
-		if (event == StateEvent::InputReceived) {
-			updateNextPaw();
-		}
+	}
+	else {
+		METRIC_INC(StateEventsCoalesced);
+	}
+
+	// Toggle the next paw AFTER handling input, so first input uses current nextPaw.
+	// Also runs when a sided key repeats the current paw, keeping Any inputs alternating.
+	if (event == StateEvent::InputReceived) {
+		updateNextPaw();
 	}
 }
 
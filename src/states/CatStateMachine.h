@@ -1,5 +1,6 @@
 #pragma once
 #include <functional>
+#include <cstdint>
 #include "../utils/Configuration.h"
 
 // Forward declaration
@@ -21,6 +22,13 @@ enum class StateEvent {
 	SkinChanged         // Skin was changed
 };
 
+// Which paw an input prefers (Any alternates)
+enum class PawSide : uint8_t {
+	Any,
+	Left,
+	Right
+};
+
 class CatStateMachine {
 private:
 	CatState m_currentState;
@@ -42,7 +50,7 @@ public:
 	void SetCurrentState(CatState state);
 
 	// Events
-	void HandleEvent(StateEvent event);
+	void HandleEvent(StateEvent event, PawSide side = PawSide::Any);
 
 	// Paw
 	CatState GetNextPaw() const noexcept { return m_nextPaw; }
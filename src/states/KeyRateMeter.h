@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+
+// Keys per minute over a sliding window of one-second buckets
+class KeyRateMeter {
+private:
+	static constexpr int BUCKET_COUNT = 60;
+	static constexpr uint64_t BUCKET_MS = 1000;
+
+	uint32_t m_buckets[BUCKET_COUNT];
+	uint64_t m_lastSecond;
+
+	// Zero buckets whose second fell out of the window since the last update
+	void Advance(uint64_t second) noexcept {
+		if (second <= m_lastSecond) return;
+		const uint64_t elapsed = second - m_lastSecond;
+		const uint64_t clear = elapsed < BUCKET_COUNT ? elapsed : BUCKET_COUNT;
+		for (uint64_t i = 1; i <= clear; ++i) {
+			m_buckets[(m_lastSecond + i) % BUCKET_COUNT] = 0;
+		}
+		m_lastSecond = second;
+	}
+
+public:
+	KeyRateMeter() noexcept : m_buckets{}, m_lastSecond(0) {}
+
+	void Record(uint64_t nowMs) noexcept {
+		const uint64_t second = nowMs / BUCKET_MS;
+		Advance(second);
+		++m_buckets[second % BUCKET_COUNT];
+	}
+
+	uint32_t GetPerMinute(uint64_t nowMs) noexcept {
+		Advance(nowMs / BUCKET_MS);
+		uint32_t total = 0;
+		for (uint32_t bucket : m_buckets) total += bucket;
+		return total;
+	}
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+
+// 256-bit key-down set indexed by virtual-key code
+class KeyStateSet {
+private:
+	uint64_t m_words[4];
+
+public:
+	KeyStateSet() noexcept : m_words{ 0, 0, 0, 0 } {}
+
+	// Marks the key down; true only on an up->down transition, so auto-repeat is filtered
+	bool Press(uint8_t key) noexcept {
+		uint64_t& word = m_words[key >> 6];
+		const uint64_t mask = uint64_t{ 1 } << (key & 63);
+		const uint64_t previous = word;
+		word = previous | mask;
+		return (previous & mask) == 0;
+	}
+
+	void Release(uint8_t key) noexcept {
+		m_words[key >> 6] &= ~(uint64_t{ 1 } << (key & 63));
+	}
+
+	bool IsDown(uint8_t key) const noexcept {
+		return ((m_words[key >> 6] >> (key & 63)) & 1) != 0;
+	}
+
+	bool AnyDown() const noexcept {
+		return (m_words[0] | m_words[1] | m_words[2] | m_words[3]) != 0;
+	}
+
+	void Clear() noexcept {
+		m_words[0] = m_words[1] = m_words[2] = m_words[3] = 0;
+	}
+};
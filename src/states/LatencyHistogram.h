@@ -0,0 +1,124 @@
+#pragma once
+#include <windows.h>
+#include <atomic>
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Log-linear latency histogram in microseconds (HDR style): 16 linear sub-buckets per
+// power of two, so any reported value is within ~6% of the truth. Fixed storage;
+// Record() is two relaxed atomic increments and never allocates or locks.
+class LatencyHistogram {
+private:
+	static constexpr int SUB_BITS = 4;
+	static constexpr int SUB_COUNT = 1 << SUB_BITS;
+	static constexpr int MAX_EXPONENT = 32; // values clamp just below 2^32 us (~71 min)
+	static constexpr int BUCKET_COUNT = SUB_COUNT + (MAX_EXPONENT - SUB_BITS) * SUB_COUNT;
+
+	std::atomic<uint32_t> m_buckets[BUCKET_COUNT];
+	std::atomic<uint64_t> m_count;
+
+	static int FloorLog2(uint32_t value) noexcept {
+#if defined(_MSC_VER)
+		unsigned long index = 0;
+		_BitScanReverse(&index, value);
+		return static_cast<int>(index);
+#else
+		return 31 - __builtin_clz(value);
+#endif
+	}
+
+	static int BucketIndex(uint64_t micros) noexcept {
+		const uint32_t value = micros < UINT32_MAX ? static_cast<uint32_t>(micros) : UINT32_MAX;
+		if (value < SUB_COUNT) return static_cast<int>(value);
+		const int exponent = FloorLog2(value);
+		const int sub = static_cast<int>(value >> (exponent - SUB_BITS)) & (SUB_COUNT - 1);
+		return SUB_COUNT + (exponent - SUB_BITS) * SUB_COUNT + sub;
+	}
+
+	// Largest value that lands in the bucket
+	static uint64_t BucketUpperBound(int index) noexcept {
+		if (index < SUB_COUNT) return static_cast<uint64_t>(index);
+		const int exponent = (index - SUB_COUNT) / SUB_COUNT + SUB_BITS;
+		const uint64_t sub = static_cast<uint64_t>((index - SUB_COUNT) % SUB_COUNT);
+		const uint64_t width = 1ull << (exponent - SUB_BITS);
+		return (1ull << exponent) + sub * width + width - 1;
+	}
+
+public:
+	LatencyHistogram() noexcept : m_buckets{}, m_count(0) {}
+
+	void Record(uint64_t micros) noexcept {
+		m_buckets[BucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+		m_count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	uint64_t GetCount() const noexcept { return m_count.load(std::memory_order_relaxed); }
+
+	// Quantile in [0, 1]; 0 when nothing was recorded
+	uint64_t GetPercentile(double quantile) const noexcept {
+		uint64_t total = 0;
+		for (const auto& bucket : m_buckets) total += bucket.load(std::memory_order_relaxed);
+		if (total == 0) return 0;
+		uint64_t rank = static_cast<uint64_t>(quantile * static_cast<double>(total) + 0.999999);
+		if (rank < 1) rank = 1;
+		uint64_t seen = 0;
+		for (int i = 0; i < BUCKET_COUNT; ++i) {
+			seen += m_buckets[i].load(std::memory_order_relaxed);
+			if (seen >= rank) return BucketUpperBound(i);
+		}
+		return BucketUpperBound(BUCKET_COUNT - 1);
+	}
+};
+
+// Stages between a physical input and the layered-window update it causes
+enum class LatencyStage : uint8_t {
+	HookToQueue,           // OS input timestamp -> hook notifies the window (millisecond clock)
+	QueueToStateMachine,   // hook notify -> window handles the event
+	StateMachineToPresent, // event handling -> UpdateLayeredWindow returned
+	InputToPresent,        // end to end
+	Count
+};
+
+// Hook-side timing carried with each input event
+struct InputTiming {
+	uint32_t hookStamp = 0;   // InputLatency::Stamp() in the hook
+	uint32_t hookDelayMs = 0; // hook entry minus the OS event time
+};
+
+// Per-stage histograms with a 32-bit QPC stamp that fits a message parameter on every target
+class InputLatency {
+private:
+	static constexpr size_t STAGE_COUNT = static_cast<size_t>(LatencyStage::Count);
+
+	LatencyHistogram m_stages[STAGE_COUNT];
+	uint64_t m_frequency;
+
+public:
+	InputLatency() noexcept : m_frequency(1) {
+		LARGE_INTEGER frequency = {};
+		if (QueryPerformanceFrequency(&frequency) && frequency.QuadPart > 0) {
+			m_frequency = static_cast<uint64_t>(frequency.QuadPart);
+		}
+	}
+
+	// Low 32 bits of QPC; differences stay valid for several minutes
+	static uint32_t Stamp() noexcept {
+		LARGE_INTEGER now = {};
+		QueryPerformanceCounter(&now);
+		return static_cast<uint32_t>(now.QuadPart);
+	}
+
+	uint64_t ElapsedMicros(uint32_t from, uint32_t to) const noexcept {
+		return static_cast<uint64_t>(static_cast<uint32_t>(to - from)) * 1000000ull / m_frequency;
+	}
+
+	void Record(LatencyStage stage, uint64_t micros) noexcept {
+		m_stages[static_cast<size_t>(stage)].Record(micros);
+	}
+
+	const LatencyHistogram& Get(LatencyStage stage) const noexcept {
+		return m_stages[static_cast<size_t>(stage)];
+	}
+};
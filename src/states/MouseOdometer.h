@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+
+// Cursor travel and wheel totals, accumulated on the hook side without UI wakeups.
+// Distance is kept in 24.8 fixed point so sub-pixel moves from high-polling-rate mice add up.
+class MouseOdometer {
+private:
+	static constexpr int FRACTION_BITS = 8;
+	// alpha-max-plus-beta-min hypot approximation (alpha ~0.960, beta ~0.398 in Q8), max error ~4%
+	static constexpr uint64_t HYPOT_ALPHA = 246;
+	static constexpr uint64_t HYPOT_BETA = 102;
+	static constexpr int WHEEL_NOTCH = 120; // WHEEL_DELTA
+
+	uint64_t m_distanceFixed;
+	uint64_t m_wheelNotches;
+	int m_wheelRemainder;
+	int m_lastX;
+	int m_lastY;
+	bool m_hasLast;
+
+public:
+	MouseOdometer() noexcept
+		: m_distanceFixed(0), m_wheelNotches(0), m_wheelRemainder(0)
+		, m_lastX(0), m_lastY(0), m_hasLast(false) {
+	}
+
+	void OnMove(int x, int y) noexcept {
+		const int dx = x - m_lastX;
+		const int dy = y - m_lastY;
+		const uint64_t ax = static_cast<uint64_t>(dx < 0 ? -dx : dx);
+		const uint64_t ay = static_cast<uint64_t>(dy < 0 ? -dy : dy);
+		const uint64_t hi = ax > ay ? ax : ay;
+		const uint64_t lo = ax > ay ? ay : ax;
+		// First sample only establishes the origin
+		m_distanceFixed += (hi * HYPOT_ALPHA + lo * HYPOT_BETA) & (0 - static_cast<uint64_t>(m_hasLast));
+		m_lastX = x;
+		m_lastY = y;
+		m_hasLast = true;
+	}
+
+	// Accumulates wheel travel (either axis); returns whole notches completed by this event
+	int OnWheel(int delta) noexcept {
+		m_wheelRemainder += delta < 0 ? -delta : delta;
+		const int notches = m_wheelRemainder / WHEEL_NOTCH;
+		m_wheelRemainder -= notches * WHEEL_NOTCH;
+		m_wheelNotches += static_cast<uint64_t>(notches);
+		return notches;
+	}
+
+	uint64_t GetDistancePixels() const noexcept { return m_distanceFixed >> FRACTION_BITS; }
+	uint64_t GetWheelNotches() const noexcept { return m_wheelNotches; }
+
+	void Restore(uint64_t distancePixels, uint64_t wheelNotches) noexcept {
+		m_distanceFixed = distancePixels << FRACTION_BITS;
+		m_wheelNotches = wheelNotches;
+	}
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "../utils/Configuration.h"
+
+// Cross-fade playback compiled into one flat array of frame indices. Each image pair that fades
+// owns a run of blended frames; playback shows one entry per present and then the target image.
+class TransitionTimeline {
+public:
+	struct Span {
+		uint16_t offset;
+		uint16_t length; // 0: hard cut
+	};
+
+private:
+	std::vector<uint8_t> m_frames;
+	std::array<Span, Configuration::NUMBER_IMAGES * Configuration::NUMBER_IMAGES> m_spans{};
+
+	static size_t Key(int from, int to) noexcept {
+		return static_cast<size_t>(from) * Configuration::NUMBER_IMAGES + static_cast<size_t>(to);
+	}
+	static bool IsImage(int index) noexcept {
+		return index >= 0 && index < Configuration::NUMBER_IMAGES;
+	}
+
+public:
+	void Clear() noexcept {
+		m_frames.clear();
+		m_spans.fill(Span{ 0, 0 });
+	}
+
+	// Frames are indices into the image manager's frame list, in playback order
+	void Add(int from, int to, const uint8_t* frames, size_t count) {
+		if (!IsImage(from) || !IsImage(to)) return;
+		m_spans[Key(from, to)] = Span{ static_cast<uint16_t>(m_frames.size()), static_cast<uint16_t>(count) };
+		m_frames.insert(m_frames.end(), frames, frames + count);
+	}
+
+	Span Find(int from, int to) const noexcept {
+		return (IsImage(from) && IsImage(to)) ? m_spans[Key(from, to)] : Span{ 0, 0 };
+	}
+
+	int FrameAt(const Span& span, int step) const noexcept {
+		return m_frames[static_cast<size_t>(span.offset) + static_cast<size_t>(step)];
+	}
+
+	// Ease-out cubic weight (of the target, out of 256) for blended frame `step` of `steps`
+	static int EaseOutWeight(int step, int steps) noexcept {
+		const double t = static_cast<double>(step + 1) / (steps + 1);
+		const double inverse = 1.0 - t;
+		return static_cast<int>((1.0 - inverse * inverse * inverse) * 256.0 + 0.5);
+	}
+};
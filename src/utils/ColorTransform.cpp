@@ -0,0 +1,171 @@
+#include "ColorTransform.h"
+#include <cmath>
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define BONGOCAT_COLOR_SSE2 1
+#endif
+
+namespace {
+	constexpr double PI = 3.14159265358979323846;
+	// Rec. 709 luma weights (R, G, B), as used by the SVG/CSS hue-rotate and saturate filters
+	constexpr double LUMA_R = 0.2126;
+	constexpr double LUMA_G = 0.7152;
+	constexpr double LUMA_B = 0.0722;
+
+	// Shadow and highlight colors (R, G, B) of each palette map
+	constexpr double PALETTES[ColorTransform::PALETTE_COUNT][2][3] = {
+		{ { 0, 0, 0 }, { 255, 255, 255 } },
+		{ { 46, 26, 12 }, { 255, 236, 196 } },  // sepia
+		{ { 10, 14, 46 }, { 168, 204, 255 } }   // midnight
+	};
+
+	// 3x4 affine transform over (R, G, B, A) in floating point
+	struct Affine {
+		double m[3][4];
+	};
+
+	Affine Multiply(const Affine& a, const Affine& b) {
+		// Alpha passes through, so b's implicit fourth row is (0, 0, 0, 1)
+		Affine out = {};
+		for (int r = 0; r < 3; ++r) {
+			for (int c = 0; c < 4; ++c) {
+				double sum = c == 3 ? a.m[r][3] : 0.0;
+				for (int k = 0; k < 3; ++k) sum += a.m[r][k] * b.m[k][c];
+				out.m[r][c] = sum;
+			}
+		}
+		return out;
+	}
+
+	Affine HueRotation(int degrees) {
+		const double c = std::cos(degrees * PI / 180.0);
+		const double s = std::sin(degrees * PI / 180.0);
+		return { {
+			{ LUMA_R + c * (1 - LUMA_R) - s * LUMA_R, LUMA_G - c * LUMA_G - s * LUMA_G, LUMA_B - c * LUMA_B + s * (1 - LUMA_B), 0 },
+			{ LUMA_R - c * LUMA_R + s * 0.143, LUMA_G + c * (1 - LUMA_G) + s * 0.140, LUMA_B - c * LUMA_B - s * 0.283, 0 },
+			{ LUMA_R - c * LUMA_R - s * (1 - LUMA_R), LUMA_G - c * LUMA_G + s * LUMA_G, LUMA_B + c * (1 - LUMA_B) + s * LUMA_B, 0 }
+		} };
+	}
+
+	Affine Saturation(int percent) {
+		const double s = percent / 100.0;
+		return { {
+			{ LUMA_R + (1 - LUMA_R) * s, LUMA_G - LUMA_G * s, LUMA_B - LUMA_B * s, 0 },
+			{ LUMA_R - LUMA_R * s, LUMA_G + (1 - LUMA_G) * s, LUMA_B - LUMA_B * s, 0 },
+			{ LUMA_R - LUMA_R * s, LUMA_G - LUMA_G * s, LUMA_B + (1 - LUMA_B) * s, 0 }
+		} };
+	}
+
+	// lerp(shadow, highlight, luma) on straight color is shadow * A + (highlight - shadow) * luma on premultiplied
+	Affine PaletteMap(int palette) {
+		Affine out = {};
+		for (int r = 0; r < 3; ++r) {
+			const double shadow = PALETTES[palette][0][r] / 255.0;
+			const double range = PALETTES[palette][1][r] / 255.0 - shadow;
+			out.m[r][0] = range * LUMA_R;
+			out.m[r][1] = range * LUMA_G;
+			out.m[r][2] = range * LUMA_B;
+			out.m[r][3] = shadow;
+		}
+		return out;
+	}
+
+	inline uint8_t ApplyRow(const int16_t* row, const uint8_t* pixel) {
+		// Same arithmetic as the SIMD path: 32-bit sum, round half up, clamp to [0, alpha]
+		const int32_t sum = row[0] * pixel[0] + row[1] * pixel[1] + row[2] * pixel[2] + row[3] * pixel[3];
+		int32_t value = (sum + (1 << (ColorTransform::COEFFICIENT_SHIFT - 1))) >> ColorTransform::COEFFICIENT_SHIFT;
+		if (value < 0) value = 0;
+		if (value > pixel[3]) value = pixel[3];
+		return static_cast<uint8_t>(value);
+	}
+
+#if BONGOCAT_COLOR_SSE2
+	// Two pixels as 16-bit lanes (B G R A B G R A) to two 32-bit pixels of transformed color, alpha kept
+	inline __m128i TransformPair(__m128i pixels, __m128i rowB, __m128i rowG, __m128i rowR, __m128i round) {
+		// madd leaves (B*b + G*g, R*r + A*a) per pixel; adding the swapped pair completes each dot product
+		__m128i b = _mm_madd_epi16(pixels, rowB);
+		__m128i g = _mm_madd_epi16(pixels, rowG);
+		__m128i r = _mm_madd_epi16(pixels, rowR);
+		b = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(b, _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 3, 0, 1))), round), ColorTransform::COEFFICIENT_SHIFT);
+		g = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(g, _mm_shuffle_epi32(g, _MM_SHUFFLE(2, 3, 0, 1))), round), ColorTransform::COEFFICIENT_SHIFT);
+		r = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(r, _mm_shuffle_epi32(r, _MM_SHUFFLE(2, 3, 0, 1))), round), ColorTransform::COEFFICIENT_SHIFT);
+		// Alpha of each pixel in lanes 1 and 3, next to its R
+		const __m128i alpha = _mm_srli_epi32(pixels, 16);
+		// b = (b0 b0 b1 b1) and so on; interleave back to (b0 g0 r0 a0) and (b1 g1 r1 a1)
+		const __m128i bg = _mm_unpacklo_epi32(b, g);                         // b0 g0 b0 g0
+		const __m128i bgHigh = _mm_unpackhi_epi32(b, g);                     // b1 g1 b1 g1
+		const __m128i ra = _mm_unpacklo_epi32(r, _mm_shuffle_epi32(alpha, _MM_SHUFFLE(3, 3, 1, 1)));     // r0 a0 r0 a0
+		const __m128i raHigh = _mm_unpackhi_epi32(r, _mm_shuffle_epi32(alpha, _MM_SHUFFLE(3, 3, 1, 1))); // r1 a1 r1 a1
+		return _mm_packs_epi32(_mm_unpacklo_epi64(bg, ra), _mm_unpacklo_epi64(bgHigh, raHigh));
+	}
+#endif
+}
+
+namespace ColorTransform {
+	bool IsValid(const Tint& tint) {
+		return tint.hue >= HUE_MIN && tint.hue <= HUE_MAX &&
+			tint.saturation >= 0 && tint.saturation <= SATURATION_MAX &&
+			tint.palette >= 0 && tint.palette < PALETTE_COUNT;
+	}
+
+	Matrix Build(const Tint& tint) {
+		Affine affine = Multiply(Saturation(tint.saturation), HueRotation(tint.hue));
+		if (tint.palette != PALETTE_NONE) affine = Multiply(PaletteMap(tint.palette), affine);
+
+		// Reorder RGB to the BGR memory layout and quantize
+		static const int ORDER[3] = { 2, 1, 0 };
+		Matrix matrix = {};
+		for (int r = 0; r < 3; ++r) {
+			for (int c = 0; c < 4; ++c) {
+				const double value = affine.m[ORDER[r]][c < 3 ? ORDER[c] : 3] * (1 << COEFFICIENT_SHIFT);
+				const double clamped = value < -32767.0 ? -32767.0 : (value > 32767.0 ? 32767.0 : value);
+				matrix.rows[r][c] = static_cast<int16_t>(std::lround(clamped));
+			}
+		}
+		return matrix;
+	}
+
+	void Apply(const Matrix& matrix, const uint8_t* in, uint8_t* out, size_t pixelCount) {
+		if (!in || !out) return;
+		size_t i = 0;
+#if BONGOCAT_COLOR_SSE2
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i round = _mm_set1_epi32(1 << (COEFFICIENT_SHIFT - 1));
+		const __m128i rowB = _mm_setr_epi16(matrix.rows[0][0], matrix.rows[0][1], matrix.rows[0][2], matrix.rows[0][3],
+			matrix.rows[0][0], matrix.rows[0][1], matrix.rows[0][2], matrix.rows[0][3]);
+		const __m128i rowG = _mm_setr_epi16(matrix.rows[1][0], matrix.rows[1][1], matrix.rows[1][2], matrix.rows[1][3],
+			matrix.rows[1][0], matrix.rows[1][1], matrix.rows[1][2], matrix.rows[1][3]);
+		const __m128i rowR = _mm_setr_epi16(matrix.rows[2][0], matrix.rows[2][1], matrix.rows[2][2], matrix.rows[2][3],
+			matrix.rows[2][0], matrix.rows[2][1], matrix.rows[2][2], matrix.rows[2][3]);
+		for (; i + 4 <= pixelCount; i += 4) {
+			const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 4));
+			// Transparent pixels stay transparent: every color is clamped to alpha = 0
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(source, zero)) == 0xFFFF) {
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4), zero);
+				continue;
+			}
+			const __m128i low = _mm_unpacklo_epi8(source, zero);
+			const __m128i high = _mm_unpackhi_epi8(source, zero);
+			__m128i lowOut = TransformPair(low, rowB, rowG, rowR, round);
+			__m128i highOut = TransformPair(high, rowB, rowG, rowR, round);
+			// Clamp to [0, alpha] per pixel
+			const __m128i lowAlpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(low, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+			const __m128i highAlpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(high, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+			lowOut = _mm_min_epi16(_mm_max_epi16(lowOut, zero), lowAlpha);
+			highOut = _mm_min_epi16(_mm_max_epi16(highOut, zero), highAlpha);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4), _mm_packus_epi16(lowOut, highOut));
+		}
+#endif
+		for (; i < pixelCount; ++i) {
+			const uint8_t* pixel = in + i * 4;
+			uint8_t* target = out + i * 4;
+			const uint8_t b = ApplyRow(matrix.rows[0], pixel);
+			const uint8_t g = ApplyRow(matrix.rows[1], pixel);
+			const uint8_t r = ApplyRow(matrix.rows[2], pixel);
+			target[3] = pixel[3];
+			target[0] = b;
+			target[1] = g;
+			target[2] = r;
+		}
+	}
+}
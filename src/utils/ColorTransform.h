@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Skin recoloring: hue rotation, saturation and a palette map folded into one affine transform.
+// Every step is linear in (B, G, R, A), so it applies to premultiplied pixels as they are.
+namespace ColorTransform {
+	// Palette maps are two-color gradient maps over luminance (shadows to highlights)
+	constexpr int PALETTE_NONE = 0;
+	constexpr int PALETTE_SEPIA = 1;
+	constexpr int PALETTE_MIDNIGHT = 2;
+	constexpr int PALETTE_COUNT = 3;
+
+	constexpr int HUE_MIN = -180;
+	constexpr int HUE_MAX = 180;
+	constexpr int SATURATION_MAX = 200;
+
+	struct Tint {
+		int hue = 0;          // degrees
+		int saturation = 100; // percent; 0 is grayscale
+		int palette = PALETTE_NONE;
+
+		bool IsIdentity() const noexcept { return hue == 0 && saturation == 100 && palette == PALETTE_NONE; }
+		bool operator==(const Tint& other) const noexcept {
+			return hue == other.hue && saturation == other.saturation && palette == other.palette;
+		}
+		bool operator!=(const Tint& other) const noexcept { return !(*this == other); }
+	};
+
+	// Output B, G, R rows over input (B, G, R, A), fixed point with 1.0 = 1 << COEFFICIENT_SHIFT
+	constexpr int COEFFICIENT_SHIFT = 12;
+	struct Matrix {
+		int16_t rows[3][4];
+	};
+
+	bool IsValid(const Tint& tint);
+	Matrix Build(const Tint& tint);
+	// Color channels are clamped to [0, alpha] so the result stays premultiplied; alpha is copied.
+	// `in` and `out` may be the same buffer. The SIMD and scalar paths give identical bytes.
+	void Apply(const Matrix& matrix, const uint8_t* in, uint8_t* out, size_t pixelCount);
+}
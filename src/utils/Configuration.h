@@ -1,5 +1,7 @@
 #pragma once
 #include <windows.h>
+// Built-in skin table generated from img\skins\skins.csv by build\GenerateSkinRegistry.ps1
+#include "../../build/generated/SkinRegistry.h"
 
 namespace Configuration {
 	// ============================================================================
@@ -16,6 +18,20 @@ namespace Configuration {
 	constexpr int IMAGE_HEIGHT = 116;
 	constexpr int IMAGE_RIGHT_MARGIN = 450;
 	constexpr int IMAGE_BOTTOM_MARGIN = 80;
+
+	// Window scale in percent of IMAGE_WIDTH x IMAGE_HEIGHT
+	constexpr int SCALE_AUTO = 0; // follow the monitor's DPI
+	constexpr int SCALE_MIN_PERCENT = 50;
+	constexpr int SCALE_MAX_PERCENT = 400;
+	constexpr int SCALE_PRESET_COUNT = 4;
+	constexpr int SCALE_PRESETS[SCALE_PRESET_COUNT] = { 100, 125, 150, 200 };
+	constexpr size_t SCALED_FRAME_SET_CACHE = 4; // resampled sizes kept per skin
+
+	// Click counter drawn on the cat
+	constexpr int COUNTER_OFF = 0;
+	constexpr int COUNTER_TOTAL = 1;   // lifetime clicks
+	constexpr int COUNTER_SESSION = 2; // clicks since launch
+	constexpr int COUNTER_MODE_COUNT = 3;
 	constexpr int PLANES_COUNT = 1;
 	constexpr int BITS_PER_PIXEL = 32;
 	constexpr int BYTES_PER_PIXEL = BITS_PER_PIXEL / 8;
@@ -32,11 +48,24 @@ namespace Configuration {
 	constexpr int IMAGE_SWITCH_DELAY = 150;
 	constexpr int BLINK_INTERVAL = 8000;
 	constexpr int BLINK_DELAY = 200;
+	constexpr int IMAGE_RELEASE_GRACE = 30000; // Hidden this long: drop decoded frames
+	constexpr int PRESENCE_RECHECK_INTERVAL = 2000; // Fullscreen exit without a foreground change
+
+	// Power saver animation policy (battery or OS energy saver)
+	constexpr int POWER_SAVER_IMAGE_SWITCH_DELAY = 250;
+	constexpr int POWER_SAVER_BLINK_INTERVAL = 20000;
+	constexpr int POWER_SAVER_TIMER_TOLERANCE = 50;
+	constexpr int POWER_SAVER_MAX_FPS = 15;
+
+	// Present pacing when DWM reports no refresh timing
+	constexpr int PRESENT_FALLBACK_FPS = 60;
 
 	// Timer IDs
 	constexpr int ID_IMAGE_SWITCH_TIMER = 1;
 	constexpr int ID_TOPMOST_TIMER = 2;
 	constexpr int ID_BLINK_TIMER = 3;
+	constexpr int ID_RELEASE_IMAGES_TIMER = 4;
+	constexpr int ID_PRESENCE_TIMER = 5;
 
 	// ============================================================================
 	// MENU CONFIGURATION
@@ -47,14 +76,31 @@ namespace Configuration {
 	constexpr int ID_TRAY_CLOSE = 1002;
 	constexpr int ID_TRAY_HIDE = 1003;
 	constexpr int ID_TRAY_RESET_POSITION = 1004;
+	constexpr int ID_TRAY_EXPORT_HEATMAP = 1005;
+	constexpr int ID_TRAY_MOUSE_STATS = 1006;
+	constexpr int ID_TRAY_MOUSE_EXTRAS = 1007;
+	constexpr int ID_TRAY_LATENCY = 1008;
+	constexpr int ID_TRAY_SAVE_TRACE = 1009;
+	constexpr int ID_TRAY_TRANSITIONS = 1010;
+
+	// Tray skin menu IDs: built-in skins, then packs, one per skin id
+	constexpr int ID_TRAY_SKIN_FIRST = SkinRegistry::FIRST_MENU_ID;
 
-	// Tray skin menu IDs
-	constexpr int ID_TRAY_SKIN_MARSHMALLOW = 2000;
-	constexpr int ID_TRAY_SKIN_MOCHI = 2001;
-	constexpr int ID_TRAY_SKIN_TOFFEE = 2002;
-	constexpr int ID_TRAY_SKIN_HONEY = 2003;
-	constexpr int ID_TRAY_SKIN_LATTE = 2004;
-	constexpr int ID_TRAY_SKIN_TREACLE = 2005;
+	// Tray size menu IDs (presets follow AUTO in SCALE_PRESETS order)
+	constexpr int ID_TRAY_SIZE_AUTO = 3000;
+	constexpr int ID_TRAY_SIZE_PRESET_FIRST = 3001;
+
+	// Tray accessory menu IDs, one per accessory id
+	constexpr int ID_TRAY_ACCESSORY_FIRST = 4000;
+
+	// Tray color menu IDs, one per tint preset
+	constexpr int ID_TRAY_TINT_FIRST = 5000;
+
+	// Tray outline menu IDs, one per FrameOutline style
+	constexpr int ID_TRAY_OUTLINE_FIRST = 6000;
+
+	// Tray click counter menu IDs, one per COUNTER_* mode
+	constexpr int ID_TRAY_COUNTER_FIRST = 7000;
 
 	// ============================================================================
 	// DOMAIN CONSTANTS (merged from DomainConstants.h)
@@ -66,46 +112,78 @@ namespace Configuration {
 	constexpr int IMAGE_RIGHT_PAW = 2;
 	constexpr int IMAGE_BLINK = 3;
 
-	// Skins (domain identifiers)
-	constexpr int SKIN_COUNT = 6;
-	constexpr int SKIN_MARSHMALLOW = 0;
-	constexpr int SKIN_MOCHI = 1;
-	constexpr int SKIN_TOFFEE = 2;
-	constexpr int SKIN_HONEY = 3;
-	constexpr int SKIN_LATTE = 4;
-	constexpr int SKIN_TREACLE = 5;
-
-	// Unlock thresholds
-	constexpr int UNLOCK_MARSHMALLOW = 0;
-	constexpr int UNLOCK_MOCHI = 100;
-	constexpr int UNLOCK_TOFFEE = 1000;
-	constexpr int UNLOCK_HONEY = 10000;
-	constexpr int UNLOCK_LATTE = 100000;
-	constexpr int UNLOCK_TREACLE = 1000000;
-
-	// Unlock thresholds array for efficient lookup
-	constexpr int UNLOCK_THRESHOLDS[SKIN_COUNT] = {
-		UNLOCK_MARSHMALLOW, UNLOCK_MOCHI, UNLOCK_TOFFEE,
-		UNLOCK_HONEY, UNLOCK_LATTE, UNLOCK_TREACLE
+	// Optional cross-fades: blended frames shown one per display refresh before the target image
+	constexpr int CROSSFADE_STEPS = 3;
+	constexpr int CROSSFADE_PAIR_COUNT = 3;
+	constexpr int CROSSFADE_PAIRS[CROSSFADE_PAIR_COUNT][2] = {
+		{ IMAGE_LEFT_PAW, IMAGE_REST },  // paw presses stay hard cuts; only the release fades
+		{ IMAGE_RIGHT_PAW, IMAGE_REST },
+		{ IMAGE_BLINK, IMAGE_REST }
 	};
 
+	// Built-in skins: ids index SkinRegistry::SKINS; the first row is the default
+	constexpr int SKIN_COUNT = SkinRegistry::COUNT;
+	constexpr int SKIN_DEFAULT = 0;
+
+	// Skin packs on disk: %LOCALAPPDATA%\BongoCat\Skins\<folder>\ holding a manifest and one PNG per frame.
+	// Pack skin ids follow the built-in ones, ordered by folder name
+	constexpr LPCWSTR SKIN_PACK_DIRECTORY = L"BongoCat\\Skins";
+	constexpr LPCWSTR SKIN_PACK_MANIFEST = L"skin.ini";
+	constexpr LPCWSTR SKIN_PACK_FRAME_FILES[NUMBER_IMAGES] = { L"rest.png", L"left.png", L"right.png", L"blink.png" };
+	constexpr int SKIN_PACK_MAX = 16;
+	constexpr LONGLONG SKIN_PACK_MAX_FRAME_BYTES = 8 * 1024 * 1024;
+	constexpr LPCWSTR SKIN_PACK_CONTAINER_EXTENSION = L".bcskin"; // single-file pack, see SkinContainer.h
+	constexpr LONGLONG SKIN_PACK_MAX_CONTAINER_BYTES = 64 * 1024 * 1024;
+	constexpr DWORD SKIN_PACK_SETTLE_DELAY = 250; // Quiet period after a change before the folder is rescanned
+	constexpr DWORD SKIN_PACK_CHANGE_BUFFER = 16 * 1024;
+	// Accessories: transparent full-frame PNGs in <packs>\Accessories, worn over every frame of any skin.
+	// Accessory ids are file-name order; a worn set is a bitmask of ids
+	constexpr LPCWSTR SKIN_PACK_ACCESSORY_DIRECTORY = L"Accessories";
+	constexpr LPCWSTR SKIN_PACK_ACCESSORY_PATTERN = L"*.png";
+	constexpr int ACCESSORY_MAX = 16;
+	static_assert(ID_TRAY_SKIN_FIRST + SKIN_COUNT + SKIN_PACK_MAX <= ID_TRAY_SIZE_AUTO, "Skin menu IDs overlap the size menu");
+
+	// Decoded frame cache (%LOCALAPPDATA%\BongoCat\FrameCache); bump the version when decoding or scaling changes
+	constexpr LPCWSTR FRAME_CACHE_DIRECTORY = L"BongoCat\\FrameCache";
+	constexpr LPCWSTR FRAME_CACHE_EXTENSION = L".frames";
+	constexpr UINT FRAME_CACHE_VERSION = 2;
+	constexpr LONGLONG FRAME_CACHE_MAX_BYTES = 32 * 1024 * 1024;
+	constexpr LPCWSTR FRAME_CACHE_TEMPORARY_EXTENSION = L".tmp"; // FileIO::WriteAtomic's sibling files
+	constexpr ULONGLONG FRAME_CACHE_STALE_TEMPORARY_AGE = 10ull * 60 * 10000000; // 100 ns units; left by a crashed writer
+
 	// ============================================================================
 	// PLATFORM RESOURCE CONFIGURATION
 	// ============================================================================
-	// Skin resource base (platform resources)
-	constexpr int SKIN_BASE_RESOURCE_ID = 101;
-	constexpr int RESOURCES_PER_SKIN = NUMBER_IMAGES;
+	// Skin resources are numbered contiguously: one per frame, one skin after another
+	constexpr bool IsSkinRegistryContiguous() {
+		for (int skin = 0; skin < SkinRegistry::COUNT; ++skin) {
+			if (SkinRegistry::SKINS[skin].firstResourceId != SkinRegistry::FIRST_RESOURCE_ID + skin * NUMBER_IMAGES ||
+				SkinRegistry::SKINS[skin].menuId != ID_TRAY_SKIN_FIRST + skin ||
+				SkinRegistry::SKINS[skin].unlockThreshold < 0) {
+				return false;
+			}
+		}
+		return SkinRegistry::COUNT > 0 && SkinRegistry::SKINS[SKIN_DEFAULT].unlockThreshold == 0;
+	}
+	static_assert(IsSkinRegistryContiguous(), "SkinRegistry.h is out of date; rerun build\\GenerateSkinRegistry.ps1");
+
+	constexpr int GetSkinResourceId(int skin, int image) {
+		return SkinRegistry::SKINS[skin].firstResourceId + image;
+	}
 
 	// ============================================================================
 	// INPUT CONFIGURATION
 	// ============================================================================
 	constexpr int INPUT_DEBOUNCE_TIME = 60;
+	constexpr int KEY_CODE_COUNT = 256; // Virtual-key code space tracked per key
 
 	// ============================================================================
 	// WINDOW MESSAGES
 	// ============================================================================
 	constexpr UINT WM_APP_INPUT_EVENT = WM_APP + 1;
-	constexpr UINT WM_APP_SHOW_APP = WM_APP + 2;
+	constexpr UINT WM_APP_CONTROL = WM_APP + 2; // wParam: call count, lParam: ControlCall*
+	constexpr UINT WM_APP_PRESENT = WM_APP + 3; // paced present is due
+	constexpr UINT WM_APP_SKIN_PACKS = WM_APP + 4; // a rescanned skin pack catalog is ready
 	constexpr UINT WM_TRAYICON = WM_USER + 1;
 
 	// ============================================================================
@@ -114,8 +192,44 @@ namespace Configuration {
 	constexpr int TRAY_ICON_ID = 1;
 	constexpr LPCWSTR SINGLE_INSTANCE_MUTEX_NAME = L"Local\\BongoCat_SingleInstance";
 
+	// Local control channel (named pipe)
+	constexpr LPCWSTR CONTROL_PIPE_PREFIX = L"\\\\.\\pipe\\BongoCat.Control.";
+	constexpr DWORD CONTROL_PIPE_BUFFER_SIZE = 4096;
+	constexpr size_t CONTROL_PIPELINE_WINDOW = 32;
+	constexpr DWORD CONTROL_CONNECT_TIMEOUT = 2000;
+	constexpr DWORD CONTROL_CONNECT_RETRY_DELAY = 50;
+	constexpr DWORD CONTROL_CLIENT_IDLE_TIMEOUT = 2000; // a connected client that stalls this long is dropped
+
+	// Raw video stream (--stream)
+	constexpr int STREAM_DEFAULT_FPS = 60;
+	constexpr int STREAM_MAX_FPS = 240;
+	constexpr LPCWSTR STREAM_PIPE_PATH_PREFIX = L"\\\\.\\pipe\\";
+	constexpr DWORD STREAM_PIPE_BUFFER_SIZE = 128 * 1024; // more than one BGRA frame
+	constexpr DWORD STREAM_CANCEL_RETRY_DELAY = 20;
+
+	// Terminal renderer (--tty); the frame is scaled to this many columns, two pixels per cell
+	constexpr int TERMINAL_DEFAULT_COLUMNS = 60;
+	constexpr int TERMINAL_MIN_COLUMNS = 16;
+	constexpr int TERMINAL_MAX_COLUMNS = IMAGE_WIDTH;
+	constexpr DWORD TERMINAL_PIPE_BUFFER_SIZE = 64 * 1024; // more than a full paint at the default width
+
+	// Overlay HTTP server (--http), loopback only
+	constexpr int HTTP_PENDING_ACCEPTS = 8;
+	constexpr size_t HTTP_MAX_CONNECTIONS = 10000;
+	constexpr size_t HTTP_MAX_REQUEST_SIZE = 8192;
+	constexpr size_t HTTP_MAX_QUEUED_EVENT_BYTES = 16384;
+	constexpr int HTTP_RECEIVE_CHUNK = 4096;
+	constexpr DWORD HTTP_DRAIN_TIMEOUT = 1000;
+
 	// Registry keys (platform)
 	constexpr LPCWSTR REGISTRY_KEY = L"Software\\BongoCat";
 	constexpr LPCWSTR AUTOSTART_KEY = L"Software\\Microsoft\\Windows\\CurrentVersion\\Run";
 	constexpr LPCWSTR AUTOSTART_VALUE = L"BongoCat";
+
+	// Exports
+	constexpr LPCWSTR HEATMAP_FILE_NAME = L"BongoCat Key Heatmap.csv";
+	constexpr LPCWSTR TRACE_FILE_NAME = L"BongoCat Trace.json";
+
+	// Tracing: events kept per thread (power of two)
+	constexpr size_t TRACE_RING_EVENTS = 8192;
 }
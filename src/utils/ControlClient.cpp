@@ -0,0 +1,72 @@
+#include "ControlClient.h"
+#include "RAII/Handle.h"
+#include "Configuration.h"
+#include <string>
+
+namespace {
+	HANDLE ConnectWithRetry(const std::wstring& pipeName, DWORD connectTimeoutMs) {
+		const ULONGLONG deadline = GetTickCount64() + connectTimeoutMs;
+		for (;;) {
+			HANDLE pipe = CreateFileW(pipeName.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+			if (pipe != INVALID_HANDLE_VALUE) return pipe;
+
+			const DWORD error = GetLastError();
+			const ULONGLONG now = GetTickCount64();
+			if (now >= deadline) return INVALID_HANDLE_VALUE;
+			const DWORD remaining = static_cast<DWORD>(deadline - now);
+
+			if (error == ERROR_PIPE_BUSY) {
+				// Another client is being served; wait for the next instance
+				WaitNamedPipeW(pipeName.c_str(), remaining);
+			}
+			else if (error == ERROR_FILE_NOT_FOUND) {
+				// Server not created yet (instance still starting)
+				Sleep(remaining < Configuration::CONTROL_CONNECT_RETRY_DELAY ? remaining : Configuration::CONTROL_CONNECT_RETRY_DELAY);
+			}
+			else {
+				return INVALID_HANDLE_VALUE;
+			}
+		}
+	}
+
+	bool WriteAll(HANDLE pipe, const void* data, DWORD size) {
+		const BYTE* bytes = static_cast<const BYTE*>(data);
+		while (size > 0) {
+			DWORD written = 0;
+			if (!WriteFile(pipe, bytes, size, &written, nullptr) || written == 0) return false;
+			bytes += written;
+			size -= written;
+		}
+		return true;
+	}
+
+	bool ReadAll(HANDLE pipe, void* data, DWORD size) {
+		BYTE* bytes = static_cast<BYTE*>(data);
+		while (size > 0) {
+			DWORD read = 0;
+			if (!ReadFile(pipe, bytes, size, &read, nullptr) || read == 0) return false;
+			bytes += read;
+			size -= read;
+		}
+		return true;
+	}
+}
+
+bool ControlClient::Send(const ControlProtocol::Request* requests, size_t count,
+	ControlProtocol::Response* responses, DWORD connectTimeoutMs) {
+	if (!requests || !responses || count == 0) return false;
+
+	HANDLE rawPipe = ConnectWithRetry(ControlProtocol::GetPipeName(), connectTimeoutMs);
+	if (rawPipe == INVALID_HANDLE_VALUE) return false;
+	HandleWrapper pipe(rawPipe, true);
+
+	// Pipeline a window of requests before reading its replies. The window keeps the replies
+	// within the pipe buffer, so neither side can block writing while the other is too.
+	for (size_t offset = 0; offset < count; offset += Configuration::CONTROL_PIPELINE_WINDOW) {
+		const size_t batch = (count - offset < Configuration::CONTROL_PIPELINE_WINDOW)
+			? count - offset : Configuration::CONTROL_PIPELINE_WINDOW;
+		if (!WriteAll(pipe.get(), requests + offset, static_cast<DWORD>(batch * sizeof(ControlProtocol::Request)))) return false;
+		if (!ReadAll(pipe.get(), responses + offset, static_cast<DWORD>(batch * sizeof(ControlProtocol::Response)))) return false;
+	}
+	return true;
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include <windows.h>
+#include <cstddef>
+#include "ControlProtocol.h"
+
+// Client side of the local control channel
+class ControlClient {
+public:
+	// Writes all requests on one connection, then reads one response per request in order.
+	// Retries while the server is starting or busy, up to connectTimeoutMs.
+	static bool Send(const ControlProtocol::Request* requests, size_t count,
+		ControlProtocol::Response* responses, DWORD connectTimeoutMs);
+};
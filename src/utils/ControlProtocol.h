@@ -0,0 +1,95 @@
+#pragma once
+#include <windows.h>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include "Configuration.h"
+
+// Binary wire format of the local control channel. Requests and responses are fixed-size
+// records, so a client may write several requests back to back and read the replies in order.
+namespace ControlProtocol {
+	constexpr uint8_t VERSION = 1;
+	constexpr size_t VALUE_COUNT = 12;
+
+	enum class Command : uint8_t {
+		Show = 1,
+		Hide = 2,
+		SetSkin = 3,        // argument: skin id
+		ResetPosition = 4,
+		QueryStats = 5,     // values: see StatsValue
+		QueryMetrics = 6,   // values: Metrics counters, then gauges
+		QueryLatency = 7,   // values: p50/p99/p99.9 in microseconds per LatencyStage
+		SaveTrace = 8,      // writes the trace file next to the heatmap export
+		SetAccessories = 9  // argument: worn set, bit n = accessory id n; value: the set now worn
+	};
+
+	enum class Status : uint8_t {
+		Ok = 0,
+		UnknownCommand = 1,
+		InvalidArgument = 2,
+		UnsupportedVersion = 3,
+		Unavailable = 4
+	};
+
+	// Value slots filled by Command::QueryStats
+	enum StatsValue : size_t {
+		STATS_CLICKS = 0,
+		STATS_SKIN = 1,
+		STATS_VISIBLE = 2,
+		STATS_MOUSE_DISTANCE_PX = 3,
+		STATS_WHEEL_NOTCHES = 4,
+		STATS_KEY_PRESSES = 5,
+		STATS_ACCESSORIES = 6 // worn set, as for SetAccessories
+	};
+	static_assert(Configuration::ACCESSORY_MAX <= 31, "An accessory set must fit a non-negative argument");
+
+	// Command::QueryLatency: values[stage * 3 + percentile]
+	constexpr size_t LATENCY_STAGE_COUNT = 4;
+	enum LatencyValue : size_t {
+		LATENCY_P50 = 0,
+		LATENCY_P99 = 1,
+		LATENCY_P999 = 2
+	};
+
+#pragma pack(push, 1)
+	struct Request {
+		uint8_t version;
+		uint8_t command;
+		uint16_t reserved;
+		int32_t argument;
+	};
+
+	struct Response {
+		uint8_t version;
+		uint8_t command;
+		uint8_t status;
+		uint8_t reserved;
+		int32_t value;
+		uint64_t values[VALUE_COUNT];
+	};
+#pragma pack(pop)
+
+	static_assert(sizeof(Request) == 8, "Request is part of the wire format");
+	static_assert(sizeof(Response) == 8 + 8 * VALUE_COUNT, "Response is part of the wire format");
+
+	// Per-session pipe name, matching the scope of the Local\ single-instance mutex
+	inline std::wstring GetPipeName() {
+		DWORD sessionId = 0;
+		ProcessIdToSessionId(GetCurrentProcessId(), &sessionId);
+		return std::wstring(Configuration::CONTROL_PIPE_PREFIX) + std::to_wstring(sessionId);
+	}
+
+	inline Request MakeRequest(Command command, int32_t argument = 0) {
+		Request request{};
+		request.version = VERSION;
+		request.command = static_cast<uint8_t>(command);
+		request.argument = argument;
+		return request;
+	}
+}
+
+// One request/response pair marshalled to the UI thread
+struct ControlCall {
+	ControlProtocol::Request request;
+	ControlProtocol::Response response;
+};
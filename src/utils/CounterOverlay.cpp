@@ -0,0 +1,196 @@
+#include "CounterOverlay.h"
+#include <cstring>
+#include "Configuration.h"
+#include "FrameBlend.h"
+#include "FrameOutline.h"
+
+bool CounterOverlay::Prepare(SIZE frameSize) {
+	if (m_surfaceBits && frameSize.cx == m_size.cx && frameSize.cy == m_size.cy) return true;
+	Release();
+	if (frameSize.cx <= 0 || frameSize.cy <= 0) return false;
+	m_size = frameSize;
+
+	BITMAPINFO bmi = {};
+	bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+	bmi.bmiHeader.biWidth = m_size.cx;
+	bmi.bmiHeader.biHeight = -m_size.cy; // top-down DIB
+	bmi.bmiHeader.biPlanes = Configuration::PLANES_COUNT;
+	bmi.bmiHeader.biBitCount = Configuration::BITS_PER_PIXEL;
+	bmi.bmiHeader.biCompression = BI_RGB;
+	void* bits = nullptr;
+	HBITMAP surface = CreateDIBSection(nullptr, &bmi, DIB_RGB_COLORS, &bits, nullptr, 0);
+	if (!surface) return false;
+	m_surface = BitmapWrapper(surface, true);
+	m_surfaceBits = static_cast<BYTE*>(bits);
+	if (!m_surfaceBits || !RasterizeAtlas()) {
+		Release();
+		return false;
+	}
+	return true;
+}
+
+void CounterOverlay::Release() {
+	m_surface = BitmapWrapper();
+	m_surfaceBits = nullptr;
+	m_size = { 0, 0 };
+	m_atlas.clear();
+	m_atlas.shrink_to_fit();
+	m_cellWidth = 0;
+	m_cellHeight = 0;
+	m_frame = nullptr;
+	m_region = { 0, 0, 0, 0 };
+}
+
+bool CounterOverlay::RasterizeAtlas() {
+	DeviceContextWrapper dc(CreateCompatibleDC(nullptr), true);
+	if (!dc.get()) return false;
+	int em = MulDiv(m_size.cy, FONT_PERCENT, 100);
+	if (em < FONT_MIN_PIXELS) em = FONT_MIN_PIXELS;
+	// Grayscale antialiasing: the coverage is read back as alpha, which ClearType's colored fringes would break
+	FontWrapper font(CreateFontW(-em, 0, 0, 0, FW_BOLD, FALSE, FALSE, FALSE, DEFAULT_CHARSET, OUT_DEFAULT_PRECIS,
+		CLIP_DEFAULT_PRECIS, ANTIALIASED_QUALITY, DEFAULT_PITCH | FF_SWISS, L"Segoe UI"), true);
+	if (!font.get()) return false;
+	SelectedObjectWrapper selectFont(dc.get(), font.get());
+	if (!selectFont.IsSelected()) return false;
+
+	TEXTMETRICW metrics = {};
+	if (!GetTextMetricsW(dc.get(), &metrics)) return false;
+	int digitWidth = 0;
+	for (wchar_t digit = L'0'; digit <= L'9'; ++digit) {
+		SIZE extent = {};
+		if (!GetTextExtentPoint32W(dc.get(), &digit, 1, &extent)) return false;
+		if (extent.cx > digitWidth) digitWidth = extent.cx;
+	}
+	// Room for the outline on every side; digits sit between the baseline and the top of the internal leading
+	const int pad = FrameOutline::OUTLINE_RADIUS;
+	m_cellWidth = digitWidth + 2 * pad;
+	m_cellHeight = metrics.tmAscent - metrics.tmInternalLeading + 2 * pad;
+	const int atlasWidth = m_cellWidth * 10;
+
+	BITMAPINFO bmi = {};
+	bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+	bmi.bmiHeader.biWidth = atlasWidth;
+	bmi.bmiHeader.biHeight = -m_cellHeight;
+	bmi.bmiHeader.biPlanes = Configuration::PLANES_COUNT;
+	bmi.bmiHeader.biBitCount = Configuration::BITS_PER_PIXEL;
+	bmi.bmiHeader.biCompression = BI_RGB;
+	void* bits = nullptr;
+	BitmapWrapper glyphs(CreateDIBSection(nullptr, &bmi, DIB_RGB_COLORS, &bits, nullptr, 0), true);
+	if (!glyphs.get() || !bits) return false;
+	const size_t pixelCount = static_cast<size_t>(atlasWidth) * m_cellHeight;
+	memset(bits, 0, pixelCount * Configuration::BYTES_PER_PIXEL);
+	{
+		SelectedObjectWrapper selectGlyphs(dc.get(), glyphs.get());
+		if (!selectGlyphs.IsSelected()) return false;
+		SetTextColor(dc.get(), RGB(255, 255, 255));
+		SetBkMode(dc.get(), TRANSPARENT);
+		for (int d = 0; d < 10; ++d) {
+			const wchar_t digit = static_cast<wchar_t>(L'0' + d);
+			TextOutW(dc.get(), d * m_cellWidth + pad, pad - metrics.tmInternalLeading, &digit, 1);
+		}
+		GdiFlush();
+	}
+
+	// White-on-black coverage becomes dark premultiplied digits, then the outline goes beneath them
+	const BYTE* coverage = static_cast<const BYTE*>(bits);
+	m_atlas.resize(pixelCount * Configuration::BYTES_PER_PIXEL);
+	for (size_t i = 0; i < pixelCount; ++i) {
+		const uint32_t alpha = coverage[i * 4 + 1];
+		const uint8_t shade = static_cast<uint8_t>((alpha * TEXT_SHADE + 127) / 255);
+		m_atlas[i * 4 + 0] = shade;
+		m_atlas[i * 4 + 1] = shade;
+		m_atlas[i * 4 + 2] = shade;
+		m_atlas[i * 4 + 3] = static_cast<uint8_t>(alpha);
+	}
+	FrameOutline::Apply(FrameOutline::STYLE_OUTLINE, m_atlas.data(), atlasWidth, m_cellHeight);
+	return true;
+}
+
+int CounterOverlay::FormatCount(uint32_t count, char (&digits)[DIGITS_MAX]) noexcept {
+	char reversed[DIGITS_MAX];
+	int length = 0;
+	do {
+		reversed[length++] = static_cast<char>('0' + count % 10);
+		count /= 10;
+	} while (count != 0);
+	for (int i = 0; i < length; ++i) {
+		digits[i] = reversed[length - 1 - i];
+	}
+	return length;
+}
+
+RECT CounterOverlay::Layout(int digitCount) const {
+	// Centered above the bottom edge, over the desk in the built-in art; wider than the frame overhangs both sides
+	const int width = digitCount * m_cellWidth;
+	RECT region;
+	region.left = (m_size.cx - width) / 2;
+	region.right = region.left + width;
+	region.bottom = m_size.cy - MulDiv(m_size.cy, BOTTOM_MARGIN_PERCENT, 100);
+	region.top = region.bottom - m_cellHeight;
+	return region;
+}
+
+void CounterOverlay::Stamp(const char* digits, int digitCount, const RECT& region, const RECT& clip) {
+	const size_t atlasStride = static_cast<size_t>(m_cellWidth) * 10;
+	const int top = region.top > clip.top ? region.top : clip.top;
+	const int bottom = region.bottom < clip.bottom ? region.bottom : clip.bottom;
+	for (int i = 0; i < digitCount; ++i) {
+		const int cellLeft = region.left + i * m_cellWidth;
+		const int left = cellLeft > clip.left ? cellLeft : clip.left;
+		const int right = cellLeft + m_cellWidth < clip.right ? cellLeft + m_cellWidth : clip.right;
+		if (left >= right) continue;
+		const size_t glyphX = static_cast<size_t>(digits[i] - '0') * m_cellWidth + (left - cellLeft);
+		for (int y = top; y < bottom; ++y) {
+			const uint8_t* glyph = m_atlas.data() + ((y - region.top) * atlasStride + glyphX) * Configuration::BYTES_PER_PIXEL;
+			uint8_t* out = m_surfaceBits + (static_cast<size_t>(y) * m_size.cx + left) * Configuration::BYTES_PER_PIXEL;
+			FrameBlend::Over(glyph, out, static_cast<size_t>(right - left));
+		}
+	}
+}
+
+HBITMAP CounterOverlay::Compose(HBITMAP frame, uint32_t count, const RECT* frameDamage, RECT& dirty) {
+	dirty = { 0, 0, 0, 0 };
+	if (!frame || !m_surfaceBits) return nullptr;
+	DIBSECTION section = {};
+	if (GetObjectW(frame, sizeof(section), &section) != sizeof(section) || !section.dsBm.bmBits
+		|| section.dsBm.bmBitsPixel != Configuration::BITS_PER_PIXEL || section.dsBmih.biHeight >= 0
+		|| section.dsBm.bmWidth != m_size.cx || section.dsBm.bmHeight != m_size.cy) {
+		return nullptr;
+	}
+	const BYTE* framePixels = static_cast<const BYTE*>(section.dsBm.bmBits);
+	const RECT bounds = { 0, 0, m_size.cx, m_size.cy };
+
+	char digits[DIGITS_MAX];
+	const int digitCount = FormatCount(count, digits);
+	const RECT region = Layout(digitCount);
+	RECT visible;
+	if (!IntersectRect(&visible, &region, &bounds)) visible = { 0, 0, 0, 0 };
+
+	if (frame != m_frame && (!m_frame || !frameDamage)) {
+		// Unknown contents: a plain copy, then only the digits are blended
+		memcpy(m_surfaceBits, framePixels, static_cast<size_t>(m_size.cx) * m_size.cy * Configuration::BYTES_PER_PIXEL);
+		dirty = bounds;
+	}
+	else if (frame != m_frame || count != m_count) {
+		// Put back what the frame change and the old digits touched, then stamp the new digits
+		UnionRect(&dirty, &m_region, &visible);
+		if (frame != m_frame) {
+			RECT damage;
+			if (!IntersectRect(&damage, frameDamage, &bounds)) damage = { 0, 0, 0, 0 };
+			UnionRect(&dirty, &dirty, &damage);
+		}
+		const size_t rowBytes = static_cast<size_t>(dirty.right - dirty.left) * Configuration::BYTES_PER_PIXEL;
+		for (int y = dirty.top; y < dirty.bottom; ++y) {
+			const size_t offset = (static_cast<size_t>(y) * m_size.cx + dirty.left) * Configuration::BYTES_PER_PIXEL;
+			memcpy(m_surfaceBits + offset, framePixels + offset, rowBytes);
+		}
+	}
+	else {
+		return m_surface.get();
+	}
+	Stamp(digits, digitCount, region, dirty);
+	m_frame = frame;
+	m_count = count;
+	m_region = visible;
+	return m_surface.get();
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <windows.h>
+#include <cstdint>
+#include <vector>
+#include "RAII/Gdi.h"
+
+// Click count drawn on the cat. Digits are rasterized once per frame size into a glyph atlas and
+// stamped onto a copy of the presented frame. When the caller knows where the new frame differs
+// from the last one, only that damage and the digit regions are restored, re-stamped and reported
+// as dirty. Compose allocates nothing.
+class CounterOverlay {
+public:
+	static constexpr int DIGITS_MAX = 10;           // 32-bit counts
+	static constexpr int FONT_PERCENT = 18;         // em size, percent of frame height
+	static constexpr int FONT_MIN_PIXELS = 8;
+	static constexpr int BOTTOM_MARGIN_PERCENT = 3; // gap below the digits, percent of frame height
+	static constexpr uint8_t TEXT_SHADE = 0x30;     // dark digits; the white outline keeps them legible on any fur
+
+private:
+	SIZE m_size = { 0, 0 };
+	BitmapWrapper m_surface;
+	BYTE* m_surfaceBits = nullptr;
+	// Premultiplied BGRA, the ten digits side by side
+	std::vector<uint8_t> m_atlas;
+	int m_cellWidth = 0;
+	int m_cellHeight = 0;
+	// What the surface currently holds
+	HBITMAP m_frame = nullptr;
+	uint32_t m_count = 0;
+	RECT m_region = { 0, 0, 0, 0 };
+
+	bool RasterizeAtlas();
+	RECT Layout(int digitCount) const;
+	void Stamp(const char* digits, int digitCount, const RECT& region, const RECT& clip);
+
+public:
+	CounterOverlay() = default;
+	CounterOverlay(const CounterOverlay&) = delete;
+	CounterOverlay& operator=(const CounterOverlay&) = delete;
+
+	// Builds the atlas and surface for a frame size; cheap when the size is unchanged
+	bool Prepare(SIZE frameSize);
+	// The next Compose copies the whole frame (frame bitmaps may be reused after a reload)
+	void Invalidate() noexcept { m_frame = nullptr; }
+	void Release();
+
+	// Surface holding `frame` with `count` drawn on it, or nullptr if the frame is not a
+	// top-down 32bpp DIB of the prepared size. `frameDamage` bounds where `frame` differs from the
+	// previously composed frame (nullptr if unknown). `dirty` is the area that changed (empty if none).
+	HBITMAP Compose(HBITMAP frame, uint32_t count, const RECT* frameDamage, RECT& dirty);
+
+	// Decimal digits of `count`, most significant first; returns how many were written
+	static int FormatCount(uint32_t count, char (&digits)[DIGITS_MAX]) noexcept;
+};
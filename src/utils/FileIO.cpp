@@ -0,0 +1,40 @@
+#include "FileIO.h"
+
+bool FileIO::MappedFile::Open(const std::wstring& path, ULONGLONG maxSize) {
+	HANDLE rawFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (rawFile == INVALID_HANDLE_VALUE) return false;
+	m_file = HandleWrapper(rawFile, true);
+
+	BY_HANDLE_FILE_INFORMATION info = {};
+	if (!GetFileInformationByHandle(m_file.get(), &info)) return false;
+	m_size = (static_cast<ULONGLONG>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+	m_writeTime = info.ftLastWriteTime;
+	if (m_size == 0 || m_size > maxSize) return false;
+
+	m_mapping = HandleWrapper(CreateFileMappingW(m_file.get(), nullptr, PAGE_READONLY, 0, 0, nullptr), true);
+	if (!m_mapping.isValid()) return false;
+	m_view = MappedViewWrapper(MapViewOfFile(m_mapping.get(), FILE_MAP_READ, 0, 0, 0), true);
+	return m_view.isValid();
+}
+
+bool FileIO::WriteAtomic(const std::wstring& path, const std::vector<uint8_t>& bytes) {
+	// Per-thread name: two writers of the same path never share a temporary
+	const std::wstring temporary = path + L"." + std::to_wstring(GetCurrentThreadId()) + L".tmp";
+	{
+		HANDLE rawFile = CreateFileW(temporary.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (rawFile == INVALID_HANDLE_VALUE) return false;
+		HandleWrapper file(rawFile, true);
+		DWORD written = 0;
+		if (!WriteFile(file.get(), bytes.data(), static_cast<DWORD>(bytes.size()), &written, nullptr) || written != bytes.size()) {
+			file = HandleWrapper();
+			DeleteFileW(temporary.c_str());
+			return false;
+		}
+	}
+	if (!MoveFileExW(temporary.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+		DeleteFileW(temporary.c_str());
+		return false;
+	}
+	return true;
+}
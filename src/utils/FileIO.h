@@ -0,0 +1,30 @@
+#pragma once
+#include <windows.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "RAII/Handle.h"
+
+// File helpers shared by skin packs and the frame cache
+namespace FileIO {
+	// Read-only view of a whole file; the mapping is the only copy of the bytes
+	class MappedFile {
+	private:
+		HandleWrapper m_file;
+		HandleWrapper m_mapping;
+		MappedViewWrapper m_view{ nullptr };
+		ULONGLONG m_size = 0;
+		FILETIME m_writeTime = {};
+
+	public:
+		// Fails for missing, empty or larger-than-maxSize files
+		bool Open(const std::wstring& path, ULONGLONG maxSize);
+
+		const BYTE* data() const { return static_cast<const BYTE*>(m_view.get()); }
+		ULONGLONG size() const noexcept { return m_size; }
+		const FILETIME& writeTime() const noexcept { return m_writeTime; }
+	};
+
+	// Writes a sibling temporary file and renames it over `path`, so readers never see a partial file
+	bool WriteAtomic(const std::wstring& path, const std::vector<uint8_t>& bytes);
+}
@@ -0,0 +1,83 @@
+#include "FrameBlend.h"
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define BONGOCAT_BLEND_SSE2 1
+#endif
+
+namespace {
+	// x * y / 255 rounded to nearest, exact for x, y <= 255
+	inline uint32_t MulDiv255(uint32_t x, uint32_t y) {
+		const uint32_t t = x * y + 128;
+		return (t + (t >> 8)) >> 8;
+	}
+}
+
+void FrameBlend::CrossFade(const uint8_t* from, const uint8_t* to, uint8_t* out, size_t pixelCount, int weight) {
+	if (!from || !to || !out) return;
+	if (weight < 0) weight = 0;
+	if (weight > WEIGHT_ONE) weight = WEIGHT_ONE;
+	const size_t count = pixelCount * 4;
+	size_t i = 0;
+#if BONGOCAT_BLEND_SSE2
+	// a * (256 - w) + b * w <= 255 * 256, so the sum fits unsigned 16 bits
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i weightFrom = _mm_set1_epi16(static_cast<short>(WEIGHT_ONE - weight));
+	const __m128i weightTo = _mm_set1_epi16(static_cast<short>(weight));
+	const __m128i round = _mm_set1_epi16(WEIGHT_ONE / 2);
+	for (; i + 16 <= count; i += 16) {
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from + i));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(to + i));
+		const __m128i lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(
+			_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), weightFrom),
+			_mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), weightTo)), round), 8);
+		const __m128i hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(
+			_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), weightFrom),
+			_mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), weightTo)), round), 8);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(lo, hi));
+	}
+#endif
+	for (; i < count; ++i) {
+		out[i] = static_cast<uint8_t>((from[i] * (WEIGHT_ONE - weight) + to[i] * weight + WEIGHT_ONE / 2) >> 8);
+	}
+}
+
+void FrameBlend::Over(const uint8_t* src, uint8_t* dst, size_t pixelCount) {
+	if (!src || !dst) return;
+	size_t i = 0;
+#if BONGOCAT_BLEND_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i full = _mm_set1_epi16(255);
+	const __m128i round = _mm_set1_epi16(128);
+	for (; i + 4 <= pixelCount; i += 4) {
+		const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+		// Fully transparent and fully opaque runs dominate accessory layers
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(s, zero)) == 0xFFFF) continue;
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(s, _mm_set1_epi32(0x00FFFFFF)), _mm_set1_epi8(-1))) == 0xFFFF) {
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), s);
+			continue;
+		}
+		const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i * 4));
+		// 255 - alpha in all four 16-bit lanes of each pixel
+		const __m128i sLo = _mm_unpacklo_epi8(s, zero);
+		const __m128i sHi = _mm_unpackhi_epi8(s, zero);
+		const __m128i invLo = _mm_sub_epi16(full, _mm_shufflehi_epi16(_mm_shufflelo_epi16(sLo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)));
+		const __m128i invHi = _mm_sub_epi16(full, _mm_shufflehi_epi16(_mm_shufflelo_epi16(sHi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)));
+		// Same rounding as MulDiv255; t <= 255 * 255 + 128 fits unsigned 16 bits
+		__m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), invLo), round);
+		__m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), invHi), round);
+		lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+		hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+		// Saturating so color above alpha in a malformed layer clamps instead of wrapping
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_adds_epu8(s, _mm_packus_epi16(lo, hi)));
+	}
+#endif
+	for (; i < pixelCount; ++i) {
+		const uint8_t* s = src + i * 4;
+		uint8_t* d = dst + i * 4;
+		const uint32_t inverse = 255u - s[3];
+		for (int c = 0; c < 4; ++c) {
+			const uint32_t value = s[c] + MulDiv255(d[c], inverse);
+			d[c] = static_cast<uint8_t>(value > 255u ? 255u : value);
+		}
+	}
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Pixel kernels for composing animation frames (premultiplied BGRA)
+namespace FrameBlend {
+	constexpr int WEIGHT_ONE = 256;
+
+	// out = from * (1 - w) + to * w, with w = weight / 256. Premultiplied input stays premultiplied.
+	void CrossFade(const uint8_t* from, const uint8_t* to, uint8_t* out, size_t pixelCount, int weight);
+
+	// Porter-Duff source over: dst = src + dst * (255 - src.alpha) / 255, rounded exactly.
+	// Both images premultiplied; the SIMD and scalar paths give identical bytes.
+	void Over(const uint8_t* src, uint8_t* dst, size_t pixelCount);
+}
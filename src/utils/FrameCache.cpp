@@ -0,0 +1,190 @@
+#include "FrameCache.h"
+#include "Configuration.h"
+#include "FileIO.h"
+#include "SkinContainer.h"
+#include <windows.h>
+#include <shlobj.h>
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+	std::mutex g_evictionMutex;
+
+	// Precedes the container; the checksum covers every byte after it
+	struct EntryHeader {
+		uint32_t magic;
+		uint32_t reserved;
+		uint64_t checksum;
+		uint8_t padding[SkinContainer::BLOCK_ALIGNMENT - 16]; // keeps the container's blocks aligned
+	};
+	static_assert(sizeof(EntryHeader) == SkinContainer::BLOCK_ALIGNMENT, "Entry header must preserve block alignment");
+	constexpr uint32_t ENTRY_MAGIC = 0x48434642; // "BFCH"
+
+	const std::wstring& GetCacheDirectory() {
+		static const std::wstring directory = [] {
+			PWSTR localAppData = nullptr;
+			if (FAILED(SHGetKnownFolderPath(FOLDERID_LocalAppData, 0, nullptr, &localAppData)) || !localAppData) {
+				if (localAppData) CoTaskMemFree(localAppData);
+				return std::wstring();
+			}
+			std::wstring path = localAppData;
+			CoTaskMemFree(localAppData);
+			path += L"\\";
+			path += Configuration::FRAME_CACHE_DIRECTORY;
+			const int created = SHCreateDirectoryExW(nullptr, path.c_str(), nullptr);
+			if (created != ERROR_SUCCESS && created != ERROR_ALREADY_EXISTS) return std::wstring();
+			return path;
+		}();
+		return directory;
+	}
+
+	std::wstring GetEntryPath(uint64_t key) {
+		wchar_t name[32] = { 0 };
+		swprintf_s(name, L"\\%016llx", static_cast<unsigned long long>(key));
+		return GetCacheDirectory() + name + Configuration::FRAME_CACHE_EXTENSION;
+	}
+
+	// Write time doubles as the last-use time for eviction
+	void Touch(const std::wstring& path) {
+		HANDLE file = CreateFileW(path.c_str(), FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+			nullptr, OPEN_EXISTING, 0, nullptr);
+		if (file == INVALID_HANDLE_VALUE) return;
+		HandleWrapper wrapper(file, true);
+		FILETIME now = {};
+		GetSystemTimeAsFileTime(&now);
+		SetFileTime(wrapper.get(), nullptr, nullptr, &now);
+	}
+
+	// Temporaries left by a crash match no entry name; old ones are deleted, fresh ones may still be written
+	void DeleteStaleTemporaries(const std::wstring& directory) {
+		FILETIME now = {};
+		GetSystemTimeAsFileTime(&now);
+		const ULONGLONG nowTicks = (static_cast<ULONGLONG>(now.dwHighDateTime) << 32) | now.dwLowDateTime;
+		WIN32_FIND_DATAW data = {};
+		const std::wstring pattern = directory + L"\\*" + Configuration::FRAME_CACHE_TEMPORARY_EXTENSION;
+		HANDLE find = FindFirstFileExW(pattern.c_str(), FindExInfoBasic, &data, FindExSearchNameMatch, nullptr, 0);
+		if (find == INVALID_HANDLE_VALUE) return;
+		do {
+			if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) continue;
+			const ULONGLONG written = (static_cast<ULONGLONG>(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+			if (nowTicks > written && nowTicks - written > Configuration::FRAME_CACHE_STALE_TEMPORARY_AGE) {
+				DeleteFileW((directory + L"\\" + data.cFileName).c_str());
+			}
+		} while (FindNextFileW(find, &data));
+		FindClose(find);
+	}
+
+	void Evict() {
+		struct Entry {
+			std::wstring name;
+			ULONGLONG size;
+			FILETIME lastUse;
+		};
+		std::lock_guard<std::mutex> lock(g_evictionMutex);
+		const std::wstring& directory = GetCacheDirectory();
+		DeleteStaleTemporaries(directory);
+		std::vector<Entry> entries;
+		ULONGLONG total = 0;
+		WIN32_FIND_DATAW data = {};
+		const std::wstring pattern = directory + L"\\*" + Configuration::FRAME_CACHE_EXTENSION;
+		HANDLE find = FindFirstFileExW(pattern.c_str(), FindExInfoBasic, &data, FindExSearchNameMatch, nullptr, 0);
+		if (find == INVALID_HANDLE_VALUE) return;
+		do {
+			if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) continue;
+			const ULONGLONG size = (static_cast<ULONGLONG>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+			entries.push_back({ data.cFileName, size, data.ftLastWriteTime });
+			total += size;
+		} while (FindNextFileW(find, &data));
+		FindClose(find);
+		if (total <= static_cast<ULONGLONG>(Configuration::FRAME_CACHE_MAX_BYTES)) return;
+
+		std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+			return CompareFileTime(&a.lastUse, &b.lastUse) < 0;
+		});
+		for (const Entry& entry : entries) {
+			if (total <= static_cast<ULONGLONG>(Configuration::FRAME_CACHE_MAX_BYTES)) break;
+			// An entry mapped by a reader is only marked for deletion; its view stays valid
+			if (DeleteFileW((directory + L"\\" + entry.name).c_str())) total -= entry.size;
+		}
+	}
+}
+
+uint64_t FrameCache::Hash(const void* data, size_t size, uint64_t seed) {
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	uint64_t hash = seed;
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+uint64_t FrameCache::Checksum(const void* data, size_t size) {
+	// Four independent multiply chains keep a warm start's verification well below its copy cost
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	uint64_t lanes[4] = { 14695981039346656037ull, 1469598103934665603ull, 9650029242287828579ull, 2870177450012600261ull };
+	const size_t blocks = size / 32;
+	for (size_t i = 0; i < blocks; ++i) {
+		for (int lane = 0; lane < 4; ++lane) {
+			uint64_t word;
+			memcpy(&word, bytes + i * 32 + lane * 8, sizeof(word));
+			lanes[lane] = (lanes[lane] ^ word) * 1099511628211ull;
+		}
+	}
+	uint64_t hash = Hash(lanes, sizeof(lanes), size);
+	return Hash(bytes + blocks * 32, size - blocks * 32, hash);
+}
+
+uint64_t FrameCache::MakeKey(uint64_t sourceHash, int width, int height, int frameCount, uint32_t variant) {
+	const uint32_t fields[5] = {
+		Configuration::FRAME_CACHE_VERSION, static_cast<uint32_t>(width), static_cast<uint32_t>(height),
+		static_cast<uint32_t>(frameCount), variant
+	};
+	return Hash(fields, sizeof(fields), sourceHash);
+}
+
+bool FrameCache::Load(uint64_t key, int width, int height, int frameCount, uint8_t* const* frames) {
+	if (GetCacheDirectory().empty() || !frames) return false;
+	const std::wstring path = GetEntryPath(key);
+	FileIO::MappedFile file;
+	if (!file.Open(path, static_cast<ULONGLONG>(Configuration::FRAME_CACHE_MAX_BYTES))) return false;
+
+	// A damaged entry of the right size would still parse; the checksum catches it
+	const size_t size = static_cast<size_t>(file.size());
+	if (size < sizeof(EntryHeader)) return false;
+	EntryHeader header;
+	memcpy(&header, file.data(), sizeof(header));
+	const BYTE* container = file.data() + sizeof(header);
+	const size_t containerSize = size - sizeof(header);
+	if (header.magic != ENTRY_MAGIC || header.checksum != Checksum(container, containerSize)) return false;
+
+	SkinContainer::View view;
+	if (!SkinContainer::Parse(container, containerSize, view) ||
+		view.header->width != width || view.header->height != height || view.header->frameCount != frameCount) {
+		return false;
+	}
+	for (int i = 0; i < frameCount; ++i) {
+		if (!frames[i] || !SkinContainer::DecodeFrame(view, i, frames[i])) return false;
+	}
+	Touch(path);
+	return true;
+}
+
+void FrameCache::Store(uint64_t key, int width, int height, int frameCount, const uint8_t* const* frames) {
+	if (GetCacheDirectory().empty()) return;
+	// Raw frames: a hit is then a straight copy out of the mapping
+	const std::vector<uint8_t> container = SkinContainer::Build(SkinContainer::Metadata(), width, height,
+		frames, frameCount, SkinContainer::Encoding::Raw);
+	if (container.empty()) return;
+	EntryHeader header = {};
+	header.magic = ENTRY_MAGIC;
+	header.checksum = Checksum(container.data(), container.size());
+	std::vector<uint8_t> bytes(sizeof(header) + container.size());
+	memcpy(bytes.data(), &header, sizeof(header));
+	memcpy(bytes.data() + sizeof(header), container.data(), container.size());
+	if (!FileIO::WriteAtomic(GetEntryPath(key), bytes)) return;
+	Evict();
+}
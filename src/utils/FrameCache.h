@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Decoded frame sets persisted under %LOCALAPPDATA%\BongoCat\FrameCache, so warm starts skip
+// PNG decoding and resampling. Entries are checksummed raw .bcskin containers named by their key, read
+// through a read-only mapping, written with a rename and evicted least recently used first
+// once the directory passes FRAME_CACHE_MAX_BYTES. Safe to call from any thread.
+namespace FrameCache {
+	// What a cached frame set was derived as; part of the key
+	enum Variant : uint32_t {
+		DecodedSkin = 0,      // a built-in skin's frames at native size
+		ScaledNearest = 1,    // every frame resampled to a window size
+		ScaledBilinear = 2,
+		PackFrame = 3,        // one pack PNG fitted to native size
+		PackFramePixelArt = 4
+	};
+
+	// 64-bit FNV-1a; chain calls through `seed` to hash several buffers
+	uint64_t Hash(const void* data, size_t size, uint64_t seed = 14695981039346656037ull);
+	// Faster FNV-style checksum for whole entries; not interchangeable with Hash
+	uint64_t Checksum(const void* data, size_t size);
+
+	// Key for a frame set derived from `sourceHash` at a size; `variant` tells apart filters and frame lists
+	uint64_t MakeKey(uint64_t sourceHash, int width, int height, int frameCount, uint32_t variant);
+
+	// Fills `frameCount` buffers of width * height BGRA; false on a miss or a damaged entry
+	bool Load(uint64_t key, int width, int height, int frameCount, uint8_t* const* frames);
+
+	// Best effort; a failed write only costs the next start a decode
+	void Store(uint64_t key, int width, int height, int frameCount, const uint8_t* const* frames);
+}
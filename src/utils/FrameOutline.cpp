@@ -0,0 +1,165 @@
+#include "FrameOutline.h"
+#include <cstring>
+#include <vector>
+#include "FrameBlend.h"
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define BONGOCAT_OUTLINE_SSE2 1
+#endif
+
+namespace {
+	// Alpha plane with `pad` transparent pixels on every side
+	struct AlphaPlane {
+		std::vector<uint8_t> values;
+		int stride;
+		int pad;
+	};
+
+	AlphaPlane ExtractAlpha(const uint8_t* pixels, int width, int height, int pad) {
+		AlphaPlane plane;
+		plane.pad = pad;
+		plane.stride = width + 2 * pad;
+		plane.values.assign(static_cast<size_t>(plane.stride) * (height + 2 * pad), 0);
+		for (int y = 0; y < height; ++y) {
+			const uint8_t* row = pixels + static_cast<size_t>(y) * width * 4;
+			uint8_t* out = plane.values.data() + static_cast<size_t>(y + pad) * plane.stride + pad;
+			for (int x = 0; x < width; ++x) {
+				out[x] = row[x * 4 + 3];
+			}
+		}
+		return plane;
+	}
+
+	// coverage(x, y) = max of alpha over the (2r+1)^2 square, as a row pass then a column pass
+	void Dilate(const AlphaPlane& plane, int width, int height, int radius, uint8_t* coverage) {
+		const int rows = height + 2 * plane.pad;
+		std::vector<uint8_t> horizontal(static_cast<size_t>(rows) * width);
+		for (int y = 0; y < rows; ++y) {
+			const uint8_t* in = plane.values.data() + static_cast<size_t>(y) * plane.stride + plane.pad - radius;
+			uint8_t* out = horizontal.data() + static_cast<size_t>(y) * width;
+			int x = 0;
+#if BONGOCAT_OUTLINE_SSE2
+			for (; x + 16 <= width; x += 16) {
+				__m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x));
+				for (int k = 1; k <= 2 * radius; ++k) {
+					value = _mm_max_epu8(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x + k)));
+				}
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), value);
+			}
+#endif
+			for (; x < width; ++x) {
+				uint8_t value = in[x];
+				for (int k = 1; k <= 2 * radius; ++k) {
+					if (in[x + k] > value) value = in[x + k];
+				}
+				out[x] = value;
+			}
+		}
+		for (int y = 0; y < height; ++y) {
+			const uint8_t* in = horizontal.data() + static_cast<size_t>(y + plane.pad - radius) * width;
+			uint8_t* out = coverage + static_cast<size_t>(y) * width;
+			int x = 0;
+#if BONGOCAT_OUTLINE_SSE2
+			for (; x + 16 <= width; x += 16) {
+				__m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x));
+				for (int k = 1; k <= 2 * radius; ++k) {
+					value = _mm_max_epu8(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + static_cast<size_t>(k) * width + x)));
+				}
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), value);
+			}
+#endif
+			for (; x < width; ++x) {
+				uint8_t value = in[x];
+				for (int k = 1; k <= 2 * radius; ++k) {
+					const uint8_t candidate = in[static_cast<size_t>(k) * width + x];
+					if (candidate > value) value = candidate;
+				}
+				out[x] = value;
+			}
+		}
+	}
+
+	// coverage(x, y) = alpha(x - offset, y - offset) blurred by [1 4 6 4 1] / 16 in each direction.
+	// Row sums stay <= 16 * 255 and column sums <= 256 * 255, so both passes fit unsigned 16 bits.
+	void BlurShifted(const AlphaPlane& plane, int width, int height, int offset, uint8_t* coverage) {
+		const int rows = height + 2 * plane.pad;
+		std::vector<uint16_t> horizontal(static_cast<size_t>(rows) * width);
+		for (int y = 0; y < rows; ++y) {
+			const uint8_t* in = plane.values.data() + static_cast<size_t>(y) * plane.stride + plane.pad - offset - FrameOutline::SHADOW_RADIUS;
+			uint16_t* out = horizontal.data() + static_cast<size_t>(y) * width;
+			int x = 0;
+#if BONGOCAT_OUTLINE_SSE2
+			const __m128i zero = _mm_setzero_si128();
+			for (; x + 8 <= width; x += 8) {
+				const __m128i a0 = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + x)), zero);
+				const __m128i a1 = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + x + 1)), zero);
+				const __m128i a2 = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + x + 2)), zero);
+				const __m128i a3 = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + x + 3)), zero);
+				const __m128i a4 = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + x + 4)), zero);
+				// a0 + a4 + 4 * (a1 + a3) + 6 * a2
+				__m128i sum = _mm_add_epi16(a0, a4);
+				sum = _mm_add_epi16(sum, _mm_slli_epi16(_mm_add_epi16(a1, a3), 2));
+				sum = _mm_add_epi16(sum, _mm_add_epi16(_mm_slli_epi16(a2, 2), _mm_slli_epi16(a2, 1)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), sum);
+			}
+#endif
+			for (; x < width; ++x) {
+				out[x] = static_cast<uint16_t>(in[x] + in[x + 4] + 4 * (in[x + 1] + in[x + 3]) + 6 * in[x + 2]);
+			}
+		}
+		for (int y = 0; y < height; ++y) {
+			const uint16_t* in = horizontal.data() + static_cast<size_t>(y + plane.pad - offset - FrameOutline::SHADOW_RADIUS) * width;
+			uint8_t* out = coverage + static_cast<size_t>(y) * width;
+			const size_t w = static_cast<size_t>(width);
+			int x = 0;
+#if BONGOCAT_OUTLINE_SSE2
+			const __m128i round = _mm_set1_epi16(128);
+			for (; x + 8 <= width; x += 8) {
+				const __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x));
+				const __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + w + x));
+				const __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * w + x));
+				const __m128i r3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 3 * w + x));
+				const __m128i r4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 4 * w + x));
+				__m128i sum = _mm_add_epi16(r0, r4);
+				sum = _mm_add_epi16(sum, _mm_slli_epi16(_mm_add_epi16(r1, r3), 2));
+				sum = _mm_add_epi16(sum, _mm_add_epi16(_mm_slli_epi16(r2, 2), _mm_slli_epi16(r2, 1)));
+				sum = _mm_srli_epi16(_mm_add_epi16(sum, round), 8);
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(out + x), _mm_packus_epi16(sum, sum));
+			}
+#endif
+			for (; x < width; ++x) {
+				const uint32_t sum = in[x] + in[4 * w + x] + 4u * (in[w + x] + in[3 * w + x]) + 6u * in[2 * w + x];
+				out[x] = static_cast<uint8_t>((sum + 128) >> 8);
+			}
+		}
+	}
+}
+
+void FrameOutline::Apply(int style, uint8_t* pixels, int width, int height) {
+	if (!pixels || width <= 0 || height <= 0 || style == STYLE_NONE || !IsValid(style)) return;
+	const size_t pixelCount = static_cast<size_t>(width) * height;
+	std::vector<uint8_t> coverage(pixelCount);
+	if (style == STYLE_OUTLINE) {
+		const AlphaPlane plane = ExtractAlpha(pixels, width, height, OUTLINE_RADIUS);
+		Dilate(plane, width, height, OUTLINE_RADIUS, coverage.data());
+	}
+	else {
+		const AlphaPlane plane = ExtractAlpha(pixels, width, height, SHADOW_OFFSET + SHADOW_RADIUS);
+		BlurShifted(plane, width, height, SHADOW_OFFSET, coverage.data());
+	}
+
+	// White outline, translucent black shadow; the frame is then drawn over it
+	std::vector<uint8_t> effect(pixelCount * 4);
+	for (size_t i = 0; i < pixelCount; ++i) {
+		const uint32_t c = coverage[i];
+		if (style == STYLE_OUTLINE) {
+			effect[i * 4 + 0] = effect[i * 4 + 1] = effect[i * 4 + 2] = effect[i * 4 + 3] = static_cast<uint8_t>(c);
+		}
+		else {
+			const uint32_t t = c * SHADOW_OPACITY + 128;
+			effect[i * 4 + 3] = static_cast<uint8_t>((t + (t >> 8)) >> 8);
+		}
+	}
+	FrameBlend::Over(pixels, effect.data(), pixelCount);
+	memcpy(pixels, effect.data(), pixelCount * 4);
+}
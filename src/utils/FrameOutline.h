@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Outline and drop shadow generated from a frame's alpha channel and drawn beneath it (premultiplied BGRA)
+namespace FrameOutline {
+	constexpr int STYLE_NONE = 0;
+	constexpr int STYLE_OUTLINE = 1;
+	constexpr int STYLE_SHADOW = 2;
+	constexpr int STYLE_COUNT = 3;
+
+	// The built-in art keeps a 4 px transparent margin; both effects stay inside it so the frame size is unchanged
+	constexpr int OUTLINE_RADIUS = 2;  // square dilation, in pixels
+	constexpr int SHADOW_OFFSET = 2;   // down and to the right, in pixels
+	constexpr int SHADOW_RADIUS = 2;   // 5-tap binomial blur
+	constexpr uint8_t SHADOW_OPACITY = 110;
+
+	inline bool IsValid(int style) noexcept { return style >= STYLE_NONE && style < STYLE_COUNT; }
+
+	// Draws the effect beneath the frame in place; pixels outside the frame count as transparent.
+	// The SIMD and scalar paths give identical bytes.
+	void Apply(int style, uint8_t* pixels, int width, int height);
+}
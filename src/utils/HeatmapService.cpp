@@ -0,0 +1,78 @@
+#include "HeatmapService.h"
+#include <windows.h>
+#include <shlobj.h>
+#include <string>
+#include <iterator>
+#include "RAII/Handle.h"
+
+namespace {
+	std::string ToUtf8(const std::wstring& text) {
+		if (text.empty()) return std::string();
+		int size = WideCharToMultiByte(CP_UTF8, 0, text.c_str(), static_cast<int>(text.size()), nullptr, 0, nullptr, nullptr);
+		if (size <= 0) return std::string();
+		std::string result(static_cast<size_t>(size), '\0');
+		WideCharToMultiByte(CP_UTF8, 0, text.c_str(), static_cast<int>(text.size()), &result[0], size, nullptr, nullptr);
+		return result;
+	}
+
+	std::wstring GetKeyDisplayName(UINT virtualKey) {
+		// GetKeyNameText expects the scan code in bits 16-23 of an lParam-style value
+		UINT scanCode = MapVirtualKeyW(virtualKey, MAPVK_VK_TO_VSC);
+		wchar_t name[64] = { 0 };
+		if (scanCode && GetKeyNameTextW(static_cast<LONG>(scanCode << 16), name, static_cast<int>(std::size(name))) > 0) {
+			return name;
+		}
+		wchar_t fallback[16] = { 0 };
+		swprintf_s(fallback, L"VK 0x%02X", virtualKey);
+		return fallback;
+	}
+
+	std::wstring QuoteCsv(const std::wstring& field) {
+		std::wstring quoted = L"\"";
+		for (wchar_t ch : field) {
+			if (ch == L'"') quoted += L'"';
+			quoted += ch;
+		}
+		quoted += L'"';
+		return quoted;
+	}
+}
+
+std::wstring HeatmapService::ExportCsv(const std::array<uint32_t, Configuration::KEY_CODE_COUNT>& counts) {
+	PWSTR documents = nullptr;
+	if (FAILED(SHGetKnownFolderPath(FOLDERID_Documents, 0, nullptr, &documents)) || !documents) {
+		if (documents) CoTaskMemFree(documents);
+		return L"";
+	}
+	std::wstring path = documents;
+	CoTaskMemFree(documents);
+	path += L"\\";
+	path += Configuration::HEATMAP_FILE_NAME;
+
+	std::wstring csv = L"VirtualKey,Key,Presses\r\n";
+	for (int key = 0; key < Configuration::KEY_CODE_COUNT; ++key) {
+		if (counts[key] == 0) continue;
+		wchar_t code[8] = { 0 };
+		swprintf_s(code, L"%d", key);
+		csv += code;
+		csv += L',';
+		csv += QuoteCsv(GetKeyDisplayName(static_cast<UINT>(key)));
+		csv += L',';
+		csv += std::to_wstring(counts[key]);
+		csv += L"\r\n";
+	}
+
+	// UTF-8 with BOM so spreadsheet apps detect the encoding
+	std::string bytes = "\xEF\xBB\xBF" + ToUtf8(csv);
+	HANDLE rawFile = CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+		FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (rawFile == INVALID_HANDLE_VALUE) return L"";
+	HandleWrapper file(rawFile, true);
+
+	DWORD written = 0;
+	if (!WriteFile(file.get(), bytes.data(), static_cast<DWORD>(bytes.size()), &written, nullptr)
+		|| written != bytes.size()) {
+		return L"";
+	}
+	return path;
+}
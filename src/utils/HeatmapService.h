@@ -0,0 +1,12 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include "Configuration.h"
+
+// Keyboard heatmap export
+class HeatmapService {
+public:
+	// Writes non-zero per-key press counts as CSV into Documents; returns the path or empty on failure
+	static std::wstring ExportCsv(const std::array<uint32_t, Configuration::KEY_CODE_COUNT>& counts);
+};
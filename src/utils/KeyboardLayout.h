@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include "../states/CatStateMachine.h"
+
+namespace KeyboardLayout {
+	// Index: set-1 scan code in the low 7 bits, 0x80 for E0-prefixed (extended) keys.
+	// Scan codes are position-based, so the split follows the physical board regardless of layout.
+	constexpr int SCAN_TABLE_SIZE = 256;
+	constexpr uint32_t EXTENDED_BIT = 0x80;
+
+	struct PawSideTable {
+		PawSide sides[SCAN_TABLE_SIZE];
+	};
+
+	constexpr void MarkRange(PawSideTable& table, uint32_t first, uint32_t last, PawSide side) {
+		for (uint32_t code = first; code <= last; ++code) {
+			table.sides[code] = side;
+		}
+	}
+
+	constexpr PawSideTable BuildPawSideTable() {
+		PawSideTable table{};
+		for (int i = 0; i < SCAN_TABLE_SIZE; ++i) {
+			table.sides[i] = PawSide::Any;
+		}
+		// Left half: Esc, `, 1-5, Tab, Q-T, Caps, A-G, LShift, ISO \, Z-B, LCtrl, LAlt, F1-F5, LWin
+		MarkRange(table, 0x01, 0x06, PawSide::Left);
+		MarkRange(table, 0x0F, 0x14, PawSide::Left);
+		MarkRange(table, 0x1D, 0x22, PawSide::Left);
+		MarkRange(table, 0x29, 0x2A, PawSide::Left);
+		MarkRange(table, 0x2C, 0x30, PawSide::Left);
+		MarkRange(table, 0x38, 0x38, PawSide::Left);
+		MarkRange(table, 0x3A, 0x3F, PawSide::Left);
+		MarkRange(table, 0x56, 0x56, PawSide::Left);
+		MarkRange(table, EXTENDED_BIT | 0x5B, EXTENDED_BIT | 0x5B, PawSide::Left);
+		// Right half: 6-0, -, =, Backspace, Y-], Enter, H-', \, N-/, RShift, F6-F12, numpad
+		MarkRange(table, 0x07, 0x0E, PawSide::Right);
+		MarkRange(table, 0x15, 0x1C, PawSide::Right);
+		MarkRange(table, 0x23, 0x28, PawSide::Right);
+		MarkRange(table, 0x2B, 0x2B, PawSide::Right);
+		MarkRange(table, 0x31, 0x37, PawSide::Right);
+		MarkRange(table, 0x40, 0x53, PawSide::Right);
+		MarkRange(table, 0x57, 0x58, PawSide::Right);
+		// Right half, extended: keypad Enter, RCtrl, keypad /, PrtSc, RAlt, navigation cluster, RWin, Menu
+		MarkRange(table, EXTENDED_BIT | 0x1C, EXTENDED_BIT | 0x1D, PawSide::Right);
+		MarkRange(table, EXTENDED_BIT | 0x35, EXTENDED_BIT | 0x35, PawSide::Right);
+		MarkRange(table, EXTENDED_BIT | 0x37, EXTENDED_BIT | 0x38, PawSide::Right);
+		MarkRange(table, EXTENDED_BIT | 0x47, EXTENDED_BIT | 0x53, PawSide::Right);
+		MarkRange(table, EXTENDED_BIT | 0x5C, EXTENDED_BIT | 0x5D, PawSide::Right);
+		return table;
+	}
+
+	constexpr PawSideTable PAW_SIDE_TABLE = BuildPawSideTable();
+
+	// Space, media keys and unknown codes map to PawSide::Any (alternate paws)
+	inline PawSide GetPawSide(uint32_t scanCode, bool extended) noexcept {
+		const uint32_t index = (scanCode & 0x7F) | (extended ? EXTENDED_BIT : 0);
+		return PAW_SIDE_TABLE.sides[index];
+	}
+}
@@ -0,0 +1,137 @@
+#include "Lz4.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+	constexpr size_t MIN_MATCH = 4;
+	constexpr size_t LAST_LITERALS = 5;   // a block always ends in at least this many literals
+	constexpr size_t MATCH_FIND_LIMIT = 12; // no match may start closer than this to the end
+	constexpr size_t MAX_OFFSET = 65535;
+	constexpr int HASH_BITS = 12;
+
+	uint32_t Read32(const uint8_t* p) {
+		uint32_t value;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	uint32_t Hash(uint32_t sequence) {
+		return (sequence * 2654435761u) >> (32 - HASH_BITS);
+	}
+
+	// Extra length bytes: runs of 255 then the remainder
+	bool WriteLength(size_t length, uint8_t*& op, const uint8_t* oend) {
+		for (; length >= 255; length -= 255) {
+			if (op >= oend) return false;
+			*op++ = 255;
+		}
+		if (op >= oend) return false;
+		*op++ = static_cast<uint8_t>(length);
+		return true;
+	}
+
+	bool WriteSequence(const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength,
+		uint8_t*& op, const uint8_t* oend) {
+		if (op >= oend) return false;
+		uint8_t* token = op++;
+		*token = static_cast<uint8_t>((literalLength >= 15 ? 15 : literalLength) << 4);
+		if (literalLength >= 15 && !WriteLength(literalLength - 15, op, oend)) return false;
+		if (static_cast<size_t>(oend - op) < literalLength) return false;
+		memcpy(op, literals, literalLength);
+		op += literalLength;
+		if (matchLength == 0) return true; // closing literals-only sequence
+
+		if (oend - op < 2) return false;
+		*op++ = static_cast<uint8_t>(offset);
+		*op++ = static_cast<uint8_t>(offset >> 8);
+		const size_t code = matchLength - MIN_MATCH;
+		*token |= static_cast<uint8_t>(code >= 15 ? 15 : code);
+		return code < 15 || WriteLength(code - 15, op, oend);
+	}
+
+	bool ReadLength(const uint8_t*& ip, const uint8_t* iend, size_t& length) {
+		uint8_t byte;
+		do {
+			if (ip >= iend) return false;
+			byte = *ip++;
+			length += byte;
+		} while (byte == 255);
+		return true;
+	}
+}
+
+size_t Lz4::Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity) {
+	if (!dst || (!src && srcSize)) return 0;
+	uint8_t* op = dst;
+	const uint8_t* oend = dst + dstCapacity;
+	size_t anchor = 0;
+
+	if (srcSize > MATCH_FIND_LIMIT) {
+		std::vector<int32_t> table(static_cast<size_t>(1) << HASH_BITS, -1);
+		const size_t matchStartLimit = srcSize - MATCH_FIND_LIMIT;
+		const size_t matchEndLimit = srcSize - LAST_LITERALS;
+		size_t i = 0;
+		while (i < matchStartLimit) {
+			const uint32_t sequence = Read32(src + i);
+			const uint32_t h = Hash(sequence);
+			const int32_t candidate = table[h];
+			table[h] = static_cast<int32_t>(i);
+			if (candidate < 0 || i - static_cast<size_t>(candidate) > MAX_OFFSET ||
+				Read32(src + candidate) != sequence) {
+				++i;
+				continue;
+			}
+			const size_t ref = static_cast<size_t>(candidate);
+			size_t length = MIN_MATCH;
+			while (i + length < matchEndLimit && src[ref + length] == src[i + length]) ++length;
+			if (!WriteSequence(src + anchor, i - anchor, i - ref, length, op, oend)) return 0;
+			i += length;
+			anchor = i;
+		}
+	}
+	if (!WriteSequence(src + anchor, srcSize - anchor, 0, 0, op, oend)) return 0;
+	return static_cast<size_t>(op - dst);
+}
+
+bool Lz4::Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+	if (!src || !dst) return false;
+	const uint8_t* ip = src;
+	const uint8_t* iend = src + srcSize;
+	uint8_t* op = dst;
+	uint8_t* const oend = dst + dstSize;
+
+	while (ip < iend) {
+		const uint8_t token = *ip++;
+		size_t literalLength = token >> 4;
+		if (literalLength == 15 && !ReadLength(ip, iend, literalLength)) return false;
+		if (static_cast<size_t>(iend - ip) < literalLength || static_cast<size_t>(oend - op) < literalLength) return false;
+		memcpy(op, ip, literalLength);
+		ip += literalLength;
+		op += literalLength;
+		if (ip == iend) break; // the last sequence carries literals only
+
+		if (iend - ip < 2) return false;
+		const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+		ip += 2;
+		if (offset == 0 || offset > static_cast<size_t>(op - dst)) return false;
+		size_t matchLength = token & 15;
+		if (matchLength == 15 && !ReadLength(ip, iend, matchLength)) return false;
+		matchLength += MIN_MATCH;
+		if (static_cast<size_t>(oend - op) < matchLength) return false;
+		const uint8_t* match = op - offset;
+		if (offset >= matchLength) {
+			memcpy(op, match, matchLength);
+		}
+		else {
+			// Overlapping match: a run with period `offset`. Seed one period, then double the
+			// copied span; it stays a whole number of periods, so each copy is disjoint.
+			memcpy(op, match, offset);
+			for (size_t copied = offset; copied < matchLength; copied *= 2) {
+				const size_t remaining = matchLength - copied;
+				memcpy(op + copied, op, remaining < copied ? remaining : copied);
+			}
+		}
+		op += matchLength;
+	}
+	return op == oend;
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// LZ4 block format (no frame header), as used inside .bcskin containers
+namespace Lz4 {
+	// Worst-case compressed size for an input of `size` bytes
+	constexpr size_t CompressBound(size_t size) { return size + size / 255 + 16; }
+
+	// Greedy single-pass compressor; returns the compressed size, or 0 if dst is too small
+	size_t Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
+
+	// Bounds-checked decoder; true only if the block expands to exactly dstSize bytes
+	bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+}
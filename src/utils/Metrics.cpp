@@ -0,0 +1,126 @@
+#include "Metrics.h"
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace {
+	struct MetricInfo {
+		const char* name;
+		const char* help;
+	};
+
+	constexpr MetricInfo COUNTER_INFO[Metrics::COUNTER_COUNT] = {
+		{ "bongocat_keyboard_hook_calls_total", "Low-level keyboard hook callbacks." },
+		{ "bongocat_mouse_hook_calls_total", "Low-level mouse hook callbacks." },
+		{ "bongocat_state_events_total", "Events passed to the cat state machine." },
+		{ "bongocat_state_events_debounced_total", "Input events dropped by the debounce window." },
+		{ "bongocat_state_events_coalesced_total", "Events handled without a state change." },
+		{ "bongocat_presents_total", "Layered window updates." },
+		{ "bongocat_presents_skipped_total", "Redraws skipped while hidden or occluded." },
+		{ "bongocat_presents_deferred_total", "Redraws folded into a later paced present." },
+		{ "bongocat_timer_fires_total", "Window timer messages." },
+		{ "bongocat_settings_writes_total", "Registry value writes." },
+		{ "bongocat_decode_microseconds_total", "Time spent decoding skin frames." },
+	};
+
+	constexpr MetricInfo GAUGE_INFO[Metrics::GAUGE_COUNT] = {
+		{ "bongocat_frame_bytes", "Decoded frame bytes resident for the active skin." },
+	};
+}
+
+#if BONGOCAT_METRICS
+namespace {
+	struct ThreadCounters {
+		std::atomic<uint64_t> values[Metrics::COUNTER_COUNT] = {};
+	};
+
+	struct Registry {
+		std::mutex mutex;
+		std::vector<const ThreadCounters*> threads;
+		uint64_t retired[Metrics::COUNTER_COUNT] = {};
+	};
+
+	Registry& GetRegistry() {
+		static Registry registry;
+		return registry;
+	}
+
+	std::atomic<int64_t> g_gauges[Metrics::GAUGE_COUNT] = {};
+
+	// Registers on a thread's first metric and folds its totals back on thread exit
+	struct ThreadSlot {
+		ThreadCounters counters;
+
+		ThreadSlot() {
+			Registry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			registry.threads.push_back(&counters);
+		}
+
+		~ThreadSlot() {
+			Registry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			for (size_t i = 0; i < Metrics::COUNTER_COUNT; ++i) {
+				registry.retired[i] += counters.values[i].load(std::memory_order_relaxed);
+			}
+			for (size_t i = 0; i < registry.threads.size(); ++i) {
+				if (registry.threads[i] == &counters) {
+					registry.threads.erase(registry.threads.begin() + static_cast<std::ptrdiff_t>(i));
+					break;
+				}
+			}
+		}
+	};
+
+	thread_local ThreadSlot t_slot;
+}
+
+void Metrics::Add(Counter counter, uint64_t amount) {
+	// Only this thread writes its slot: a relaxed load/store pair, no locked read-modify-write
+	std::atomic<uint64_t>& value = t_slot.counters.values[static_cast<size_t>(counter)];
+	value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+void Metrics::Set(Gauge gauge, int64_t value) noexcept {
+	g_gauges[static_cast<size_t>(gauge)].store(value, std::memory_order_relaxed);
+}
+
+Metrics::Values Metrics::Collect() {
+	Values values = {};
+	Registry& registry = GetRegistry();
+	{
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+			values.counters[i] = registry.retired[i];
+		}
+		for (const ThreadCounters* thread : registry.threads) {
+			for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+				values.counters[i] += thread->values[i].load(std::memory_order_relaxed);
+			}
+		}
+	}
+	for (size_t i = 0; i < GAUGE_COUNT; ++i) {
+		values.gauges[i] = g_gauges[i].load(std::memory_order_relaxed);
+	}
+	return values;
+}
+#endif
+
+std::string Metrics::FormatText(const Values& values) {
+	std::string text;
+	char line[320] = { 0 };
+	for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+		snprintf(line, sizeof(line), "# HELP %s %s\n# TYPE %s counter\n%s %llu\n",
+			COUNTER_INFO[i].name, COUNTER_INFO[i].help, COUNTER_INFO[i].name,
+			COUNTER_INFO[i].name, static_cast<unsigned long long>(values.counters[i]));
+		text += line;
+	}
+	for (size_t i = 0; i < GAUGE_COUNT; ++i) {
+		snprintf(line, sizeof(line), "# HELP %s %s\n# TYPE %s gauge\n%s %lld\n",
+			GAUGE_INFO[i].name, GAUGE_INFO[i].help, GAUGE_INFO[i].name,
+			GAUGE_INFO[i].name, static_cast<long long>(values.gauges[i]));
+		text += line;
+	}
+	return text;
+}
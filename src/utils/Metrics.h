@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Build with BONGOCAT_METRICS=0 to compile every metric call site out
+#ifndef BONGOCAT_METRICS
+#define BONGOCAT_METRICS 1
+#endif
+
+// In-process counters and gauges. Each thread bumps its own counter block without locked
+// instructions; a scrape sums the blocks. Gauges are process-wide.
+namespace Metrics {
+	enum class Counter : uint8_t {
+		KeyboardHookCalls,
+		MouseHookCalls,
+		StateEvents,
+		StateEventsDebounced,  // input dropped inside the debounce window
+		StateEventsCoalesced,  // handled without a state change
+		Presents,
+		PresentsSkipped,
+		PresentsDeferred,      // folded into a later present (refresh pacing or frame cap)
+		TimerFires,
+		SettingsWrites,
+		DecodeMicroseconds,
+		Count
+	};
+
+	enum class Gauge : uint8_t {
+		FrameBytes,            // decoded frame pixels resident for the active skin
+		Count
+	};
+
+	constexpr size_t COUNTER_COUNT = static_cast<size_t>(Counter::Count);
+	constexpr size_t GAUGE_COUNT = static_cast<size_t>(Gauge::Count);
+
+	struct Values {
+		uint64_t counters[COUNTER_COUNT];
+		int64_t gauges[GAUGE_COUNT];
+	};
+
+#if BONGOCAT_METRICS
+	void Add(Counter counter, uint64_t amount);
+	void Set(Gauge gauge, int64_t value) noexcept;
+
+	// Scrape: live threads plus threads that have exited
+	Values Collect();
+#endif
+
+	// Prometheus text exposition format
+	std::string FormatText(const Values& values);
+}
+
+#if BONGOCAT_METRICS
+#define METRIC_ADD(counter, amount) ::Metrics::Add(::Metrics::Counter::counter, static_cast<uint64_t>(amount))
+#define METRIC_SET(gauge, value) ::Metrics::Set(::Metrics::Gauge::gauge, static_cast<int64_t>(value))
+#else
+#define METRIC_ADD(counter, amount) ((void)0)
+#define METRIC_SET(gauge, value) ((void)0)
+#endif
+#define METRIC_INC(counter) METRIC_ADD(counter, 1)
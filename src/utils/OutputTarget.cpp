@@ -0,0 +1,44 @@
+#include "OutputTarget.h"
+#include <cwchar>
+#include "Configuration.h"
+
+bool OutputTarget::IsPipe(const std::wstring& target) {
+	const size_t prefixLength = wcslen(Configuration::STREAM_PIPE_PATH_PREFIX);
+	return target.size() > prefixLength && _wcsnicmp(target.c_str(), Configuration::STREAM_PIPE_PATH_PREFIX, prefixLength) == 0;
+}
+
+HandleWrapper OutputTarget::Open(const std::wstring& target, DWORD pipeBufferSize) {
+	if (target == L"-") {
+		HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+		return HandleWrapper(output == INVALID_HANDLE_VALUE ? nullptr : output, false);
+	}
+
+	HANDLE output = INVALID_HANDLE_VALUE;
+	if (IsPipe(target)) {
+		output = CreateNamedPipeW(target.c_str(), PIPE_ACCESS_OUTBOUND | FILE_FLAG_FIRST_PIPE_INSTANCE,
+			PIPE_TYPE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+			1, pipeBufferSize, 0, 0, nullptr);
+	}
+	else {
+		output = CreateFileW(target.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	}
+	return HandleWrapper(output == INVALID_HANDLE_VALUE ? nullptr : output, true);
+}
+
+bool OutputTarget::WaitForReader(HANDLE pipe) {
+	if (ConnectNamedPipe(pipe, nullptr)) return true;
+	return GetLastError() == ERROR_PIPE_CONNECTED;
+}
+
+bool OutputTarget::WriteAll(HANDLE output, const void* data, size_t size) {
+	const BYTE* cursor = static_cast<const BYTE*>(data);
+	while (size > 0) {
+		DWORD written = 0;
+		if (!WriteFile(output, cursor, static_cast<DWORD>(size), &written, nullptr) || written == 0) {
+			return false;
+		}
+		cursor += written;
+		size -= written;
+	}
+	return true;
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <windows.h>
+#include <string>
+#include "RAII/Handle.h"
+
+// Byte-stream destinations named on the command line (--stream, --tty)
+namespace OutputTarget {
+	// \\.\pipe\name
+	bool IsPipe(const std::wstring& target);
+	// "-" borrows standard output, a pipe name creates a served pipe (one reader at a time), anything else creates a file
+	HandleWrapper Open(const std::wstring& target, DWORD pipeBufferSize);
+	// Blocks until a reader connects to a served pipe
+	bool WaitForReader(HANDLE pipe);
+	bool WriteAll(HANDLE output, const void* data, size_t size);
+}
@@ -0,0 +1,76 @@
+#include "PixelConvert.h"
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define BONGOCAT_PIXEL_SSE2 1
+#endif
+
+namespace {
+	// Q14 full-range BT.601 coefficients
+	constexpr int Y_B = 1868, Y_G = 9617, Y_R = 4899;
+	constexpr int U_B = 8192, U_G = -5427, U_R = -2765;
+	constexpr int V_B = -1332, V_G = -6860, V_R = 8192;
+	constexpr int SHIFT = 14;
+	constexpr int ROUND = 1 << (SHIFT - 1);
+
+	inline uint8_t LumaScalar(const uint8_t* px) {
+		return static_cast<uint8_t>((px[0] * Y_B + px[1] * Y_G + px[2] * Y_R + ROUND) >> SHIFT);
+	}
+
+	inline uint8_t ClampByte(int value) {
+		return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+	}
+
+	void LumaRow(const uint8_t* row, int width, uint8_t* out) {
+		int x = 0;
+#if BONGOCAT_PIXEL_SSE2
+		// 4 pixels per step: widen to 16-bit, madd (B*Yb + G*Yg, R*Yr + A*0), then add pairs
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i coeffs = _mm_setr_epi16(Y_B, Y_G, Y_R, 0, Y_B, Y_G, Y_R, 0);
+		const __m128i round = _mm_set1_epi32(ROUND);
+		for (; x + 4 <= width; x += 4) {
+			const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x * 4));
+			const __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi8(pixels, zero), coeffs);
+			const __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi8(pixels, zero), coeffs);
+			// lo = [p0a p0b p1a p1b], hi = [p2a p2b p3a p3b] -> sums [p0 p1 p2 p3]
+			const __m128i evens = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(2, 0, 2, 0)));
+			const __m128i odds = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(3, 1, 3, 1)));
+			const __m128i luma = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(evens, odds), round), SHIFT);
+			const __m128i packed16 = _mm_packs_epi32(luma, luma);
+			const int packed8 = _mm_cvtsi128_si32(_mm_packus_epi16(packed16, packed16));
+			out[x + 0] = static_cast<uint8_t>(packed8);
+			out[x + 1] = static_cast<uint8_t>(packed8 >> 8);
+			out[x + 2] = static_cast<uint8_t>(packed8 >> 16);
+			out[x + 3] = static_cast<uint8_t>(packed8 >> 24);
+		}
+#endif
+		for (; x < width; ++x) {
+			out[x] = LumaScalar(row + x * 4);
+		}
+	}
+}
+
+void PixelConvert::BgraToI420(const uint8_t* bgra, int width, int height, int strideBytes,
+	uint8_t* yPlane, uint8_t* uPlane, uint8_t* vPlane) {
+	if (!bgra || !yPlane || !uPlane || !vPlane || width <= 0 || height <= 0) return;
+
+	for (int y = 0; y < height; ++y) {
+		LumaRow(bgra + static_cast<size_t>(y) * strideBytes, width, yPlane + static_cast<size_t>(y) * width);
+	}
+
+	// Chroma from the 2x2 average; a quarter of the work, kept scalar
+	const int chromaWidth = width / 2;
+	for (int cy = 0; cy < height / 2; ++cy) {
+		const uint8_t* row0 = bgra + static_cast<size_t>(cy * 2) * strideBytes;
+		const uint8_t* row1 = row0 + strideBytes;
+		for (int cx = 0; cx < chromaWidth; ++cx) {
+			const uint8_t* a = row0 + cx * 8;
+			const uint8_t* b = row1 + cx * 8;
+			const int blue = (a[0] + a[4] + b[0] + b[4] + 2) >> 2;
+			const int green = (a[1] + a[5] + b[1] + b[5] + 2) >> 2;
+			const int red = (a[2] + a[6] + b[2] + b[6] + 2) >> 2;
+			const size_t index = static_cast<size_t>(cy) * chromaWidth + cx;
+			uPlane[index] = ClampByte(((blue * U_B + green * U_G + red * U_R + ROUND) >> SHIFT) + 128);
+			vPlane[index] = ClampByte(((blue * V_B + green * V_G + red * V_R + ROUND) >> SHIFT) + 128);
+		}
+	}
+}
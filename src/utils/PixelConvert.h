@@ -0,0 +1,10 @@
+#pragma once
+#include <cstdint>
+
+// Pixel format conversions for frame export
+namespace PixelConvert {
+	// Top-down premultiplied BGRA to planar I420 (full-range BT.601, "C420jpeg").
+	// Width and height must be even. Premultiplied colour is the frame composited over black.
+	void BgraToI420(const uint8_t* bgra, int width, int height, int strideBytes,
+		uint8_t* yPlane, uint8_t* uPlane, uint8_t* vPlane);
+}
@@ -0,0 +1,128 @@
+#include "PresentScheduler.h"
+#include <dwmapi.h>
+#include "Configuration.h"
+
+namespace {
+	constexpr LONGLONG HUNDRED_NS_PER_SECOND = 10000000;
+
+	LONGLONG QueryTicks() {
+		LARGE_INTEGER now = {};
+		QueryPerformanceCounter(&now);
+		return now.QuadPart;
+	}
+
+	// QPC ticks to 100 ns units without overflowing on long uptimes
+	LONGLONG TicksTo100ns(LONGLONG ticks, LONGLONG frequency) {
+		return (ticks / frequency) * HUNDRED_NS_PER_SECOND + (ticks % frequency) * HUNDRED_NS_PER_SECOND / frequency;
+	}
+}
+
+PresentScheduler::~PresentScheduler() {
+	Stop();
+}
+
+bool PresentScheduler::Start(HWND window) {
+	if (m_worker.joinable() || !window) return false;
+	m_window = window;
+
+	LARGE_INTEGER frequency = {};
+	QueryPerformanceFrequency(&frequency);
+	m_frequency = frequency.QuadPart;
+	NextVBlank(0); // primes the refresh period
+
+	m_stopEvent = HandleWrapper(CreateEventW(nullptr, TRUE, FALSE, nullptr), true);
+	m_requestEvent = HandleWrapper(CreateEventW(nullptr, FALSE, FALSE, nullptr), true);
+	if (!m_stopEvent.isValid() || !m_requestEvent.isValid()) return false;
+
+	m_worker = std::thread(&PresentScheduler::PaceLoop, this);
+	return true;
+}
+
+void PresentScheduler::Stop() {
+	if (!m_worker.joinable()) return;
+	SetEvent(m_stopEvent.get());
+	m_worker.join();
+	m_stopEvent = HandleWrapper();
+	m_requestEvent = HandleWrapper();
+	m_pending = false;
+	m_due = false;
+}
+
+bool PresentScheduler::ShouldPresentNow(UINT minIntervalMs) {
+	if (m_due) {
+		m_due = false;
+		return true;
+	}
+	// Without a worker nothing would ever deliver the folded present
+	if (!m_worker.joinable()) return true;
+	if (m_pending) return false;
+
+	const LONGLONG interval = PresentInterval(minIntervalMs);
+	if (QueryTicks() - m_lastPresent >= interval) return true;
+
+	m_pending = true;
+	m_notBefore.store(m_lastPresent + interval, std::memory_order_relaxed);
+	SetEvent(m_requestEvent.get());
+	return false;
+}
+
+bool PresentScheduler::ScheduleNext(UINT minIntervalMs) {
+	if (!m_worker.joinable()) return false;
+	if (m_pending) return true;
+	m_pending = true;
+	m_notBefore.store(QueryTicks() + PresentInterval(minIntervalMs), std::memory_order_relaxed);
+	SetEvent(m_requestEvent.get());
+	return true;
+}
+
+LONGLONG PresentScheduler::PresentInterval(UINT minIntervalMs) const {
+	const LONGLONG capInterval = static_cast<LONGLONG>(minIntervalMs) * m_frequency / 1000;
+	const LONGLONG refreshPeriod = m_refreshPeriod.load(std::memory_order_relaxed);
+	return capInterval > refreshPeriod ? capInterval : refreshPeriod;
+}
+
+void PresentScheduler::OnPresented() noexcept {
+	m_lastPresent = QueryTicks();
+}
+
+LONGLONG PresentScheduler::NextVBlank(LONGLONG notBefore) {
+	DWM_TIMING_INFO timing = {};
+	timing.cbSize = sizeof(timing);
+	if (SUCCEEDED(DwmGetCompositionTimingInfo(nullptr, &timing)) && timing.qpcRefreshPeriod > 0) {
+		const LONGLONG period = static_cast<LONGLONG>(timing.qpcRefreshPeriod);
+		const LONGLONG vblank = static_cast<LONGLONG>(timing.qpcVBlank);
+		m_refreshPeriod.store(period, std::memory_order_relaxed);
+		if (notBefore <= vblank) return vblank;
+		return vblank + ((notBefore - vblank + period - 1) / period) * period;
+	}
+	// No composition timing (remote session, basic display driver): plain rate cap
+	m_refreshPeriod.store(m_frequency / Configuration::PRESENT_FALLBACK_FPS, std::memory_order_relaxed);
+	return notBefore;
+}
+
+void PresentScheduler::PaceLoop() {
+	HandleWrapper timer;
+#ifdef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+	timer = HandleWrapper(CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS), true);
+#endif
+	if (!timer.isValid()) {
+		timer = HandleWrapper(CreateWaitableTimerW(nullptr, FALSE, nullptr), true);
+	}
+	if (!timer.isValid()) return;
+
+	HANDLE requestWaits[2] = { m_stopEvent.get(), m_requestEvent.get() };
+	HANDLE timerWaits[2] = { m_stopEvent.get(), timer.get() };
+	for (;;) {
+		if (WaitForMultipleObjects(2, requestWaits, FALSE, INFINITE) != WAIT_OBJECT_0 + 1) return;
+
+		const LONGLONG target = NextVBlank(m_notBefore.load(std::memory_order_relaxed));
+		const LONGLONG remaining = target - QueryTicks();
+		if (remaining > 0) {
+			LARGE_INTEGER dueTime = {};
+			dueTime.QuadPart = -TicksTo100ns(remaining, m_frequency); // negative: relative
+			if (!SetWaitableTimer(timer.get(), &dueTime, 0, nullptr, nullptr, FALSE)) return;
+			if (WaitForMultipleObjects(2, timerWaits, FALSE, INFINITE) != WAIT_OBJECT_0 + 1) return;
+		}
+		PostMessageW(m_window, Configuration::WM_APP_PRESENT, 0, 0);
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <windows.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include "RAII/Handle.h"
+
+// Paces window presents to the display refresh. The first present in a refresh interval goes out
+// at once, so input is never held back; later ones in the same interval fold into a single
+// present at the next vblank, which a worker signals to the window as WM_APP_PRESENT.
+class PresentScheduler {
+private:
+	HWND m_window = nullptr;
+	LONGLONG m_frequency = 0;
+	HandleWrapper m_stopEvent;
+	HandleWrapper m_requestEvent;
+	std::thread m_worker;
+
+	// Written by the UI thread, read by the worker
+	std::atomic<LONGLONG> m_notBefore{ 0 };
+	// Written by the worker after each DWM query
+	std::atomic<LONGLONG> m_refreshPeriod{ 0 };
+
+	// UI thread only
+	LONGLONG m_lastPresent = 0;
+	bool m_pending = false;
+	bool m_due = false;
+
+	void PaceLoop();
+	LONGLONG NextVBlank(LONGLONG notBefore);
+	LONGLONG PresentInterval(UINT minIntervalMs) const;
+
+public:
+	PresentScheduler() = default;
+	~PresentScheduler();
+
+	PresentScheduler(const PresentScheduler&) = delete;
+	PresentScheduler& operator=(const PresentScheduler&) = delete;
+
+	bool Start(HWND window);
+	void Stop();
+
+	// UI thread. False when this present was folded into a paced one; minIntervalMs caps the rate
+	// further (0 = refresh rate only).
+	bool ShouldPresentNow(UINT minIntervalMs);
+	// UI thread: asks for a present one interval from now (animation playback, called while presenting).
+	// False when no paced present can be delivered.
+	bool ScheduleNext(UINT minIntervalMs);
+	// UI thread: WM_APP_PRESENT arrived, so the next present goes out unconditionally
+	void OnPaced() noexcept { m_pending = false; m_due = true; }
+	// UI thread: a frame reached the screen
+	void OnPresented() noexcept;
+};
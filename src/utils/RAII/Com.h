@@ -0,0 +1,39 @@
+#pragma once
+#include <windows.h>
+#include <objbase.h>
+#include "Base.h"
+
+// COM interface deleter
+struct ComDeleter {
+	template<typename T>
+	void operator()(T* pointer) const {
+		if (pointer) pointer->Release();
+	}
+};
+
+// COM interface wrapper
+template<typename T>
+class ComWrapper : public BaseRAIIWrapper<T*, ComDeleter> {
+public:
+	ComWrapper() : BaseRAIIWrapper<T*, ComDeleter>(nullptr, false) {}
+	ComWrapper(T* pointer, bool owned = false)
+		: BaseRAIIWrapper<T*, ComDeleter>(pointer, owned) {
+	}
+};
+
+// Per-thread COM apartment
+class ComInitWrapper {
+private:
+	HRESULT m_result;
+
+public:
+	explicit ComInitWrapper(DWORD model) : m_result(CoInitializeEx(nullptr, model)) {}
+	~ComInitWrapper() {
+		if (SUCCEEDED(m_result)) CoUninitialize();
+	}
+
+	ComInitWrapper(const ComInitWrapper&) = delete;
+	ComInitWrapper& operator=(const ComInitWrapper&) = delete;
+
+	bool isValid() const { return SUCCEEDED(m_result); }
+};
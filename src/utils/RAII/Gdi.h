@@ -15,6 +15,12 @@ struct BitmapDeleter {
 	}
 };
 
+struct FontDeleter {
+	void operator()(HFONT hFont) const {
+		if (hFont) DeleteObject(hFont);
+	}
+};
+
 struct IconDeleter {
 	void operator()(HICON hIcon) const {
 		if (hIcon) DestroyIcon(hIcon);
@@ -44,6 +50,14 @@ public:
 	}
 };
 
+class FontWrapper : public BaseRAIIWrapper<HFONT, FontDeleter> {
+public:
+	FontWrapper() : BaseRAIIWrapper(nullptr, false) {}
+	FontWrapper(HFONT hFont, bool owned = false)
+		: BaseRAIIWrapper(hFont, owned) {
+	}
+};
+
 class IconWrapper : public BaseRAIIWrapper<HICON, IconDeleter> {
 public:
 	IconWrapper() : BaseRAIIWrapper(nullptr, false) {}
@@ -9,6 +9,35 @@ struct HandleDeleter {
 	}
 };
 
+// Mapped file view deleter
+struct MappedViewDeleter {
+	void operator()(void* view) const {
+		if (view) UnmapViewOfFile(view);
+	}
+};
+
+// LocalAlloc'd memory deleter (buffers returned by the system)
+struct LocalMemoryDeleter {
+	void operator()(void* memory) const {
+		if (memory) LocalFree(memory);
+	}
+};
+
+// Power setting notification deleter
+struct PowerNotifyDeleter {
+	void operator()(HPOWERNOTIFY handle) const {
+		if (handle) UnregisterPowerSettingNotification(handle);
+	}
+};
+
+// Power setting notification wrapper (delivered as WM_POWERBROADCAST to the window)
+class PowerNotifyWrapper : public BaseRAIIWrapper<HPOWERNOTIFY, PowerNotifyDeleter> {
+public:
+	PowerNotifyWrapper(HWND hwnd, const GUID& setting)
+		: BaseRAIIWrapper(RegisterPowerSettingNotification(hwnd, &setting, DEVICE_NOTIFY_WINDOW_HANDLE), true) {
+	}
+};
+
 // HANDLE wrapper
 class HandleWrapper : public BaseRAIIWrapper<HANDLE, HandleDeleter> {
 public:
@@ -17,3 +46,19 @@ public:
 		: BaseRAIIWrapper(handle, owned) {
 	}
 };
+
+// LocalAlloc'd memory wrapper
+class LocalMemoryWrapper : public BaseRAIIWrapper<void*, LocalMemoryDeleter> {
+public:
+	LocalMemoryWrapper(void* memory, bool owned = false)
+		: BaseRAIIWrapper(memory, owned) {
+	}
+};
+
+// MapViewOfFile view wrapper
+class MappedViewWrapper : public BaseRAIIWrapper<void*, MappedViewDeleter> {
+public:
+	MappedViewWrapper(void* view, bool owned = false)
+		: BaseRAIIWrapper(view, owned) {
+	}
+};
@@ -22,3 +22,19 @@ public:
 		, hInstance_(hInstance), hookType_(hookType), proc_(proc) {
 	}
 };
+
+// WinEvent hook deleter
+struct WinEventHookDeleter {
+	void operator()(HWINEVENTHOOK hook) const {
+		if (hook) UnhookWinEvent(hook);
+	}
+};
+
+// Out-of-context WinEvent hook wrapper (callbacks arrive on the installing thread)
+class WinEventHookWrapper : public BaseRAIIWrapper<HWINEVENTHOOK, WinEventHookDeleter> {
+public:
+	WinEventHookWrapper(DWORD eventMin, DWORD eventMax, WINEVENTPROC proc)
+		: BaseRAIIWrapper(SetWinEventHook(eventMin, eventMax, nullptr, proc, 0, 0,
+			WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS), true) {
+	}
+};
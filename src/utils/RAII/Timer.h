@@ -42,11 +42,13 @@ public:
 		return *this;
 	}
 
-	// Timer management
-	bool Set(UINT delay) {
+	// Timer management; a tolerance lets the OS batch this timer with other wakeups
+	bool Set(UINT delay, ULONG tolerance = 0) {
 		if (!hwnd_ || !timerId_) return false;
 		Kill(); // Kill existing timer first
-		isActive_ = ::SetTimer(hwnd_, timerId_, delay, nullptr) != 0;
+		isActive_ = (tolerance != 0
+			? ::SetCoalescableTimer(hwnd_, timerId_, delay, nullptr, tolerance)
+			: ::SetTimer(hwnd_, timerId_, delay, nullptr)) != 0;
 		return isActive_;
 	}
 
@@ -57,8 +59,8 @@ public:
 		return result;
 	}
 
-	bool Restart(UINT delay) {
-		return Set(delay);
+	bool Restart(UINT delay, ULONG tolerance = 0) {
+		return Set(delay, tolerance);
 	}
 
 	bool IsActive() const { return isActive_; }
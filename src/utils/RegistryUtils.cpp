@@ -1,5 +1,7 @@
 #include "RegistryUtils.h"
 #include <cwchar>
+#include "Metrics.h"
+#include "Trace.h"
 
 bool RegistryUtils::EnsureKey(HKEY hKey, LPCWSTR subKey, REGSAM samDesired) {
 	HKEY hCreated = nullptr;
@@ -20,6 +22,8 @@ bool RegistryUtils::EnsureKey(HKEY hKey, LPCWSTR subKey, REGSAM samDesired) {
 
 bool RegistryUtils::SetDWordValue(HKEY hKey, LPCWSTR subKey, LPCWSTR valueName, DWORD data) {
 	if (!EnsureKey(hKey, subKey)) return false;
+	METRIC_INC(SettingsWrites);
+	TRACE_SCOPE("SettingsWrite");
 	return RegSetKeyValueW(hKey, subKey, valueName, REG_DWORD,
 		reinterpret_cast<const BYTE*>(&data), sizeof(data)) == ERROR_SUCCESS;
 }
@@ -33,12 +37,57 @@ bool RegistryUtils::GetDWordValue(HKEY hKey, LPCWSTR subKey, LPCWSTR valueName,
 	return false;
 }
 
+bool RegistryUtils::SetQWordValue(HKEY hKey, LPCWSTR subKey, LPCWSTR valueName, ULONGLONG data) {
+	if (!EnsureKey(hKey, subKey)) return false;
+	METRIC_INC(SettingsWrites);
+	TRACE_SCOPE("SettingsWrite");
+	return RegSetKeyValueW(hKey, subKey, valueName, REG_QWORD,
+		reinterpret_cast<const BYTE*>(&data), sizeof(data)) == ERROR_SUCCESS;
+}
+
+bool RegistryUtils::GetQWordValue(HKEY hKey, LPCWSTR subKey, LPCWSTR valueName, ULONGLONG& data, ULONGLONG defaultValue) {
+	DWORD dataSize = sizeof(data);
+	if (RegGetValueW(hKey, subKey, valueName, RRF_RT_REG_QWORD, nullptr, &data, &dataSize) == ERROR_SUCCESS) {
+		return true;
+	}
+	data = defaultValue;
+	return false;
+}
+
 bool RegistryUtils::SetStringValue(HKEY hKey, LPCWSTR subKey, LPCWSTR valueName, LPCWSTR data) {
 	if (!EnsureKey(hKey, subKey)) return false;
+	METRIC_INC(SettingsWrites);
+	TRACE_SCOPE("SettingsWrite");
 	return RegSetKeyValueW(hKey, subKey, valueName, REG_SZ,
 		data, static_cast<DWORD>((wcslen(data) + 1) * sizeof(WCHAR))) == ERROR_SUCCESS;
 }
 
+bool RegistryUtils::GetStringValue(HKEY hKey, LPCWSTR subKey, LPCWSTR valueName, std::wstring& data) {
+	data.clear();
+	DWORD dataSize = 0;
+	if (RegGetValueW(hKey, subKey, valueName, RRF_RT_REG_SZ, nullptr, nullptr, &dataSize) != ERROR_SUCCESS) return false;
+	std::wstring value(dataSize / sizeof(WCHAR), L'\0');
+	if (RegGetValueW(hKey, subKey, valueName, RRF_RT_REG_SZ, nullptr, &value[0], &dataSize) != ERROR_SUCCESS) return false;
+	// dataSize includes the terminator
+	value.resize(dataSize / sizeof(WCHAR) > 0 ? dataSize / sizeof(WCHAR) - 1 : 0);
+	data = std::move(value);
+	return true;
+}
+
+bool RegistryUtils::SetBinaryValue(HKEY hKey, LPCWSTR subKey, LPCWSTR valueName, const void* data, DWORD size) {
+	if (!EnsureKey(hKey, subKey)) return false;
+	METRIC_INC(SettingsWrites);
+	TRACE_SCOPE("SettingsWrite");
+	return RegSetKeyValueW(hKey, subKey, valueName, REG_BINARY, data, size) == ERROR_SUCCESS;
+}
+
+bool RegistryUtils::GetBinaryValue(HKEY hKey, LPCWSTR subKey, LPCWSTR valueName, void* data, DWORD size) {
+	// Exact-size reads only; a truncated or oversized blob is treated as missing
+	DWORD dataSize = size;
+	LONG res = RegGetValueW(hKey, subKey, valueName, RRF_RT_REG_BINARY, nullptr, data, &dataSize);
+	return res == ERROR_SUCCESS && dataSize == size;
+}
+
 bool RegistryUtils::DeleteValue(HKEY hKey, LPCWSTR subKey, LPCWSTR valueName) {
 	return RegDeleteKeyValueW(hKey, subKey, valueName) == ERROR_SUCCESS;
 }
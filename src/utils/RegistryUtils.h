@@ -1,5 +1,6 @@
 #pragma once
 #include <windows.h>
+#include <string>
 
 // Registry operations
 class RegistryUtils {
@@ -7,7 +8,12 @@ public:
 	// Generic registry value operations
 	static bool SetDWordValue(HKEY hKey, LPCWSTR subKey, LPCWSTR valueName, DWORD data);
 	static bool GetDWordValue(HKEY hKey, LPCWSTR subKey, LPCWSTR valueName, DWORD& data, DWORD defaultValue = 0);
+	static bool SetQWordValue(HKEY hKey, LPCWSTR subKey, LPCWSTR valueName, ULONGLONG data);
+	static bool GetQWordValue(HKEY hKey, LPCWSTR subKey, LPCWSTR valueName, ULONGLONG& data, ULONGLONG defaultValue = 0);
 	static bool SetStringValue(HKEY hKey, LPCWSTR subKey, LPCWSTR valueName, LPCWSTR data);
+	static bool GetStringValue(HKEY hKey, LPCWSTR subKey, LPCWSTR valueName, std::wstring& data);
+	static bool SetBinaryValue(HKEY hKey, LPCWSTR subKey, LPCWSTR valueName, const void* data, DWORD size);
+	static bool GetBinaryValue(HKEY hKey, LPCWSTR subKey, LPCWSTR valueName, void* data, DWORD size);
 	static bool DeleteValue(HKEY hKey, LPCWSTR subKey, LPCWSTR valueName);
 	static bool ValueExists(HKEY hKey, LPCWSTR subKey, LPCWSTR valueName);
 
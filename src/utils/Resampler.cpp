@@ -0,0 +1,167 @@
+#include "Resampler.h"
+#include <cstring>
+#include <vector>
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define BONGOCAT_RESAMPLE_SSE2 1
+#endif
+
+namespace {
+	// Bilinear weights are Q7 so two of them fit a signed 16-bit madd
+	constexpr int WEIGHT_BITS = 7;
+	constexpr int WEIGHT_ONE = 1 << WEIGHT_BITS;
+	constexpr int VERTICAL_SHIFT = WEIGHT_BITS * 2;
+	constexpr int VERTICAL_ROUND = 1 << (VERTICAL_SHIFT - 1);
+
+	// Source coordinate of a destination pixel centre, in 16.16 fixed point
+	inline int64_t SourceCentre(int dstIndex, int srcSize, int dstSize) {
+		return ((static_cast<int64_t>(2 * dstIndex + 1) * srcSize << 16) / (2 * dstSize)) - (1 << 15);
+	}
+
+	struct Tap {
+		int first;
+		int second;
+		int weight; // of second, Q7
+	};
+
+	std::vector<Tap> BuildTaps(int srcSize, int dstSize) {
+		std::vector<Tap> taps(static_cast<size_t>(dstSize));
+		for (int i = 0; i < dstSize; ++i) {
+			int64_t position = SourceCentre(i, srcSize, dstSize);
+			if (position < 0) position = 0;
+			int first = static_cast<int>(position >> 16);
+			int weight = static_cast<int>((position & 0xFFFF) >> (16 - WEIGHT_BITS));
+			if (first >= srcSize - 1) {
+				first = srcSize - 1;
+				weight = 0;
+			}
+			taps[i] = { first, first + (weight ? 1 : 0), weight };
+		}
+		return taps;
+	}
+
+	// One source row filtered horizontally into Q7 16-bit channels
+	void HorizontalRow(const uint8_t* row, const std::vector<Tap>& taps, int16_t* out) {
+		const int width = static_cast<int>(taps.size());
+		int x = 0;
+#if BONGOCAT_RESAMPLE_SSE2
+		const __m128i zero = _mm_setzero_si128();
+		for (; x < width; ++x) {
+			const Tap& tap = taps[x];
+			int first = 0, second = 0;
+			memcpy(&first, row + tap.first * 4, 4);
+			memcpy(&second, row + tap.second * 4, 4);
+			// [b0 b1 g0 g1 r0 r1 a0 a1] widened, then one madd per channel pair
+			const __m128i pair = _mm_unpacklo_epi8(_mm_unpacklo_epi8(_mm_cvtsi32_si128(first), _mm_cvtsi32_si128(second)), zero);
+			const __m128i weights = _mm_set1_epi32((tap.weight << 16) | (WEIGHT_ONE - tap.weight));
+			const __m128i sums = _mm_madd_epi16(pair, weights);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(out + x * 4), _mm_packs_epi32(sums, sums));
+		}
+#endif
+		for (; x < width; ++x) {
+			const Tap& tap = taps[x];
+			const uint8_t* a = row + tap.first * 4;
+			const uint8_t* b = row + tap.second * 4;
+			for (int c = 0; c < 4; ++c) {
+				out[x * 4 + c] = static_cast<int16_t>(a[c] * (WEIGHT_ONE - tap.weight) + b[c] * tap.weight);
+			}
+		}
+	}
+
+	void VerticalRow(const int16_t* top, const int16_t* bottom, int weight, int width, uint8_t* out) {
+		const int count = width * 4;
+		int i = 0;
+#if BONGOCAT_RESAMPLE_SSE2
+		const __m128i weights = _mm_set1_epi32((weight << 16) | (WEIGHT_ONE - weight));
+		const __m128i round = _mm_set1_epi32(VERTICAL_ROUND);
+		for (; i + 8 <= count; i += 8) {
+			const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(top + i));
+			const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + i));
+			const __m128i lo = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(a, b), weights), round), VERTICAL_SHIFT);
+			const __m128i hi = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(a, b), weights), round), VERTICAL_SHIFT);
+			const __m128i packed = _mm_packs_epi32(lo, hi);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(packed, packed));
+		}
+#endif
+		for (; i < count; ++i) {
+			out[i] = static_cast<uint8_t>((top[i] * (WEIGHT_ONE - weight) + bottom[i] * weight + VERTICAL_ROUND) >> VERTICAL_SHIFT);
+		}
+	}
+
+	void ResizeBilinear(const uint8_t* src, int srcWidth, int srcHeight, int srcStride,
+		uint8_t* dst, int dstWidth, int dstHeight, int dstStride) {
+		const std::vector<Tap> columns = BuildTaps(srcWidth, dstWidth);
+		const std::vector<Tap> rows = BuildTaps(srcHeight, dstHeight);
+
+		// Two filtered source rows; when upscaling most output rows reuse both
+		const size_t rowValues = static_cast<size_t>(dstWidth) * 4;
+		std::vector<int16_t> cache(rowValues * 2);
+		int cachedRow[2] = { -1, -1 };
+		auto filtered = [&](int sourceRow) -> const int16_t* {
+			for (int slot = 0; slot < 2; ++slot) {
+				if (cachedRow[slot] == sourceRow) return cache.data() + rowValues * slot;
+			}
+			// Rows are visited in increasing order; overwrite the older one
+			const int slot = (cachedRow[0] < cachedRow[1]) ? 0 : 1;
+			HorizontalRow(src + static_cast<size_t>(sourceRow) * srcStride, columns, cache.data() + rowValues * slot);
+			cachedRow[slot] = sourceRow;
+			return cache.data() + rowValues * slot;
+		};
+
+		for (int y = 0; y < dstHeight; ++y) {
+			const Tap& tap = rows[y];
+			const int16_t* top = filtered(tap.first);
+			const int16_t* bottom = filtered(tap.second);
+			VerticalRow(top, bottom, tap.weight, dstWidth, dst + static_cast<size_t>(y) * dstStride);
+		}
+	}
+
+	void NearestRow(const uint8_t* row, int srcWidth, const std::vector<int>& columns, uint8_t* out) {
+		const int width = static_cast<int>(columns.size());
+		int x = 0;
+#if BONGOCAT_RESAMPLE_SSE2
+		// Exact 2x: duplicate each pixel with one unpack
+		if (width == srcWidth * 2) {
+			for (; x + 8 <= width; x += 8) {
+				const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x * 2));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 4), _mm_unpacklo_epi32(pixels, pixels));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 4 + 16), _mm_unpackhi_epi32(pixels, pixels));
+			}
+		}
+#endif
+		for (; x < width; ++x) {
+			memcpy(out + x * 4, row + columns[x] * 4, 4);
+		}
+	}
+
+	void ResizeNearest(const uint8_t* src, int srcWidth, int srcHeight, int srcStride,
+		uint8_t* dst, int dstWidth, int dstHeight, int dstStride) {
+		std::vector<int> columns(static_cast<size_t>(dstWidth));
+		for (int x = 0; x < dstWidth; ++x) {
+			columns[x] = static_cast<int>(static_cast<int64_t>(2 * x + 1) * srcWidth / (2 * dstWidth));
+		}
+		int previous = -1;
+		for (int y = 0; y < dstHeight; ++y) {
+			const int sourceRow = static_cast<int>(static_cast<int64_t>(2 * y + 1) * srcHeight / (2 * dstHeight));
+			uint8_t* out = dst + static_cast<size_t>(y) * dstStride;
+			if (sourceRow == previous) {
+				// Repeated source row: copy the finished output row
+				memcpy(out, out - dstStride, static_cast<size_t>(dstWidth) * 4);
+				continue;
+			}
+			NearestRow(src + static_cast<size_t>(sourceRow) * srcStride, srcWidth, columns, out);
+			previous = sourceRow;
+		}
+	}
+}
+
+void Resampler::Resize(const uint8_t* src, int srcWidth, int srcHeight, int srcStride,
+	uint8_t* dst, int dstWidth, int dstHeight, int dstStride, Filter filter) {
+	if (!src || !dst || srcWidth <= 0 || srcHeight <= 0 || dstWidth <= 0 || dstHeight <= 0) return;
+	if (filter == Filter::Nearest) {
+		ResizeNearest(src, srcWidth, srcHeight, srcStride, dst, dstWidth, dstHeight, dstStride);
+	}
+	else {
+		ResizeBilinear(src, srcWidth, srcHeight, srcStride, dst, dstWidth, dstHeight, dstStride);
+	}
+}
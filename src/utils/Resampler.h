@@ -0,0 +1,14 @@
+#pragma once
+#include <cstdint>
+
+// Frame scaling for HiDPI windows
+namespace Resampler {
+	enum class Filter : uint8_t {
+		Nearest,   // hard pixel edges; meant for whole-number factors
+		Bilinear   // smooth; interpolates premultiplied channels, so edges get no dark fringe
+	};
+
+	// Top-down premultiplied BGRA to top-down premultiplied BGRA of another size
+	void Resize(const uint8_t* src, int srcWidth, int srcHeight, int srcStride,
+		uint8_t* dst, int dstWidth, int dstHeight, int dstStride, Filter filter);
+}
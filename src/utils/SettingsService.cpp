@@ -46,6 +46,143 @@ void SettingsService::WriteSkin(int skin) {
 		static_cast<DWORD>(skin));
 }
 
+std::wstring SettingsService::ReadSkinPack() {
+	std::wstring folder;
+	RegistryUtils::GetStringValue(
+		HKEY_CURRENT_USER,
+		Configuration::REGISTRY_KEY,
+		L"SkinPack",
+		folder);
+	return folder;
+}
+
+void SettingsService::WriteSkinPack(const std::wstring& folder) {
+	RegistryUtils::SetStringValue(
+		HKEY_CURRENT_USER,
+		Configuration::REGISTRY_KEY,
+		L"SkinPack",
+		folder.c_str());
+}
+
+std::vector<std::wstring> SettingsService::ReadAccessories() {
+	// Stored as one string; '|' cannot appear in a file name
+	std::wstring joined;
+	RegistryUtils::GetStringValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"Accessories", joined);
+	std::vector<std::wstring> files;
+	size_t start = 0;
+	while (start < joined.size()) {
+		size_t end = joined.find(L'|', start);
+		if (end == std::wstring::npos) end = joined.size();
+		if (end > start) files.push_back(joined.substr(start, end - start));
+		start = end + 1;
+	}
+	return files;
+}
+
+void SettingsService::WriteAccessories(const std::vector<std::wstring>& files) {
+	std::wstring joined;
+	for (const std::wstring& file : files) {
+		if (!joined.empty()) joined += L'|';
+		joined += file;
+	}
+	RegistryUtils::SetStringValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"Accessories", joined.c_str());
+}
+
+bool SettingsService::ReadKeyPressCounts(std::array<uint32_t, Configuration::KEY_CODE_COUNT>& counts) {
+	if (!RegistryUtils::GetBinaryValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"KeyPressCounts",
+		counts.data(), static_cast<DWORD>(sizeof(counts)))) {
+		counts.fill(0);
+		return false;
+	}
+	return true;
+}
+
+void SettingsService::WriteKeyPressCounts(const std::array<uint32_t, Configuration::KEY_CODE_COUNT>& counts) {
+	RegistryUtils::SetBinaryValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"KeyPressCounts",
+		counts.data(), static_cast<DWORD>(sizeof(counts)));
+}
+
+void SettingsService::ReadMouseOdometer(uint64_t& distancePixels, uint64_t& wheelNotches) {
+	ULONGLONG distance = 0, notches = 0;
+	RegistryUtils::GetQWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"MouseDistance", distance, 0);
+	RegistryUtils::GetQWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"MouseWheelNotches", notches, 0);
+	distancePixels = distance;
+	wheelNotches = notches;
+}
+
+void SettingsService::WriteMouseOdometer(uint64_t distancePixels, uint64_t wheelNotches) {
+	RegistryUtils::SetQWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"MouseDistance", distancePixels);
+	RegistryUtils::SetQWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"MouseWheelNotches", wheelNotches);
+}
+
+bool SettingsService::ReadMouseExtrasDrivePaws() {
+	DWORD value = 0;
+	RegistryUtils::GetDWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"MouseExtrasDrivePaws", value, 0);
+	return value != 0;
+}
+
+void SettingsService::WriteMouseExtrasDrivePaws(bool enabled) {
+	RegistryUtils::SetDWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"MouseExtrasDrivePaws", enabled ? 1 : 0);
+}
+
+bool SettingsService::ReadTransitions() {
+	DWORD value = 0;
+	RegistryUtils::GetDWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"Transitions", value, 0);
+	return value != 0;
+}
+
+void SettingsService::WriteTransitions(bool enabled) {
+	RegistryUtils::SetDWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"Transitions", enabled ? 1 : 0);
+}
+
+ColorTransform::Tint SettingsService::ReadTint() {
+	ColorTransform::Tint tint;
+	DWORD hue = 0, saturation = 0, palette = 0;
+	RegistryUtils::GetDWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"TintHue", hue, 0);
+	RegistryUtils::GetDWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"TintSaturation", saturation, 100);
+	RegistryUtils::GetDWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"TintPalette", palette, ColorTransform::PALETTE_NONE);
+	tint.hue = static_cast<int>(hue);
+	tint.saturation = static_cast<int>(saturation);
+	tint.palette = static_cast<int>(palette);
+	return tint;
+}
+
+void SettingsService::WriteTint(const ColorTransform::Tint& tint) {
+	RegistryUtils::SetDWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"TintHue", static_cast<DWORD>(tint.hue));
+	RegistryUtils::SetDWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"TintSaturation", static_cast<DWORD>(tint.saturation));
+	RegistryUtils::SetDWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"TintPalette", static_cast<DWORD>(tint.palette));
+}
+
+int SettingsService::ReadOutline() {
+	DWORD value = 0;
+	RegistryUtils::GetDWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"Outline", value, FrameOutline::STYLE_NONE);
+	return static_cast<int>(value);
+}
+
+void SettingsService::WriteOutline(int outline) {
+	RegistryUtils::SetDWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"Outline", static_cast<DWORD>(outline));
+}
+
+int SettingsService::ReadCounterMode() {
+	DWORD value = 0;
+	RegistryUtils::GetDWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"Counter", value, Configuration::COUNTER_OFF);
+	return static_cast<int>(value);
+}
+
+void SettingsService::WriteCounterMode(int mode) {
+	RegistryUtils::SetDWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"Counter", static_cast<DWORD>(mode));
+}
+
+int SettingsService::ReadScale() {
+	DWORD value = 0;
+	RegistryUtils::GetDWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"Scale", value, Configuration::SCALE_AUTO);
+	return static_cast<int>(value);
+}
+
+void SettingsService::WriteScale(int scale) {
+	RegistryUtils::SetDWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"Scale", static_cast<DWORD>(scale));
+}
+
 bool SettingsService::ReadWindowPosition(int& x, int& y) {
 	DWORD dx = 0, dy = 0;
 	bool okX = RegistryUtils::GetDWordValue(HKEY_CURRENT_USER, Configuration::REGISTRY_KEY, L"WindowPosX", dx, 0);
@@ -1,5 +1,12 @@
 #pragma once
 #include <windows.h>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Configuration.h"
+#include "ColorTransform.h"
+#include "FrameOutline.h"
 
 // Centralized settings access
 class SettingsService {
@@ -11,6 +18,44 @@ public:
 	// Skin
 	static int ReadSkin();
 	static void WriteSkin(int skin);
+	// Folder of the selected skin pack; empty while a built-in skin is selected
+	static std::wstring ReadSkinPack();
+	static void WriteSkinPack(const std::wstring& folder);
+	// File names of the worn accessories
+	static std::vector<std::wstring> ReadAccessories();
+	static void WriteAccessories(const std::vector<std::wstring>& files);
+
+	// Per-key press counts (heatmap)
+	static bool ReadKeyPressCounts(std::array<uint32_t, Configuration::KEY_CODE_COUNT>& counts);
+	static void WriteKeyPressCounts(const std::array<uint32_t, Configuration::KEY_CODE_COUNT>& counts);
+
+	// Mouse odometer totals
+	static void ReadMouseOdometer(uint64_t& distancePixels, uint64_t& wheelNotches);
+	static void WriteMouseOdometer(uint64_t distancePixels, uint64_t wheelNotches);
+
+	// Wheel/X buttons drive paws
+	static bool ReadMouseExtrasDrivePaws();
+	static void WriteMouseExtrasDrivePaws(bool enabled);
+
+	// Cross-fade transitions
+	static bool ReadTransitions();
+	static void WriteTransitions(bool enabled);
+
+	// Skin recoloring
+	static ColorTransform::Tint ReadTint();
+	static void WriteTint(const ColorTransform::Tint& tint);
+
+	// Outline or drop shadow (FrameOutline style)
+	static int ReadOutline();
+	static void WriteOutline(int outline);
+
+	// Click counter overlay (Configuration::COUNTER_*)
+	static int ReadCounterMode();
+	static void WriteCounterMode(int mode);
+
+	// Window scale (percent, 0 = follow monitor DPI)
+	static int ReadScale();
+	static void WriteScale(int scale);
 
 	// Window position
 	static bool ReadWindowPosition(int& x, int& y);
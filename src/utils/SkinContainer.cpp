@@ -0,0 +1,120 @@
+#include "SkinContainer.h"
+#include "Lz4.h"
+#include <cstring>
+
+namespace {
+	size_t AlignUp(size_t value) {
+		return (value + SkinContainer::BLOCK_ALIGNMENT - 1) / SkinContainer::BLOCK_ALIGNMENT * SkinContainer::BLOCK_ALIGNMENT;
+	}
+
+	size_t FrameBytes(int width, int height) {
+		return static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+	}
+
+	bool BlockInside(uint32_t offset, uint32_t size, size_t total) {
+		return offset % SkinContainer::BLOCK_ALIGNMENT == 0 && offset <= total && size <= total - offset;
+	}
+}
+
+std::vector<uint8_t> SkinContainer::Build(const Metadata& metadata, int width, int height,
+	const uint8_t* const* frames, int frameCount, Encoding encoding) {
+	if (!frames || frameCount <= 0 || frameCount > MAX_FRAMES ||
+		width <= 0 || height <= 0 || width > MAX_DIMENSION || height > MAX_DIMENSION) {
+		return {};
+	}
+	for (int i = 0; i < frameCount; ++i) {
+		if (!frames[i]) return {};
+	}
+
+	const size_t frameBytes = FrameBytes(width, height);
+
+	Header header = {};
+	header.magic = MAGIC;
+	header.version = VERSION;
+	header.frameCount = static_cast<uint16_t>(frameCount);
+	header.width = static_cast<uint16_t>(width);
+	header.height = static_cast<uint16_t>(height);
+	header.flags = metadata.pixelArt ? FLAG_PIXEL_ART : 0;
+	header.unlockThreshold = metadata.unlockThreshold;
+	for (size_t i = 0; i < metadata.name.size() && i + 1 < static_cast<size_t>(NAME_LENGTH); ++i) {
+		header.name[i] = static_cast<uint16_t>(metadata.name[i]);
+	}
+
+	std::vector<FrameEntry> entries(static_cast<size_t>(frameCount));
+	std::vector<uint8_t> out(AlignUp(sizeof(Header) + entries.size() * sizeof(FrameEntry)), 0);
+	std::vector<uint8_t> compressed(encoding == Encoding::Lz4 ? Lz4::CompressBound(frameBytes) : 0);
+
+	for (int i = 0; i < frameCount; ++i) {
+		const uint8_t* pixels = frames[i];
+		FrameEntry& entry = entries[static_cast<size_t>(i)];
+
+		// Pixel data: compressed only when it actually saves space
+		const uint8_t* stored = pixels;
+		size_t storedSize = frameBytes;
+		entry.encoding = static_cast<uint32_t>(Encoding::Raw);
+		if (encoding == Encoding::Lz4) {
+			const size_t size = Lz4::Compress(pixels, frameBytes, compressed.data(), compressed.size());
+			if (size != 0 && size < frameBytes) {
+				stored = compressed.data();
+				storedSize = size;
+				entry.encoding = static_cast<uint32_t>(Encoding::Lz4);
+			}
+		}
+		entry.dataOffset = static_cast<uint32_t>(out.size());
+		entry.storedSize = static_cast<uint32_t>(storedSize);
+		out.insert(out.end(), stored, stored + storedSize);
+		out.resize(AlignUp(out.size()), 0);
+	}
+
+	header.fileSize = static_cast<uint32_t>(out.size());
+	memcpy(out.data(), &header, sizeof(header));
+	memcpy(out.data() + sizeof(header), entries.data(), entries.size() * sizeof(FrameEntry));
+	return out;
+}
+
+bool SkinContainer::Parse(const uint8_t* data, size_t size, View& view) {
+	view = View();
+	if (!data || size < sizeof(Header)) return false;
+	const Header* header = reinterpret_cast<const Header*>(data);
+	if (header->magic != MAGIC || header->version != VERSION || header->fileSize != size) return false;
+	if (header->frameCount == 0 || header->frameCount > MAX_FRAMES ||
+		header->width == 0 || header->height == 0 || header->width > MAX_DIMENSION || header->height > MAX_DIMENSION) {
+		return false;
+	}
+	if (size < sizeof(Header) + header->frameCount * sizeof(FrameEntry)) return false;
+
+	const FrameEntry* frames = reinterpret_cast<const FrameEntry*>(data + sizeof(Header));
+	const size_t frameBytes = FrameBytes(header->width, header->height);
+	for (int i = 0; i < header->frameCount; ++i) {
+		const FrameEntry& entry = frames[i];
+		if (!BlockInside(entry.dataOffset, entry.storedSize, size)) return false;
+		if (entry.encoding == static_cast<uint32_t>(Encoding::Raw) ? entry.storedSize != frameBytes
+			: entry.encoding != static_cast<uint32_t>(Encoding::Lz4)) {
+			return false;
+		}
+	}
+	view.base = data;
+	view.header = header;
+	view.frames = frames;
+	return true;
+}
+
+bool SkinContainer::DecodeFrame(const View& view, int index, uint8_t* dst) {
+	if (!view.header || !dst || index < 0 || index >= view.header->frameCount) return false;
+	const FrameEntry& entry = view.frames[index];
+	const size_t frameBytes = FrameBytes(view.header->width, view.header->height);
+	if (entry.encoding == static_cast<uint32_t>(Encoding::Raw)) {
+		memcpy(dst, view.base + entry.dataOffset, frameBytes);
+		return true;
+	}
+	return Lz4::Decompress(view.base + entry.dataOffset, entry.storedSize, dst, frameBytes);
+}
+
+std::u16string SkinContainer::GetName(const View& view) {
+	std::u16string name;
+	if (!view.header) return name;
+	for (int i = 0; i < NAME_LENGTH && view.header->name[i]; ++i) {
+		name.push_back(static_cast<char16_t>(view.header->name[i]));
+	}
+	return name;
+}
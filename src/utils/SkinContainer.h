@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// .bcskin: one skin in a single file. Frames are stored pre-decoded as top-down premultiplied
+// BGRA, raw or LZ4. Little-endian; every block starts on BLOCK_ALIGNMENT so a mapped file
+// is read in place.
+namespace SkinContainer {
+	constexpr uint32_t MAGIC = 0x4E4B5342; // "BSKN"
+	constexpr uint16_t VERSION = 2; // 1 also stored hit masks, bounds and dirty rects nothing read
+	constexpr size_t BLOCK_ALIGNMENT = 64;
+	constexpr int NAME_LENGTH = 32;
+	constexpr int MAX_FRAMES = 16;
+	constexpr int MAX_DIMENSION = 2048;
+	constexpr uint32_t FLAG_PIXEL_ART = 1;
+
+	enum class Encoding : uint32_t {
+		Raw = 0,
+		Lz4 = 1
+	};
+
+	struct Header {
+		uint32_t magic;
+		uint16_t version;
+		uint16_t frameCount;
+		uint16_t width;
+		uint16_t height;
+		uint32_t flags;
+		uint32_t unlockThreshold;
+		uint32_t fileSize;
+		uint16_t name[NAME_LENGTH]; // UTF-16, zero-padded
+	};
+	static_assert(sizeof(Header) == 88, "Header layout is part of the file format");
+
+	// Follows the header; one per frame, frame 0 is the rest frame
+	struct FrameEntry {
+		uint32_t encoding;
+		uint32_t dataOffset;
+		uint32_t storedSize;
+	};
+	static_assert(sizeof(FrameEntry) == 12, "FrameEntry layout is part of the file format");
+
+	struct Metadata {
+		std::u16string name;
+		uint32_t unlockThreshold = 0;
+		bool pixelArt = false;
+	};
+
+	// Validated view over a container in memory; pointers live as long as the bytes do
+	struct View {
+		const uint8_t* base = nullptr;
+		const Header* header = nullptr;
+		const FrameEntry* frames = nullptr;
+	};
+
+	// Serializes `frameCount` frames of width * height BGRA. Lz4 falls back to raw per frame
+	// when compression does not pay off. Returns an empty buffer on invalid input.
+	std::vector<uint8_t> Build(const Metadata& metadata, int width, int height,
+		const uint8_t* const* frames, int frameCount, Encoding encoding);
+
+	// Checks magic, version and that every block lies inside the buffer
+	bool Parse(const uint8_t* data, size_t size, View& view);
+
+	// Expands a frame to width * height * 4 bytes at dst
+	bool DecodeFrame(const View& view, int index, uint8_t* dst);
+	std::u16string GetName(const View& view);
+}
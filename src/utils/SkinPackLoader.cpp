@@ -0,0 +1,142 @@
+#include "SkinPackLoader.h"
+#include "Configuration.h"
+#include "Resampler.h"
+#include "SkinContainer.h"
+#include "FileIO.h"
+#include "FrameCache.h"
+#include "RAII/Com.h"
+#include "../managers/ImageManager.h"
+#include <wincodec.h>
+#include <climits>
+#include <iterator>
+#include <vector>
+
+namespace {
+	std::shared_ptr<SkinPackFrame> CreateFrame(void** bits) {
+		HBITMAP dib = ImageManager::CreateFrameBitmap(Configuration::IMAGE_WIDTH, Configuration::IMAGE_HEIGHT, bits);
+		if (!dib) return nullptr;
+		auto frame = std::make_shared<SkinPackFrame>();
+		frame->bitmap = BitmapWrapper(dib, true);
+		return frame;
+	}
+}
+
+void SkinPackLoader::ReadManifest(const std::wstring& folderPath, SkinPack& pack) {
+	const std::wstring manifest = folderPath + L"\\" + Configuration::SKIN_PACK_MANIFEST;
+	wchar_t name[64] = { 0 };
+	GetPrivateProfileStringW(L"Skin", L"Name", pack.folder.c_str(), name,
+		static_cast<DWORD>(std::size(name)), manifest.c_str());
+	pack.name = name[0] ? name : pack.folder;
+	const int unlock = static_cast<int>(GetPrivateProfileIntW(L"Skin", L"Unlock", 0, manifest.c_str()));
+	pack.unlockThreshold = unlock < 0 ? 0 : unlock;
+	pack.pixelArt = GetPrivateProfileIntW(L"Skin", L"PixelArt", 0, manifest.c_str()) != 0;
+}
+
+std::shared_ptr<const SkinPackFrame> SkinPackLoader::DecodePng(IWICImagingFactory* factory, const std::wstring& path, bool pixelArt) {
+	if (!factory) return nullptr;
+	FileIO::MappedFile source;
+	if (!source.Open(path, static_cast<ULONGLONG>(Configuration::SKIN_PACK_MAX_FRAME_BYTES))) return nullptr;
+
+	void* bits = nullptr;
+	std::shared_ptr<SkinPackFrame> frame = CreateFrame(&bits);
+	if (!frame) return nullptr;
+	frame->fileSize = source.size();
+	frame->writeTime = source.writeTime();
+
+	// Keyed by content, so a touched but unchanged file is still a hit
+	const uint64_t cacheKey = FrameCache::MakeKey(FrameCache::Hash(source.data(), static_cast<size_t>(source.size())),
+		Configuration::IMAGE_WIDTH, Configuration::IMAGE_HEIGHT, 1,
+		pixelArt ? FrameCache::PackFramePixelArt : FrameCache::PackFrame);
+	uint8_t* frameBits = static_cast<uint8_t*>(bits);
+	if (FrameCache::Load(cacheKey, Configuration::IMAGE_WIDTH, Configuration::IMAGE_HEIGHT, 1, &frameBits)) {
+		return frame;
+	}
+
+	IWICStream* rawStream = nullptr;
+	if (FAILED(factory->CreateStream(&rawStream))) return nullptr;
+	ComWrapper<IWICStream> stream(rawStream, true);
+	if (FAILED(stream.get()->InitializeFromMemory(const_cast<BYTE*>(source.data()), static_cast<DWORD>(source.size())))) return nullptr;
+
+	IWICBitmapDecoder* rawDecoder = nullptr;
+	if (FAILED(factory->CreateDecoderFromStream(stream.get(), nullptr, WICDecodeMetadataCacheOnDemand, &rawDecoder))) return nullptr;
+	ComWrapper<IWICBitmapDecoder> decoder(rawDecoder, true);
+	IWICBitmapFrameDecode* rawFrame = nullptr;
+	if (FAILED(decoder.get()->GetFrame(0, &rawFrame))) return nullptr;
+	ComWrapper<IWICBitmapFrameDecode> decoded(rawFrame, true);
+
+	UINT width = 0;
+	UINT height = 0;
+	if (FAILED(decoded.get()->GetSize(&width, &height)) || width == 0 || height == 0) return nullptr;
+
+	// Off-size art is fitted once here so every later path sees native-size frames
+	IWICBitmapSource* bitmapSource = decoded.get();
+	ComWrapper<IWICBitmapScaler> scaler;
+	if (width != Configuration::IMAGE_WIDTH || height != Configuration::IMAGE_HEIGHT) {
+		IWICBitmapScaler* rawScaler = nullptr;
+		if (FAILED(factory->CreateBitmapScaler(&rawScaler))) return nullptr;
+		scaler = ComWrapper<IWICBitmapScaler>(rawScaler, true);
+		const WICBitmapInterpolationMode mode = pixelArt
+			? WICBitmapInterpolationModeNearestNeighbor
+			: WICBitmapInterpolationModeFant;
+		if (FAILED(scaler.get()->Initialize(bitmapSource, Configuration::IMAGE_WIDTH, Configuration::IMAGE_HEIGHT, mode))) return nullptr;
+		bitmapSource = scaler.get();
+	}
+
+	IWICFormatConverter* rawConverter = nullptr;
+	if (FAILED(factory->CreateFormatConverter(&rawConverter))) return nullptr;
+	ComWrapper<IWICFormatConverter> converter(rawConverter, true);
+	if (FAILED(converter.get()->Initialize(bitmapSource, GUID_WICPixelFormat32bppPBGRA, WICBitmapDitherTypeNone,
+		nullptr, 0.0, WICBitmapPaletteTypeCustom))) return nullptr;
+
+	const UINT stride = Configuration::IMAGE_WIDTH * Configuration::BYTES_PER_PIXEL;
+	if (FAILED(converter.get()->CopyPixels(nullptr, stride, stride * Configuration::IMAGE_HEIGHT, static_cast<BYTE*>(bits)))) {
+		return nullptr;
+	}
+	const uint8_t* pixels = frameBits;
+	FrameCache::Store(cacheKey, Configuration::IMAGE_WIDTH, Configuration::IMAGE_HEIGHT, 1, &pixels);
+	return frame;
+}
+
+bool SkinPackLoader::LoadContainer(const std::wstring& path, SkinPack& pack) {
+	FileIO::MappedFile source;
+	if (!source.Open(path, static_cast<ULONGLONG>(Configuration::SKIN_PACK_MAX_CONTAINER_BYTES))) return false;
+	SkinContainer::View view;
+	if (!SkinContainer::Parse(source.data(), static_cast<size_t>(source.size()), view)) return false;
+	if (view.header->frameCount < Configuration::NUMBER_IMAGES) return false;
+
+	const std::u16string name = SkinContainer::GetName(view);
+	pack.name = name.empty() ? pack.folder : std::wstring(name.begin(), name.end());
+	pack.unlockThreshold = static_cast<int>(view.header->unlockThreshold > INT_MAX ? INT_MAX : view.header->unlockThreshold);
+	pack.pixelArt = (view.header->flags & SkinContainer::FLAG_PIXEL_ART) != 0;
+
+	const int width = view.header->width;
+	const int height = view.header->height;
+	const bool nativeSize = width == Configuration::IMAGE_WIDTH && height == Configuration::IMAGE_HEIGHT;
+	std::vector<BYTE> scratch(nativeSize ? 0 : static_cast<size_t>(width) * height * Configuration::BYTES_PER_PIXEL);
+	for (int i = 0; i < Configuration::NUMBER_IMAGES; ++i) {
+		void* bits = nullptr;
+		std::shared_ptr<SkinPackFrame> frame = CreateFrame(&bits);
+		if (!frame) return false;
+		BYTE* dst = static_cast<BYTE*>(bits);
+		if (nativeSize) {
+			// Raw frames are one copy out of the mapping; LZ4 frames expand in place
+			if (!SkinContainer::DecodeFrame(view, i, dst)) return false;
+		}
+		else {
+			if (!SkinContainer::DecodeFrame(view, i, scratch.data())) return false;
+			Resampler::Resize(scratch.data(), width, height, width * Configuration::BYTES_PER_PIXEL,
+				dst, Configuration::IMAGE_WIDTH, Configuration::IMAGE_HEIGHT, Configuration::IMAGE_WIDTH * Configuration::BYTES_PER_PIXEL,
+				pack.pixelArt ? Resampler::Filter::Nearest : Resampler::Filter::Bilinear);
+		}
+		frame->fileSize = source.size();
+		frame->writeTime = source.writeTime();
+		pack.frames[i] = std::move(frame);
+	}
+	return true;
+}
+
+const BYTE* SkinPackLoader::GetPixels(const SkinPackFrame& frame) {
+	DIBSECTION section = {};
+	if (GetObjectW(frame.bitmap.get(), sizeof(section), &section) != sizeof(section)) return nullptr;
+	return static_cast<const BYTE*>(section.dsBm.bmBits);
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <windows.h>
+#include <memory>
+#include <string>
+#include "SkinPacks.h"
+
+struct IWICImagingFactory;
+
+// Decoding for skin packs; safe to call from any thread
+namespace SkinPackLoader {
+	// Reads skin.ini from a pack folder; the folder name stands in for a missing name
+	void ReadManifest(const std::wstring& folderPath, SkinPack& pack);
+
+	// Decodes a PNG straight out of a read-only file mapping, fitted to IMAGE_WIDTH x IMAGE_HEIGHT
+	std::shared_ptr<const SkinPackFrame> DecodePng(IWICImagingFactory* factory, const std::wstring& path, bool pixelArt);
+
+	// Loads a whole .bcskin file into `pack` (name, unlock, pixel art and every frame)
+	bool LoadContainer(const std::wstring& path, SkinPack& pack);
+
+	// Top-down premultiplied BGRA bits of a decoded frame
+	const BYTE* GetPixels(const SkinPackFrame& frame);
+}
@@ -0,0 +1,48 @@
+#include "SkinPacks.h"
+
+namespace {
+	std::shared_ptr<const SkinPackCatalog> g_catalog;
+}
+
+namespace SkinPacks {
+	void Adopt(std::shared_ptr<const SkinPackCatalog> catalog) {
+		g_catalog = std::move(catalog);
+	}
+
+	int Count() {
+		return g_catalog ? static_cast<int>(g_catalog->packs.size()) : 0;
+	}
+
+	const SkinPack* Find(int skinId) {
+		const int index = skinId - Configuration::SKIN_COUNT;
+		if (index < 0 || index >= Count()) return nullptr;
+		return &g_catalog->packs[static_cast<size_t>(index)];
+	}
+
+	int FindFolder(const std::wstring& folder) {
+		for (int i = 0; i < Count(); ++i) {
+			if (_wcsicmp(g_catalog->packs[static_cast<size_t>(i)].folder.c_str(), folder.c_str()) == 0) {
+				return Configuration::SKIN_COUNT + i;
+			}
+		}
+		return -1;
+	}
+
+	int AccessoryCount() {
+		return g_catalog ? static_cast<int>(g_catalog->accessories.size()) : 0;
+	}
+
+	const SkinAccessory* FindAccessory(int accessoryId) {
+		if (accessoryId < 0 || accessoryId >= AccessoryCount()) return nullptr;
+		return &g_catalog->accessories[static_cast<size_t>(accessoryId)];
+	}
+
+	int FindAccessoryFile(const std::wstring& file) {
+		for (int i = 0; i < AccessoryCount(); ++i) {
+			if (_wcsicmp(g_catalog->accessories[static_cast<size_t>(i)].file.c_str(), file.c_str()) == 0) {
+				return i;
+			}
+		}
+		return -1;
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <windows.h>
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Configuration.h"
+#include "RAII/Gdi.h"
+
+// One decoded pack frame, identified by its source file's size and write time
+struct SkinPackFrame {
+	BitmapWrapper bitmap; // top-down premultiplied DIB at IMAGE_WIDTH x IMAGE_HEIGHT
+	ULONGLONG fileSize = 0;
+	FILETIME writeTime = {};
+};
+
+// A skin folder from the packs directory
+struct SkinPack {
+	std::wstring folder; // stable identity across rescans
+	std::wstring name;   // shown in the tray
+	int unlockThreshold = 0;
+	bool pixelArt = false;
+	std::array<std::shared_ptr<const SkinPackFrame>, Configuration::NUMBER_IMAGES> frames;
+};
+
+// An overlay from the packs directory's Accessories folder
+struct SkinAccessory {
+	std::wstring file; // stable identity across rescans
+	std::wstring name; // shown in the tray
+	std::shared_ptr<const SkinPackFrame> layer;
+};
+
+// Immutable scan result; unchanged frames are shared with the previous catalog
+struct SkinPackCatalog {
+	std::vector<SkinPack> packs;
+	std::vector<SkinAccessory> accessories;
+};
+
+// UI-thread view of the adopted catalog
+namespace SkinPacks {
+	void Adopt(std::shared_ptr<const SkinPackCatalog> catalog);
+	int Count();
+	// Pack behind a skin id, or nullptr for built-in and unknown ids
+	const SkinPack* Find(int skinId);
+	// Skin id of a pack folder, or -1
+	int FindFolder(const std::wstring& folder);
+
+	int AccessoryCount();
+	// Accessory behind an id, or nullptr
+	const SkinAccessory* FindAccessory(int accessoryId);
+	// Accessory id of a file name, or -1
+	int FindAccessoryFile(const std::wstring& file);
+}
@@ -1,6 +1,7 @@
 #include "SkinPresentation.h"
 #include "Configuration.h"
 #include "Localization.h"
+#include "SkinPacks.h"
 #if __has_include("Resource.h")
 #include "Resource.h"
 #elif __has_include("../../build/Resource.h")
@@ -9,21 +10,18 @@
 
 namespace SkinPresentation {
 	const wchar_t* GetSkinName(int skin) {
-		switch (skin) {
-		case Configuration::SKIN_MARSHMALLOW:
-			return L"Marshmallow";
-		case Configuration::SKIN_MOCHI:
-			return L"Mochi";
-		case Configuration::SKIN_TOFFEE:
-			return L"Toffee";
-		case Configuration::SKIN_HONEY:
-			return L"Honey";
-		case Configuration::SKIN_LATTE:
-			return L"Latte";
-		case Configuration::SKIN_TREACLE:
-			return L"Treacle";
-		default:
-			return L"Unknown";
+		if (skin >= 0 && skin < Configuration::SKIN_COUNT) {
+			return SkinRegistry::SKINS[skin].name;
 		}
+		const SkinPack* pack = SkinPacks::Find(skin);
+		return pack ? pack->name.c_str() : L"Unknown";
+	}
+
+	bool IsPixelArt(int skin) {
+		if (skin >= 0 && skin < Configuration::SKIN_COUNT) {
+			return SkinRegistry::SKINS[skin].pixelArt;
+		}
+		const SkinPack* pack = SkinPacks::Find(skin);
+		return pack && pack->pixelArt;
 	}
 }
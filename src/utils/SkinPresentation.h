@@ -3,4 +3,7 @@
 namespace SkinPresentation {
 	// Mapping from skin id to display name
 	const wchar_t* GetSkinName(int skin);
+
+	// Pixel-art skins scale by whole factors with hard edges; drawn skins are filtered
+	bool IsPixelArt(int skin);
 }
@@ -1,6 +1,8 @@
 #include "SkinService.h"
 #include "SettingsService.h"
 #include "Configuration.h"
+#include <array>
+#include <vector>
 #include "../app/BongoCatApp.h"
 #include "../managers/ImageManager.h"
 #include "../managers/WindowManager.h"
@@ -10,9 +12,139 @@
 static void CommitSkinChangeInternal(BongoCatApp* app, int skinId) {
 	if (!app || !app->GetState()) return;
 	app->GetState()->SetCurrentSkin(skinId);
-	SettingsService::WriteSkin(app->GetState()->GetCurrentSkin());
+	// Pack ids shift as folders come and go, so a pack is remembered by its folder
+	if (const SkinPack* pack = SkinPacks::Find(skinId)) {
+		SettingsService::WriteSkinPack(pack->folder);
+	}
+	else {
+		SettingsService::WriteSkin(skinId);
+		SettingsService::WriteSkinPack(L"");
+	}
 	app->GetState()->GetStateMachine()->HandleEvent(StateEvent::SkinChanged);
+	app->OnImagesChanged();
 	app->RedrawCurrentImage();
+	app->PublishState();
+}
+
+// Hands the layers of a worn set to the image manager; true if the presented frames changed
+static bool WearAccessoriesInternal(BongoCatApp* app, uint32_t accessories) {
+	app->GetState()->SetAccessories(accessories);
+	std::vector<std::shared_ptr<const SkinPackFrame>> layers;
+	for (int id = 0; id < SkinPacks::AccessoryCount(); ++id) {
+		if (accessories & (1u << id)) layers.push_back(SkinPacks::FindAccessory(id)->layer);
+	}
+	return app->GetImageManager() && app->GetImageManager()->SetAccessories(std::move(layers));
+}
+
+// Same skin, new presented frames (accessories, tint or outline changed)
+static void RefreshFramesInternal(BongoCatApp* app) {
+	app->OnImagesChanged();
+	app->RedrawCurrentImage();
+}
+
+// Follows the selected pack into a freshly adopted catalog; true if the skin was reloaded
+static bool AdoptSkinPackInternal(BongoCatApp* app, const std::wstring& folder, bool wasPack, int currentSkin,
+	const std::array<std::shared_ptr<const SkinPackFrame>, Configuration::NUMBER_IMAGES>& previousFrames) {
+	ApplicationState* state = app->GetState();
+	ImageManager* images = app->GetImageManager();
+
+	const int packSkin = folder.empty() ? -1 : SkinPacks::FindFolder(folder);
+	if (packSkin < 0 || !state->CanUnlockSkin(packSkin)) {
+		if (wasPack) {
+			// The old id may now name another pack or nothing; drop to the built-in default
+			if (images && images->LoadImages(Configuration::SKIN_DEFAULT)) {
+				CommitSkinChangeInternal(app, Configuration::SKIN_DEFAULT);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Unchanged pack under the same id: the frames on screen are still current
+	if (wasPack && packSkin == currentSkin && SkinPacks::Find(packSkin)->frames == previousFrames) return false;
+	// Pack frames are already decoded, so reloading only re-references them
+	if (images && images->LoadImages(packSkin)) {
+		CommitSkinChangeInternal(app, packSkin);
+		return true;
+	}
+	return false;
+}
+
+void SkinService::AdoptSkinPacks(BongoCatApp* app, std::shared_ptr<const SkinPackCatalog> catalog) {
+	if (!app || !app->GetState() || !catalog) return;
+	ApplicationState* state = app->GetState();
+
+	// A saved pack is picked up from the first catalog after startup
+	const int currentSkin = state->GetCurrentSkin();
+	const SkinPack* current = SkinPacks::Find(currentSkin);
+	const bool wasPack = current != nullptr;
+	const std::wstring folder = wasPack ? current->folder : SettingsService::ReadSkinPack();
+	std::array<std::shared_ptr<const SkinPackFrame>, Configuration::NUMBER_IMAGES> previousFrames;
+	if (wasPack) previousFrames = current->frames;
+	SkinPacks::Adopt(std::move(catalog));
+
+	// Worn accessories are remembered by file name; one missing for now stays saved and returns with its file
+	uint32_t accessories = 0;
+	for (const std::wstring& file : SettingsService::ReadAccessories()) {
+		const int id = SkinPacks::FindAccessoryFile(file);
+		if (id >= 0) accessories |= 1u << id;
+	}
+	const bool accessoriesChanged = WearAccessoriesInternal(app, accessories);
+	if (!AdoptSkinPackInternal(app, folder, wasPack, currentSkin, previousFrames) && accessoriesChanged) {
+		RefreshFramesInternal(app);
+	}
+}
+
+// Persists and wears a worn set; keepMissing carries over saved accessories whose files are gone for now
+static bool ApplyAccessoriesInternal(BongoCatApp* app, uint32_t accessories, bool keepMissing) {
+	if (!app || !app->GetState()) return false;
+	const int count = SkinPacks::AccessoryCount();
+	if (count < 32 && (accessories >> count) != 0) return false;
+
+	std::vector<std::wstring> files;
+	if (keepMissing) {
+		for (const std::wstring& file : SettingsService::ReadAccessories()) {
+			if (SkinPacks::FindAccessoryFile(file) < 0) files.push_back(file);
+		}
+	}
+	for (int id = 0; id < count; ++id) {
+		if (accessories & (1u << id)) files.push_back(SkinPacks::FindAccessory(id)->file);
+	}
+	SettingsService::WriteAccessories(files);
+	if (WearAccessoriesInternal(app, accessories)) {
+		RefreshFramesInternal(app);
+	}
+	return true;
+}
+
+bool SkinService::ApplyAccessories(BongoCatApp* app, uint32_t accessories) {
+	return ApplyAccessoriesInternal(app, accessories, false);
+}
+
+bool SkinService::ToggleAccessory(BongoCatApp* app, int accessory) {
+	if (!app || !app->GetState() || accessory < 0 || accessory >= SkinPacks::AccessoryCount()) return false;
+	// Toggling one accessory leaves the others alone, including those waiting for their files
+	return ApplyAccessoriesInternal(app, app->GetState()->GetAccessories() ^ (1u << accessory), true);
+}
+
+bool SkinService::ApplyTint(BongoCatApp* app, const ColorTransform::Tint& tint) {
+	if (!app || !app->GetState() || !ColorTransform::IsValid(tint)) return false;
+	app->GetState()->SetTint(tint);
+	SettingsService::WriteTint(tint);
+	if (app->GetImageManager() && app->GetImageManager()->SetTint(tint)) {
+		RefreshFramesInternal(app);
+	}
+	return true;
+}
+
+bool SkinService::ApplyOutline(BongoCatApp* app, int outline) {
+	if (!app || !app->GetState() || !FrameOutline::IsValid(outline)) return false;
+	app->GetState()->SetOutline(outline);
+	SettingsService::WriteOutline(outline);
+	if (app->GetImageManager() && app->GetImageManager()->SetOutline(outline)) {
+		RefreshFramesInternal(app);
+	}
+	return true;
 }
 
 void SkinService::ApplySkinChange(BongoCatApp* app, int newSkin) {
@@ -23,13 +155,13 @@ void SkinService::ApplySkinChange(BongoCatApp* app, int newSkin) {
 
 	if (app->GetState()->GetCurrentSkin() == newSkin) return;
 
-	// Try to load new skin images; fallback to MARSHMALLOW
+	// Try to load new skin images; fallback to the default skin
 	if (app->GetImageManager() && app->GetImageManager()->LoadImages(newSkin)) {
 		CommitSkinChangeInternal(app, newSkin);
 		return;
 	}
 
-	if (app->GetImageManager() && app->GetImageManager()->LoadImages(Configuration::SKIN_MARSHMALLOW)) {
-		CommitSkinChangeInternal(app, Configuration::SKIN_MARSHMALLOW);
+	if (app->GetImageManager() && app->GetImageManager()->LoadImages(Configuration::SKIN_DEFAULT)) {
+		CommitSkinChangeInternal(app, Configuration::SKIN_DEFAULT);
 	}
 }
@@ -1,5 +1,9 @@
 #pragma once
+#include <cstdint>
 #include <memory>
+#include "SkinPacks.h"
+#include "ColorTransform.h"
+#include "FrameOutline.h"
 
 class BongoCatApp;
 
@@ -8,4 +12,16 @@ class SkinService {
 public:
 	// Validates unlock, loads images (fallback), persists, notifies, redraws
 	static void ApplySkinChange(BongoCatApp* app, int newSkin);
+	// Swaps in a rescanned pack catalog; follows the selected pack by folder, reloads it if its
+	// frames changed, and falls back to the default skin if it is gone
+	static void AdoptSkinPacks(BongoCatApp* app, std::shared_ptr<const SkinPackCatalog> catalog);
+	// Wears exactly a set of accessories (bit n = accessory id n), persists it by file name and redraws.
+	// Saved accessories whose files are missing are dropped. False if the set names an accessory that does not exist
+	static bool ApplyAccessories(BongoCatApp* app, uint32_t accessories);
+	// Puts on or takes off one accessory; saved accessories whose files are missing stay saved
+	static bool ToggleAccessory(BongoCatApp* app, int accessory);
+	// Recolors every skin, persists the tint and redraws; false if the tint is out of range
+	static bool ApplyTint(BongoCatApp* app, const ColorTransform::Tint& tint);
+	// Outlines every skin (FrameOutline style), persists it and redraws; false if the style is unknown
+	static bool ApplyOutline(BongoCatApp* app, int outline);
 };
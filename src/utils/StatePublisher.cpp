@@ -0,0 +1,57 @@
+#include "StatePublisher.h"
+#include <new>
+#include "../states/ApplicationState.h"
+
+StatePublisher::StatePublisher()
+	: m_block(nullptr) {
+}
+
+StatePublisher::~StatePublisher() {
+	Shutdown();
+}
+
+bool StatePublisher::Initialize() {
+	Shutdown();
+	// Default security: readable by processes of the same user in this session
+	m_mapping = HandleWrapper(CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+		0, static_cast<DWORD>(sizeof(StateSnapshot::SharedBlock)), StateSnapshot::MAPPING_NAME), true);
+	if (!m_mapping.isValid()) return false;
+
+	void* view = MapViewOfFile(m_mapping.get(), FILE_MAP_WRITE, 0, 0, sizeof(StateSnapshot::SharedBlock));
+	if (!view) {
+		m_mapping = HandleWrapper();
+		return false;
+	}
+
+	// Fresh pages are zeroed; construct the atomics in place, then stamp the header last
+	m_block = new (view) StateSnapshot::SharedBlock();
+	m_block->version = StateSnapshot::VERSION;
+	std::atomic_thread_fence(std::memory_order_release);
+	m_block->magic = StateSnapshot::MAGIC;
+	return true;
+}
+
+void StatePublisher::Shutdown() {
+	if (m_block) {
+		UnmapViewOfFile(m_block);
+		m_block = nullptr;
+	}
+	m_mapping = HandleWrapper();
+}
+
+StateSnapshot::Snapshot StatePublisher::Capture(ApplicationState& state) {
+	const ULONGLONG now = GetTickCount64();
+	StateSnapshot::Snapshot value{};
+	value.catState = static_cast<int32_t>(state.GetCurrentImageIndex());
+	value.skin = static_cast<int32_t>(state.GetCurrentSkin());
+	value.keysPerMinute = state.GetKeyRate().GetPerMinute(now);
+	value.clickCount = static_cast<uint64_t>(state.GetClickCount());
+	value.lastInputTick = state.GetLastInputTick();
+	value.publishTick = now;
+	return value;
+}
+
+void StatePublisher::Publish(const StateSnapshot::Snapshot& value) {
+	if (!m_block) return;
+	StateSnapshot::Write(*m_block, value);
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <windows.h>
+#include "RAII/Handle.h"
+#include "StateSnapshot.h"
+
+class ApplicationState;
+
+// Writer side of the shared state snapshot (UI thread only)
+class StatePublisher {
+private:
+	HandleWrapper m_mapping;
+	StateSnapshot::SharedBlock* m_block;
+
+public:
+	StatePublisher();
+	~StatePublisher();
+
+	// Non-copyable
+	StatePublisher(const StatePublisher&) = delete;
+	StatePublisher& operator=(const StatePublisher&) = delete;
+
+	bool Initialize();
+	void Shutdown();
+
+	// Current state in snapshot form; shared by every in- and out-of-process consumer
+	static StateSnapshot::Snapshot Capture(ApplicationState& state);
+
+	// A few relaxed stores bracketed by the seqlock; no syscalls
+	void Publish(const StateSnapshot::Snapshot& value);
+};
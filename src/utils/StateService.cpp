@@ -7,9 +7,25 @@
 void StateService::LoadInitialState(std::unique_ptr<ApplicationState>& stateOut) {
 	if (!stateOut) return;
 	stateOut->SetClickCount(SettingsService::ReadClickCount());
+	std::array<uint32_t, Configuration::KEY_CODE_COUNT> keyCounts{};
+	SettingsService::ReadKeyPressCounts(keyCounts);
+	stateOut->SetKeyPressCounts(keyCounts);
+	uint64_t mouseDistance = 0, wheelNotches = 0;
+	SettingsService::ReadMouseOdometer(mouseDistance, wheelNotches);
+	stateOut->GetMouseOdometer().Restore(mouseDistance, wheelNotches);
+	stateOut->SetMouseExtrasDrivePaws(SettingsService::ReadMouseExtrasDrivePaws());
+	stateOut->SetTransitionsEnabled(SettingsService::ReadTransitions());
+	const ColorTransform::Tint tint = SettingsService::ReadTint();
+	if (ColorTransform::IsValid(tint)) stateOut->SetTint(tint);
+	const int outline = SettingsService::ReadOutline();
+	if (FrameOutline::IsValid(outline)) stateOut->SetOutline(outline);
+	const int counterMode = SettingsService::ReadCounterMode();
+	if (ValidationUtils::IsValidCounterMode(counterMode)) stateOut->SetCounterMode(counterMode);
+	const int scale = SettingsService::ReadScale();
+	stateOut->SetScale(ValidationUtils::IsValidScale(scale) ? scale : Configuration::SCALE_AUTO);
 	int skin = SettingsService::ReadSkin();
 	if (!ValidationUtils::IsValidSkin(skin)) {
-		skin = Configuration::SKIN_MARSHMALLOW;
+		skin = Configuration::SKIN_DEFAULT;
 	}
 	stateOut->SetCurrentSkin(skin);
 }
@@ -19,12 +35,15 @@ void StateService::ValidateSkinAccess(std::unique_ptr<ApplicationState>& state)
 	const int currentSkin = state->GetCurrentSkin();
 	const int clickCount = state->GetClickCount();
 	if (!ValidationUtils::CanUnlockSkin(currentSkin, clickCount)) {
-		state->SetCurrentSkin(Configuration::SKIN_MARSHMALLOW);
-		SettingsService::WriteSkin(Configuration::SKIN_MARSHMALLOW);
+		state->SetCurrentSkin(Configuration::SKIN_DEFAULT);
+		SettingsService::WriteSkin(Configuration::SKIN_DEFAULT);
 	}
 }
 
 void StateService::PersistOnExit(const std::unique_ptr<ApplicationState>& state) {
 	if (!state) return;
 	SettingsService::WriteClickCount(state->GetClickCount());
+	SettingsService::WriteKeyPressCounts(state->GetKeyPressCounts());
+	SettingsService::WriteMouseOdometer(state->GetMouseOdometer().GetDistancePixels(),
+		state->GetMouseOdometer().GetWheelNotches());
 }
@@ -0,0 +1,125 @@
+#pragma once
+#include <windows.h>
+#include <atomic>
+#include <cstdint>
+
+// Versioned state snapshot shared with external overlays through named shared memory.
+// Single writer (the app's UI thread), any number of read-only readers. A seqlock keeps
+// reads consistent: the sequence is odd while a write is in progress, and a reader retries
+// when it changed under it. Readers never write, so they can neither block nor corrupt the app.
+// This header is the whole reader library; it has no other dependencies on the app.
+namespace StateSnapshot {
+	constexpr LPCWSTR MAPPING_NAME = L"Local\\BongoCat_State";
+	constexpr uint32_t MAGIC = 0x53434342; // "BCCS"
+	constexpr uint32_t VERSION = 1;
+
+	// Shared layout; append-only between versions
+	struct SharedBlock {
+		uint32_t magic;
+		uint32_t version;
+		std::atomic<uint32_t> sequence;
+		std::atomic<int32_t> catState;           // CatState / image index
+		std::atomic<int32_t> skin;
+		std::atomic<uint32_t> keysPerMinute;
+		std::atomic<uint64_t> clickCount;
+		std::atomic<uint64_t> lastInputTick;     // GetTickCount64() of the last counted input
+		std::atomic<uint64_t> publishTick;       // GetTickCount64() of this write
+	};
+
+	static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared atomics must be lock-free");
+
+	// Consistent copy handed to readers
+	struct Snapshot {
+		int32_t catState;
+		int32_t skin;
+		uint32_t keysPerMinute;
+		uint64_t clickCount;
+		uint64_t lastInputTick;
+		uint64_t publishTick;
+	};
+
+	// Writer side: odd sequence while the payload is being stored
+	inline void Write(SharedBlock& block, const Snapshot& value) noexcept {
+		const uint32_t sequence = block.sequence.load(std::memory_order_relaxed);
+		block.sequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		block.catState.store(value.catState, std::memory_order_relaxed);
+		block.skin.store(value.skin, std::memory_order_relaxed);
+		block.keysPerMinute.store(value.keysPerMinute, std::memory_order_relaxed);
+		block.clickCount.store(value.clickCount, std::memory_order_relaxed);
+		block.lastInputTick.store(value.lastInputTick, std::memory_order_relaxed);
+		block.publishTick.store(value.publishTick, std::memory_order_relaxed);
+		block.sequence.store(sequence + 2, std::memory_order_release);
+	}
+
+	// Reader side: false if the writer kept the block busy for all attempts
+	inline bool TryRead(const SharedBlock& block, Snapshot& out, int maxAttempts = 64) noexcept {
+		for (int attempt = 0; attempt < maxAttempts; ++attempt) {
+			const uint32_t before = block.sequence.load(std::memory_order_acquire);
+			if (before & 1) {
+				YieldProcessor();
+				continue;
+			}
+			out.catState = block.catState.load(std::memory_order_relaxed);
+			out.skin = block.skin.load(std::memory_order_relaxed);
+			out.keysPerMinute = block.keysPerMinute.load(std::memory_order_relaxed);
+			out.clickCount = block.clickCount.load(std::memory_order_relaxed);
+			out.lastInputTick = block.lastInputTick.load(std::memory_order_relaxed);
+			out.publishTick = block.publishTick.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (block.sequence.load(std::memory_order_relaxed) == before) {
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+// Read-only view for overlays: Open() once, then Read() as often as needed (no syscalls)
+class StateSnapshotReader {
+private:
+	HANDLE m_mapping;
+	const StateSnapshot::SharedBlock* m_block;
+
+public:
+	StateSnapshotReader() : m_mapping(nullptr), m_block(nullptr) {}
+	~StateSnapshotReader() { Close(); }
+
+	// Non-copyable
+	StateSnapshotReader(const StateSnapshotReader&) = delete;
+	StateSnapshotReader& operator=(const StateSnapshotReader&) = delete;
+
+	bool Open() {
+		Close();
+		m_mapping = OpenFileMappingW(FILE_MAP_READ, FALSE, StateSnapshot::MAPPING_NAME);
+		if (!m_mapping) return false;
+		void* view = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, sizeof(StateSnapshot::SharedBlock));
+		if (!view) {
+			Close();
+			return false;
+		}
+		m_block = static_cast<const StateSnapshot::SharedBlock*>(view);
+		if (m_block->magic != StateSnapshot::MAGIC || m_block->version < StateSnapshot::VERSION) {
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	void Close() {
+		if (m_block) {
+			UnmapViewOfFile(m_block);
+			m_block = nullptr;
+		}
+		if (m_mapping) {
+			CloseHandle(m_mapping);
+			m_mapping = nullptr;
+		}
+	}
+
+	bool IsOpen() const { return m_block != nullptr; }
+
+	bool Read(StateSnapshot::Snapshot& out) const {
+		return m_block && StateSnapshot::TryRead(*m_block, out);
+	}
+};
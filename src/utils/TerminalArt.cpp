@@ -0,0 +1,269 @@
+#include "TerminalArt.h"
+
+namespace {
+	// Pen colors besides 0xRRGGBB
+	constexpr uint32_t PEN_DEFAULT = 0xFE000000u; // SGR 39 / 49
+	constexpr uint32_t PEN_UNKNOWN = 0xFD000000u; // whatever earlier output left
+	constexpr uint32_t PEN_ANY = 0xFC000000u;     // the glyph does not show it
+
+	const char GLYPH_SPACE[] = " ";
+	const char GLYPH_UPPER[] = "\xE2\x96\x80"; // U+2580 upper half block
+	const char GLYPH_LOWER[] = "\xE2\x96\x84"; // U+2584 lower half block
+	const char GLYPH_FULL[] = "\xE2\x96\x88";  // U+2588 full block
+
+	struct Pen {
+		uint32_t foreground;
+		uint32_t background;
+	};
+
+	// One way to show a cell
+	struct Encoding {
+		const char* glyph;
+		size_t glyphBytes;
+		Pen pen;
+	};
+
+	size_t DecimalLength(uint32_t value) {
+		size_t length = 1;
+		while (value >= 10) {
+			value /= 10;
+			++length;
+		}
+		return length;
+	}
+
+	void AppendDecimal(std::string& out, uint32_t value) {
+		char digits[10];
+		int length = 0;
+		do {
+			digits[length++] = static_cast<char>('0' + value % 10);
+			value /= 10;
+		} while (value != 0);
+		while (length > 0) out.push_back(digits[--length]);
+	}
+
+	size_t ColorParameterLength(uint32_t color) {
+		if (color == PEN_DEFAULT) return 2; // "39" / "49"
+		return 5 + DecimalLength((color >> 16) & 0xFF) + 1 + DecimalLength((color >> 8) & 0xFF) + 1 + DecimalLength(color & 0xFF);
+	}
+
+	void AppendColorParameter(std::string& out, uint32_t color, char base) {
+		out.push_back(base);
+		if (color == PEN_DEFAULT) {
+			out.push_back('9');
+			return;
+		}
+		out += "8;2;";
+		AppendDecimal(out, (color >> 16) & 0xFF);
+		out.push_back(';');
+		AppendDecimal(out, (color >> 8) & 0xFF);
+		out.push_back(';');
+		AppendDecimal(out, color & 0xFF);
+	}
+
+	bool NeedsForeground(const Pen& pen, const Encoding& encoding) {
+		return encoding.pen.foreground != PEN_ANY && encoding.pen.foreground != pen.foreground;
+	}
+
+	bool NeedsBackground(const Pen& pen, const Encoding& encoding) {
+		return encoding.pen.background != PEN_ANY && encoding.pen.background != pen.background;
+	}
+
+	// Bytes to draw the cell from `pen`: one combined SGR for whatever changes, then the glyph
+	size_t EncodingCost(const Pen& pen, const Encoding& encoding) {
+		const bool foreground = NeedsForeground(pen, encoding);
+		const bool background = NeedsBackground(pen, encoding);
+		size_t cost = encoding.glyphBytes;
+		if (foreground || background) {
+			cost += 3; // ESC [ ... m
+			if (foreground) cost += ColorParameterLength(encoding.pen.foreground);
+			if (background) cost += ColorParameterLength(encoding.pen.background);
+			if (foreground && background) cost += 1;
+		}
+		return cost;
+	}
+
+	// Cheapest way to show (top, bottom) given the current pen
+	Encoding ChooseEncoding(const Pen& pen, uint32_t top, uint32_t bottom) {
+		using TerminalArt::EMPTY;
+		Encoding candidates[2];
+		int count = 0;
+		if (top == EMPTY && bottom == EMPTY) {
+			candidates[count++] = { GLYPH_SPACE, 1, { PEN_ANY, PEN_DEFAULT } };
+		}
+		else if (bottom == EMPTY) {
+			candidates[count++] = { GLYPH_UPPER, 3, { top, PEN_DEFAULT } };
+		}
+		else if (top == EMPTY) {
+			candidates[count++] = { GLYPH_LOWER, 3, { bottom, PEN_DEFAULT } };
+		}
+		else if (top == bottom) {
+			candidates[count++] = { GLYPH_SPACE, 1, { PEN_ANY, top } };
+			candidates[count++] = { GLYPH_FULL, 3, { top, PEN_ANY } };
+		}
+		else {
+			candidates[count++] = { GLYPH_UPPER, 3, { top, bottom } };
+			candidates[count++] = { GLYPH_LOWER, 3, { bottom, top } };
+		}
+		Encoding best = candidates[0];
+		size_t bestCost = EncodingCost(pen, best);
+		for (int i = 1; i < count; ++i) {
+			const size_t cost = EncodingCost(pen, candidates[i]);
+			if (cost < bestCost) {
+				best = candidates[i];
+				bestCost = cost;
+			}
+		}
+		return best;
+	}
+
+	void AppendCell(std::string& out, Pen& pen, uint32_t top, uint32_t bottom) {
+		const Encoding encoding = ChooseEncoding(pen, top, bottom);
+		const bool foreground = NeedsForeground(pen, encoding);
+		const bool background = NeedsBackground(pen, encoding);
+		if (foreground || background) {
+			out += "\x1b[";
+			if (foreground) {
+				AppendColorParameter(out, encoding.pen.foreground, '3');
+				pen.foreground = encoding.pen.foreground;
+			}
+			if (foreground && background) out.push_back(';');
+			if (background) {
+				AppendColorParameter(out, encoding.pen.background, '4');
+				pen.background = encoding.pen.background;
+			}
+			out.push_back('m');
+		}
+		out.append(encoding.glyph, encoding.glyphBytes);
+	}
+
+	// Cursor moves, 0-based; column == columns means the cursor sits past the row end
+	size_t ForwardCost(int distance) {
+		return distance == 1 ? 3 : 3 + DecimalLength(static_cast<uint32_t>(distance)); // ESC [ n C
+	}
+
+	size_t AbsoluteCost(int row, int column) {
+		// ESC [ row H, or ESC [ row ; column H
+		return 3 + DecimalLength(static_cast<uint32_t>(row + 1)) + (column > 0 ? 1 + DecimalLength(static_cast<uint32_t>(column + 1)) : 0);
+	}
+
+	void AppendForward(std::string& out, int distance) {
+		out += "\x1b[";
+		if (distance != 1) AppendDecimal(out, static_cast<uint32_t>(distance));
+		out.push_back('C');
+	}
+
+	void AppendAbsolute(std::string& out, int row, int column) {
+		out += "\x1b[";
+		AppendDecimal(out, static_cast<uint32_t>(row + 1));
+		if (column > 0) {
+			out.push_back(';');
+			AppendDecimal(out, static_cast<uint32_t>(column + 1));
+		}
+		out.push_back('H');
+	}
+
+	// Draws every cell where `changed` holds, in reading order, choosing per gap between
+	// re-sending the unchanged cells, a forward move, a line feed or an absolute move
+	template <typename Changed>
+	void AppendCells(const TerminalArt::Grid& grid, Pen pen, int cursorRow, int cursorColumn, Changed changed, std::string& out) {
+		const int columns = grid.columns;
+		for (int row = 0; row < grid.rows; ++row) {
+			for (int column = 0; column < columns; ++column) {
+				const size_t index = static_cast<size_t>(row) * columns + column;
+				if (!changed(index)) continue;
+
+				if (row == cursorRow && column >= cursorColumn && cursorColumn < columns) {
+					const int distance = column - cursorColumn;
+					if (distance > 0) {
+						// Re-sending the gap can beat a move when it is short and the colors line up
+						size_t rewriteCost = 0;
+						Pen simulated = pen;
+						const size_t moveCost = ForwardCost(distance);
+						for (int gap = cursorColumn; gap < column && rewriteCost < moveCost; ++gap) {
+							const size_t gapIndex = static_cast<size_t>(row) * columns + gap;
+							const Encoding encoding = ChooseEncoding(simulated, grid.top[gapIndex], grid.bottom[gapIndex]);
+							rewriteCost += EncodingCost(simulated, encoding);
+							if (NeedsForeground(simulated, encoding)) simulated.foreground = encoding.pen.foreground;
+							if (NeedsBackground(simulated, encoding)) simulated.background = encoding.pen.background;
+						}
+						if (rewriteCost < moveCost) {
+							for (int gap = cursorColumn; gap < column; ++gap) {
+								const size_t gapIndex = static_cast<size_t>(row) * columns + gap;
+								AppendCell(out, pen, grid.top[gapIndex], grid.bottom[gapIndex]);
+							}
+						}
+						else {
+							AppendForward(out, distance);
+						}
+					}
+				}
+				else {
+					// CR LF reaches the next row's first columns in two bytes
+					const size_t absoluteCost = AbsoluteCost(row, column);
+					const size_t newlineCost = 2 + (column > 0 ? ForwardCost(column) : 0);
+					if (cursorRow >= 0 && row == cursorRow + 1 && newlineCost < absoluteCost) {
+						out += "\r\n";
+						if (column > 0) AppendForward(out, column);
+					}
+					else {
+						AppendAbsolute(out, row, column);
+					}
+				}
+				AppendCell(out, pen, grid.top[index], grid.bottom[index]);
+				cursorRow = row;
+				cursorColumn = column + 1;
+			}
+		}
+	}
+}
+
+TerminalArt::Grid TerminalArt::FromPixels(const uint8_t* pixels, int width, int height) {
+	Grid grid;
+	if (!pixels || width <= 0 || height <= 0) return grid;
+	grid.columns = width;
+	grid.rows = (height + 1) / 2;
+	const size_t cellCount = static_cast<size_t>(grid.columns) * grid.rows;
+	grid.top.assign(cellCount, EMPTY);
+	grid.bottom.assign(cellCount, EMPTY);
+	for (int y = 0; y < height; ++y) {
+		std::vector<uint32_t>& half = (y % 2 == 0) ? grid.top : grid.bottom;
+		const uint8_t* row = pixels + static_cast<size_t>(y) * width * 4;
+		for (int x = 0; x < width; ++x) {
+			const uint32_t alpha = row[x * 4 + 3];
+			if (alpha < ALPHA_THRESHOLD) continue;
+			// Terminals have no alpha: unpremultiply and draw the pixel opaque
+			const uint32_t blue = (row[x * 4 + 0] * 255u + alpha / 2) / alpha;
+			const uint32_t green = (row[x * 4 + 1] * 255u + alpha / 2) / alpha;
+			const uint32_t red = (row[x * 4 + 2] * 255u + alpha / 2) / alpha;
+			half[static_cast<size_t>(y / 2) * width + x] = ((red > 255 ? 255 : red) << 16) | ((green > 255 ? 255 : green) << 8) | (blue > 255 ? 255 : blue);
+		}
+	}
+	return grid;
+}
+
+void TerminalArt::AppendEnter(std::string& out) {
+	out += "\x1b[?1049h\x1b[?25l";
+}
+
+void TerminalArt::AppendLeave(std::string& out) {
+	out += "\x1b[0m\x1b[?25h\x1b[?1049l";
+}
+
+void TerminalArt::AppendPaint(const Grid& grid, std::string& out) {
+	// A cleared screen already shows every fully transparent cell
+	out += "\x1b[0m\x1b[2J";
+	AppendCells(grid, { PEN_DEFAULT, PEN_DEFAULT }, -1, 0, [&](size_t index) {
+		return grid.top[index] != EMPTY || grid.bottom[index] != EMPTY;
+	}, out);
+}
+
+void TerminalArt::AppendDiff(const Grid& from, const Grid& to, std::string& out) {
+	if (from.columns != to.columns || from.rows != to.rows) {
+		AppendPaint(to, out);
+		return;
+	}
+	AppendCells(to, { PEN_UNKNOWN, PEN_UNKNOWN }, -1, 0, [&](size_t index) {
+		return from.top[index] != to.top[index] || from.bottom[index] != to.bottom[index];
+	}, out);
+}
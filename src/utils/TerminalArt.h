@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Frames as VT text: each cell is two pixels stacked under an upper or lower half block,
+// drawn with 24-bit SGR colors. Transitions between frames are precomputed as minimal diffs.
+namespace TerminalArt {
+	// Cell half colors are 0xRRGGBB, or EMPTY where pixels below ALPHA_THRESHOLD show the terminal's own background
+	constexpr uint32_t EMPTY = 0xFF000000u;
+	constexpr uint8_t ALPHA_THRESHOLD = 128;
+
+	struct Grid {
+		int columns = 0;
+		int rows = 0;
+		std::vector<uint32_t> top;    // upper pixel of each cell, row-major
+		std::vector<uint32_t> bottom; // lower pixel of each cell
+	};
+
+	// Top-down premultiplied BGRA; an odd last pixel row gets a transparent lower half
+	Grid FromPixels(const uint8_t* pixels, int width, int height);
+
+	// Alternate screen and hidden cursor, and their undo
+	void AppendEnter(std::string& out);
+	void AppendLeave(std::string& out);
+	// Clears the screen and draws the grid from the top-left corner
+	void AppendPaint(const Grid& grid, std::string& out);
+	// Redraws only the cells that differ; assumes nothing about the cursor or colors left by earlier output
+	void AppendDiff(const Grid& from, const Grid& to, std::string& out);
+}
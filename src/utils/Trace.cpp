@@ -0,0 +1,186 @@
+#include "Trace.h"
+
+#if BONGOCAT_TRACING
+#include <windows.h>
+#include <shlobj.h>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Configuration.h"
+#include "RAII/Handle.h"
+
+namespace {
+	constexpr uint64_t INSTANT = UINT64_MAX;
+	constexpr uint64_t RING_SIZE = Configuration::TRACE_RING_EVENTS;
+	static_assert((RING_SIZE & (RING_SIZE - 1)) == 0, "Ring size must be a power of two");
+
+	// Relaxed atomics so the exporting thread may read while the owner writes
+	struct Slot {
+		std::atomic<const char*> name;
+		std::atomic<uint64_t> start;
+		std::atomic<uint64_t> duration;
+	};
+
+	struct ThreadRing {
+		std::atomic<uint64_t> head{ 0 };
+		DWORD threadId = 0;
+		Slot slots[RING_SIZE] = {};
+	};
+
+	struct Event {
+		const char* name;
+		uint64_t start;
+		uint64_t duration;
+		DWORD threadId;
+	};
+
+	// Rings outlive their threads so a trace still shows work from exited workers
+	struct Registry {
+		std::mutex mutex;
+		std::vector<std::unique_ptr<ThreadRing>> rings;
+	};
+
+	Registry& GetRegistry() {
+		static Registry registry;
+		return registry;
+	}
+
+	// Clock origin for converting raw timestamps to microseconds
+	struct Origin {
+		uint64_t raw;
+		LARGE_INTEGER qpc;
+		Origin() : raw(Trace::Now()), qpc() { QueryPerformanceCounter(&qpc); }
+	};
+	const Origin g_origin;
+
+	thread_local ThreadRing* t_ring = nullptr;
+
+	ThreadRing* CreateRing() {
+		auto ring = std::make_unique<ThreadRing>();
+		ring->threadId = GetCurrentThreadId();
+		Registry& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		registry.rings.push_back(std::move(ring));
+		return registry.rings.back().get();
+	}
+
+	void Append(const char* name, uint64_t start, uint64_t duration) noexcept {
+		ThreadRing* ring = t_ring;
+		if (!ring) {
+			try {
+				ring = t_ring = CreateRing();
+			}
+			catch (...) {
+				return;
+			}
+		}
+		// Single writer: fill the slot, then publish it by advancing head
+		const uint64_t index = ring->head.load(std::memory_order_relaxed);
+		Slot& slot = ring->slots[index & (RING_SIZE - 1)];
+		slot.name.store(name, std::memory_order_relaxed);
+		slot.start.store(start, std::memory_order_relaxed);
+		slot.duration.store(duration, std::memory_order_relaxed);
+		ring->head.store(index + 1, std::memory_order_release);
+	}
+
+	// Copies the entries that were not overwritten while copying
+	void CollectRing(const ThreadRing& ring, std::vector<Event>& events) {
+		const uint64_t head = ring.head.load(std::memory_order_acquire);
+		const uint64_t first = head > RING_SIZE ? head - RING_SIZE : 0;
+		const size_t begin = events.size();
+		for (uint64_t index = first; index < head; ++index) {
+			const Slot& slot = ring.slots[index & (RING_SIZE - 1)];
+			events.push_back({ slot.name.load(std::memory_order_relaxed), slot.start.load(std::memory_order_relaxed),
+				slot.duration.load(std::memory_order_relaxed), ring.threadId });
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		// The writer may now be filling index `after`, which reuses the slot of `after - RING_SIZE`
+		const uint64_t after = ring.head.load(std::memory_order_relaxed);
+		const uint64_t oldestValid = after >= RING_SIZE ? after - RING_SIZE + 1 : 0;
+		if (oldestValid > first) {
+			const size_t stale = static_cast<size_t>(oldestValid - first < head - first ? oldestValid - first : head - first);
+			events.erase(events.begin() + static_cast<std::ptrdiff_t>(begin), events.begin() + static_cast<std::ptrdiff_t>(begin + stale));
+		}
+	}
+
+	// Raw ticks per microsecond, measured against QPC since startup
+	double RawTicksPerMicrosecond() {
+#if defined(_M_X64) || defined(_M_IX86)
+		LARGE_INTEGER frequency = {};
+		LARGE_INTEGER now = {};
+		QueryPerformanceFrequency(&frequency);
+		const uint64_t raw = Trace::Now();
+		QueryPerformanceCounter(&now);
+		const double micros = static_cast<double>(now.QuadPart - g_origin.qpc.QuadPart) * 1e6 / static_cast<double>(frequency.QuadPart);
+		if (micros <= 0.0) return 1.0;
+		return static_cast<double>(raw - g_origin.raw) / micros;
+#else
+		LARGE_INTEGER frequency = {};
+		QueryPerformanceFrequency(&frequency);
+		return static_cast<double>(frequency.QuadPart) / 1e6;
+#endif
+	}
+}
+
+void Trace::Span(const char* name, uint64_t start, uint64_t end) noexcept {
+	Append(name, start, end - start);
+}
+
+void Trace::Instant(const char* name) noexcept {
+	Append(name, Now(), INSTANT);
+}
+
+std::wstring Trace::ExportChromeJson() {
+	PWSTR documents = nullptr;
+	if (FAILED(SHGetKnownFolderPath(FOLDERID_Documents, 0, nullptr, &documents)) || !documents) {
+		if (documents) CoTaskMemFree(documents);
+		return L"";
+	}
+	std::wstring path = documents;
+	CoTaskMemFree(documents);
+	path += L"\\";
+	path += Configuration::TRACE_FILE_NAME;
+
+	std::vector<Event> events;
+	{
+		Registry& registry = GetRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		for (const auto& ring : registry.rings) {
+			CollectRing(*ring, events);
+		}
+	}
+
+	const double ticksPerMicrosecond = RawTicksPerMicrosecond();
+	const DWORD processId = GetCurrentProcessId();
+	std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	char line[256] = { 0 };
+	bool first = true;
+	for (const Event& event : events) {
+		if (!event.name) continue;
+		const double ts = static_cast<double>(event.start - g_origin.raw) / ticksPerMicrosecond;
+		if (event.duration == INSTANT) {
+			snprintf(line, sizeof(line), "%s{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":%lu,\"tid\":%lu}",
+				first ? "" : ",\n", event.name, ts, static_cast<unsigned long>(processId), static_cast<unsigned long>(event.threadId));
+		}
+		else {
+			const double dur = static_cast<double>(event.duration) / ticksPerMicrosecond;
+			snprintf(line, sizeof(line), "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%lu,\"tid\":%lu}",
+				first ? "" : ",\n", event.name, ts, dur, static_cast<unsigned long>(processId), static_cast<unsigned long>(event.threadId));
+		}
+		json += line;
+		first = false;
+	}
+	json += "]}\n";
+
+	HANDLE rawFile = CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (rawFile == INVALID_HANDLE_VALUE) return L"";
+	HandleWrapper file(rawFile, true);
+	DWORD written = 0;
+	if (!WriteFile(file.get(), json.data(), static_cast<DWORD>(json.size()), &written, nullptr) || written != json.size()) {
+		return L"";
+	}
+	return path;
+}
+#endif
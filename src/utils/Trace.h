@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#else
+#include <windows.h>
+#endif
+
+// Build with BONGOCAT_TRACING=0 to compile every trace point out
+#ifndef BONGOCAT_TRACING
+#define BONGOCAT_TRACING 1
+#endif
+
+// Always-on flight recorder: spans and instants go into a fixed per-thread ring (oldest
+// entries are overwritten) and are exported on demand in Chrome trace JSON, which
+// chrome://tracing and ui.perfetto.dev both open.
+namespace Trace {
+#if BONGOCAT_TRACING
+	// Raw timestamp: the TSC where available
+	inline uint64_t Now() noexcept {
+#if defined(_M_X64) || defined(_M_IX86)
+		return __rdtsc();
+#else
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+		return static_cast<uint64_t>(now.QuadPart);
+#endif
+	}
+
+	// `name` must be a string literal (stored by pointer)
+	void Span(const char* name, uint64_t start, uint64_t end) noexcept;
+	void Instant(const char* name) noexcept;
+
+	class Scope {
+	private:
+		const char* m_name;
+		uint64_t m_start;
+
+	public:
+		explicit Scope(const char* name) noexcept : m_name(name), m_start(Now()) {}
+		~Scope() { Span(m_name, m_start, Now()); }
+
+		// Non-copyable
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+	};
+
+	// Writes every thread's ring into Documents; returns the path or empty on failure
+	std::wstring ExportChromeJson();
+#endif
+}
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#if BONGOCAT_TRACING
+#define TRACE_SCOPE(name) ::Trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define TRACE_INSTANT(name) ::Trace::Instant(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_INSTANT(name) ((void)0)
+#endif
@@ -12,8 +12,11 @@ bool ValidationUtils::CanUnlockSkin(int skin, int clickCount) {
 }
 
 int ValidationUtils::GetUnlockThreshold(int skin) {
+	if (const SkinPack* pack = SkinPacks::Find(skin)) {
+		return pack->unlockThreshold;
+	}
 	return (skin >= 0 && skin < Configuration::SKIN_COUNT) 
-		? Configuration::UNLOCK_THRESHOLDS[skin] 
+		? SkinRegistry::SKINS[skin].unlockThreshold 
 		: 0;
 }
 
@@ -28,3 +31,12 @@ bool ValidationUtils::IsValidDWordRange(uint32_t value, uint32_t min, uint32_t m
 bool ValidationUtils::IsValidImageIndex(int index, int maxImages) {
 	return index >= 0 && index < maxImages;
 }
+
+bool ValidationUtils::IsValidScale(int percent) {
+	return percent == Configuration::SCALE_AUTO
+		|| (percent >= Configuration::SCALE_MIN_PERCENT && percent <= Configuration::SCALE_MAX_PERCENT);
+}
+
+bool ValidationUtils::IsValidCounterMode(int mode) {
+	return mode >= Configuration::COUNTER_OFF && mode < Configuration::COUNTER_MODE_COUNT;
+}
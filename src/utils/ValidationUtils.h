@@ -17,11 +17,19 @@ public:
 
 	// Resource validation
 	static bool IsValidImageIndex(int index, int maxImages);
+
+	// Window scale (percent, or SCALE_AUTO)
+	static bool IsValidScale(int percent);
+
+	// Click counter overlay (COUNTER_*)
+	static bool IsValidCounterMode(int mode);
 };
 
 // Inline implementations
 #include "Configuration.h"
+#include "SkinPacks.h"
 
+// Pack skins follow the built-ins; only meaningful on the UI thread
 inline bool ValidationUtils::IsValidSkin(int skin) {
-	return skin >= 0 && skin < Configuration::SKIN_COUNT;
+	return skin >= 0 && skin < Configuration::SKIN_COUNT + SkinPacks::Count();
 }